@@ -0,0 +1,64 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "eytree.h"
+
+#define BENCHMARK_SIZE (1 << 22)
+#define BENCHMARK_SEARCHES (1 << 21)
+
+/**
+ * @brief Private method to compare two keys for bsearch
+ */
+static int benchmark_compareKey(const void *key1, const void *key2) {
+    int64_t value1 = *(const int64_t *) key1;
+    int64_t value2 = *(const int64_t *) key2;
+    return (value1 > value2) - (value1 < value2);
+}
+
+/**
+ * @brief Private method to evaluate the milliseconds elapsed between two clock samples
+ */
+static long benchmark_elapsed(clock_t start, clock_t end) {
+    return (long) ((end - start) * 1000 / CLOCKS_PER_SEC);
+}
+
+int main(void) {
+    int64_t *keys = (int64_t *) malloc(BENCHMARK_SIZE * sizeof(int64_t));
+    int64_t *queries = (int64_t *) malloc(BENCHMARK_SEARCHES * sizeof(int64_t));
+    EytzingerTree tree;
+    unsigned int seed = 7;
+    long found_tree = 0;
+    long found_bsearch = 0;
+    clock_t start, middle, end;
+    int i;
+
+    if (keys == NULL || queries == NULL) return EXIT_FAILURE;
+
+    // Even keys, half of the queries miss
+    for (i = 0; i < BENCHMARK_SIZE; i++) keys[i] = 2 * (int64_t) i;
+    for (i = 0; i < BENCHMARK_SEARCHES; i++) {
+        seed = seed * 1103515245u + 12345u;
+        queries[i] = (int64_t) ((seed >> 4) % (2 * BENCHMARK_SIZE));
+    }
+    if (!eytree_create(&tree, keys, NULL, BENCHMARK_SIZE, NULL)) return EXIT_FAILURE;
+
+    start = clock();
+    for (i = 0; i < BENCHMARK_SEARCHES; i++) found_tree += eytree_find(&tree, queries[i], NULL);
+    middle = clock();
+    for (i = 0; i < BENCHMARK_SEARCHES; i++) {
+        found_bsearch += bsearch(&queries[i], keys, BENCHMARK_SIZE, sizeof(int64_t), benchmark_compareKey) != NULL;
+    }
+    end = clock();
+
+    printf("[ EYTZINGER ] %ld ms, bsearch %ld ms for %d searches\n", benchmark_elapsed(start, middle),
+           benchmark_elapsed(middle, end), BENCHMARK_SEARCHES);
+    eytree_destroy(&tree);
+    free(queries);
+    free(keys);
+    return found_tree == found_bsearch ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -7,6 +7,7 @@
 #include "list.h"
 #include "dlist.h"
 #include "clist.h"
+#include "set.h"
 
 #ifndef COLLECTIONS_COMMONS_ARRAY_H
 #define COLLECTIONS_COMMONS_ARRAY_H
@@ -15,62 +16,164 @@
 extern "C" {
 #endif
 
+#ifdef __cplusplus
+#include <cstddef>
+#include <cstdlib>
+#include <cstdbool>
+#else
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#endif
+
 /**
- * @brief Splits an array from start_index to stop_index and stores the result in out, updating out_size.
- *
- * @param out Array of arrays resulting from the split operation.
- * @param out_size Pointer to the size of the output array.
- * @param in Input array to be split.
- * @param start_index Index to start the split from (inclusive).
- * @param stop_index Index to end the split at (exclusive).
+ * @brief Data structure definition for a view over elements of an array, the elements are never copied
+ * @details The stride can differ from the element size, a view over a field of an array of structures uses the
+ * structure size as stride, a negative stride walks the array backward
  */
-void array_split(void ***out, int *out_size, void *in, int start_index, int stop_index);
+typedef struct ArrayView {
+    /**
+     * @brief Address of the first element of the view
+     */
+    void *base;
+    /**
+     * @brief Number of elements of the view
+     */
+    int count;
+    /**
+     * @brief Number of bytes between two consecutive elements of the view
+     */
+    ptrdiff_t stride;
+} ArrayView;
 
+/**
+ * @brief Creates a view over elements of an array
+ * @param view View to be created
+ * @param base Address of the first element
+ * @param count Number of elements
+ * @param stride Number of bytes between two consecutive elements, the element size for a whole array
+ * @complexity O(1)
+ */
+void arrayview_create(ArrayView *view, void *base, int count, ptrdiff_t stride);
 
 /**
- * @brief Convert the given array into a list
- * @param array Array to be converted to list
- * @return Converted array to list
+ * @brief Creates a view over a range of the elements of another view, sharing its elements
+ * @param view View to slice
+ * @param start Index of the first element of the slice (inclusive)
+ * @param stop Index after the last element of the slice (exclusive)
+ * @param slice Output view over the elements from start to stop
+ * @return true if the slice was created, false if the range is outside of the view
+ * @complexity O(1)
  */
-LinkedList *array_toList(void **array);
+bool arrayview_slice(const ArrayView *view, int start, int stop, ArrayView *slice);
 
 /**
- * @brief Convert the given array into a double linked list
- * @param array Array to be converted to list
- * @return Converted array to list
+ * @brief Creates a view over every step-th element of another view, sharing its elements
+ * @param view View to walk
+ * @param step Number of elements between two elements of the result, negative to walk the view backward from its
+ * last element
+ * @param result Output view over the selected elements
+ * @return true if the view was created, false if the step is 0
+ * @complexity O(1)
  */
-DLinkedList *array_toDList(void **array);
+bool arrayview_step(const ArrayView *view, int step, ArrayView *result);
 
 /**
- * @brief Convert the given array into a circular list
- * @param array Array to be converted to list
- * @return Converted array to list
+ * @brief Split a view into consecutive views of the same length up to one element, sharing its elements
+ * @param view View to split
+ * @param parts Maximal number of views, each one gets at least an element
+ * @param out Output views, a caller buffer of at least parts views
+ * @return The number of views written, the minimum of parts and the view count
+ * @complexity O(p) where p is the number of parts
  */
-CLinkedList *array_toCList(void **array);
+int arrayview_split(const ArrayView *view, int parts, ArrayView *out);
 
 /**
- * @brief Convert the given array into a set
- * @param array Array to be converted to set
- * @return Converted array to set
+ * @brief Append the addresses of a range of elements of an array to an array of pointers, the elements aren't copied
+ * @param out Array of pointers to grow by a single reallocation, it can point to NULL
+ * @param out_size Number of pointers inside the output array, updated with the appended ones
+ * @param in Input array to be split
+ * @param size Size of an element of the input array in bytes
+ * @param start_index Index to start the split from (inclusive)
+ * @param stop_index Index to end the split at (exclusive)
+ * @return true if the addresses were appended, false if the range is invalid or the allocation failed
+ * @complexity O(n) where n is the number of appended addresses
  */
-struct Set *array_toSet(void **array, bool(*equals)(const void *value1, const void *value2));
+bool array_split(void ***out, int *out_size, void *in, size_t size, int start_index, int stop_index);
 
-#ifdef __cpluscplus
 /**
- * @brief Inline function that evaluates the size of an array
- * @param array Array to determine the size
+ * @brief Convert the given array into a list, the values are shared with the array and not destroyed with the list
+ * @param array Array of values to be converted to list
+ * @param count Number of values of the array
+ * @return Converted array to list in the array order, NULL if an allocation failed
+ * @complexity O(n) where n is the number of values
+ */
+LinkedList *array_toList(void **array, int count);
+
+/**
+ * @brief Convert the given array into a double linked list, the values are shared with the array
+ * @param array Array of values to be converted to list
+ * @param count Number of values of the array
+ * @return Converted array to list in the array order, NULL if an allocation failed
+ * @complexity O(n) where n is the number of values
+ */
+DLinkedList *array_toDList(void **array, int count);
+
+/**
+ * @brief Convert the given array into a circular list, the values are shared with the array
+ * @param array Array of values to be converted to list
+ * @param count Number of values of the array
+ * @return Converted array to list, its head is the first value, NULL if an allocation failed
+ * @complexity O(n) where n is the number of values
+ */
+CLinkedList *array_toCList(void **array, int count);
+
+/**
+ * @brief Convert the given array into a set, the values are shared with the array and duplicates are dropped
+ * @param array Array of values to be converted to set
+ * @param count Number of values of the array
+ * @param equals User equality function of the values
+ * @return Converted array to set, NULL if an allocation failed
+ * @complexity O(n^2) where n is the number of values
  */
-static inline size_t array_length(void** array){
-    return sizeof(array) / sizeof(array[0]);
+Set *array_toSet(void **array, int count, bool(*equals)(const void *value1, const void *value2));
+
+#ifdef __cplusplus
+/**
+ * @brief Inline function that evaluates the address of an element of the given view
+ * @return The address of the element at the given index
+ */
+static inline void *arrayview_at(const ArrayView *view, int index) {
+    return (char *) view->base + index * view->stride;
+}
+
+/**
+ * @brief Inline function that evaluates the number of elements of the given view
+ * @return Current number of elements of the view
+ */
+static inline int arrayview_count(const ArrayView *view) {
+    return view->count;
 }
 #else
 /**
- * @brief Macro that evaluates the size of an array
- * @param array Array to determine the size
+ * @brief Macro that evaluates the address of an element of the given view
+ * @return The address of the element at the given index
  */
-#define array_length(array) sizeof(array) / sizeof(array[0])
+#define arrayview_at(view, index) ((void *) ((char *) (view)->base + (index) * (view)->stride))
 
+/**
+ * @brief Macro that evaluates the number of elements of the given view
+ * @return Current number of elements of the view
+ */
+#define arrayview_count(view) ((view)->count)
 #endif
+
+/**
+ * @brief Macro that evaluates the number of elements of an array declared with its size, NOT of a pointer
+ * @param array Array to determine the size
+ */
+#define array_length(array) (sizeof(array) / sizeof((array)[0]))
+
 #ifdef __cplusplus
 }
 #endif
@@ -7,4 +7,143 @@
 #ifndef COLLECTIONS_COMMONS_BISTREE_H
 #define COLLECTIONS_COMMONS_BISTREE_H
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstdbool>
+#else
+#include <stdlib.h>
+#include <stdbool.h>
+#endif
+
+#include "bitree.h"
+
+/**
+ * @brief Data structure definition for the value of a binary search tree node, balancing and order statistics data
+ */
+typedef struct AvlNode {
+    /**
+     * @brief User value of the node
+     */
+    void *value;
+    /**
+     * @brief Height of the subtree rooted at the node, 1 for a leaf
+     */
+    int height;
+    /**
+     * @brief Number of nodes of the subtree rooted at the node
+     */
+    int size;
+} AvlNode;
+
+/**
+ * @brief Binary search tree, a binary tree whose node values are AvlNode ordered by the tree compare handle
+ * @details Positional bitree_add and bitree_remove operations MUST NOT be used on binary search trees
+ */
+typedef BinaryTree BinarySearchTree;
+
+/**
+ * @brief Create an empty binary search tree
+ * @param tree Binary search tree to create
+ * @param compare User compare function of the values
+ * @param destroy Optional destroy function of the values
+ * @complexity O(1)
+ */
+void bistree_create(BinarySearchTree *tree, int (*compare)(const void *key1, const void *key2),
+                    void (*destroy)(void *value));
+
+/**
+ * @brief Destroy the given binary search tree, values are destroyed with the user handle
+ * @param tree Binary search tree to destroy
+ * @complexity O(n) where n is the number of nodes
+ */
+void bistree_destroy(BinarySearchTree *tree);
+
+/**
+ * @brief Insert a value in the given binary search tree
+ * @param tree Binary search tree to insert in
+ * @param value Value to insert
+ * @return true if the value was inserted, false if an equal value is already present or the allocation failed
+ * @complexity O(log(n)) where n is the number of nodes
+ */
+bool bistree_insert(BinarySearchTree *tree, const void *value);
+
+/**
+ * @brief Remove a value from the given binary search tree, the stored value is returned to the caller
+ * @param tree Binary search tree to remove from
+ * @param value Value to remove, then output pointer on the removed value
+ * @return true if the value was removed, false otherwise
+ * @complexity O(log(n)) where n is the number of nodes
+ */
+bool bistree_remove(BinarySearchTree *tree, void **value);
+
+/**
+ * @brief Search a value inside the given binary search tree
+ * @param tree Binary search tree to search in
+ * @param value Value to search, then output pointer on the stored value
+ * @return true if the value was found, false otherwise
+ * @complexity O(log(n)) where n is the number of nodes
+ */
+bool bistree_lookup(const BinarySearchTree *tree, void **value);
+
+/**
+ * @brief Count the values lower than the given value, the index of the value if it is in the tree
+ * @param tree Binary search tree to search in
+ * @param value Value to rank
+ * @return The number of values lower than the given value
+ * @complexity O(log(n)) where n is the number of nodes
+ */
+int bistree_rank(const BinarySearchTree *tree, const void *value);
+
+/**
+ * @brief Search the value of the given rank, the k-th lowest value
+ * @param tree Binary search tree to search in
+ * @param rank Zero based rank of the value
+ * @param value Output pointer on the value of the rank
+ * @return true if the rank is inside the tree, false otherwise
+ * @complexity O(log(n)) where n is the number of nodes
+ */
+bool bistree_select(const BinarySearchTree *tree, int rank, void **value);
+
+#ifdef __cplusplus
+/**
+ * @brief Inline function that evaluates the AVL data of a binary search tree node
+ * @param node Node of a binary search tree
+ * @return The AVL data of the node
+ */
+static inline AvlNode *bistree_avl(BinaryTreeNode *node) {
+    return (AvlNode *) node->value;
+}
+
+/**
+ * @brief Inline function that evaluates the user value of a binary search tree node
+ * @param node Node of a binary search tree
+ * @return The user value of the node
+ */
+static inline void *bistree_value(BinaryTreeNode *node) {
+    return ((AvlNode *) node->value)->value;
+}
+#else
+/**
+ * @brief Macro that evaluates the AVL data of a binary search tree node
+ * @param node Node of a binary search tree
+ * @return The AVL data of the node
+ */
+#define bistree_avl(node) ((AvlNode *) (node)->value)
+
+/**
+ * @brief Macro that evaluates the user value of a binary search tree node
+ * @param node Node of a binary search tree
+ * @return The user value of the node
+ */
+#define bistree_value(node) (((AvlNode *) (node)->value)->value)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif //COLLECTIONS_COMMONS_BISTREE_H
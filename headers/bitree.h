@@ -22,6 +22,8 @@ extern "C" {
 
 #endif
 
+#include "parallel_utils.h"
+
 /**
  * @brief Data structure definition for a binary tree node
  */
@@ -38,6 +40,11 @@ typedef struct BinaryTreeNode {
      * @brief Node's right child
      */
     struct BinaryTreeNode *right;
+    /**
+     * @brief true if the node lives in a block of the tree builders and is released with it, false if it was
+     * allocated on its own
+     */
+    bool pooled;
 } BinaryTreeNode;
 
 /**
@@ -56,6 +63,14 @@ typedef struct BinaryTree {
      */
     bool (*equals)(const void *value1, const void *value2);
 
+    /**
+     * @brief User compare handle for ordered trees, NULL for positional binary trees
+     * @param key1 Key 1 to be compared
+     * @param key2 Key 2 to be compared
+     * @return A negative value if key1 < key2, 0 if key1 == key2, a positive value otherwise
+     */
+    int (*compare)(const void *key1, const void *key2);
+
     /**
      * @brief User destroy method to clean node's value
      * @param value Value to be removed from the tree
@@ -66,6 +81,11 @@ typedef struct BinaryTree {
      * @brief Binary tree current root node
      */
     BinaryTreeNode *root;
+
+    /**
+     * @brief Chain of node blocks allocated by the tree builders, NULL if every node is allocated on its own
+     */
+    struct BinaryTreeBlock *blocks;
 } BinaryTree;
 
 /**
@@ -100,14 +120,14 @@ bool bitree_addLeft(BinaryTree *tree, BinaryTreeNode *node, const void *value);
 bool bitree_addRight(BinaryTree *tree, BinaryTreeNode *node, const void *value);
 
 /**
- * @brief Remove the left child of the given node in the given binary tree
+ * @brief Remove the left child of the given node in the given binary tree with its whole subtree, without recursion
  * @param tree Binary tree where to remove the left node's value
  * @param node Node to remove the left child
  */
 void bitree_removeLeft(BinaryTree *tree, BinaryTreeNode *node);
 
 /**
- * @brief Remove the right child of the given node in the given binary tree
+ * @brief Remove the right child of the given node in the given binary tree with its whole subtree, without recursion
  * @param tree Binary tree where to remove the right node's value
  * @param node Node to remove the right child
  */
@@ -130,9 +150,9 @@ bool bitree_merge(BinaryTree *out, BinaryTree *left, BinaryTree *right, const vo
 int bitree_maxDepth(BinaryTree *tree);
 
 /**
- * @brief Returns the current maximum depth of the given binary tree
- * @param tree Binary tree to get the maximum depth
- * @return The maximum depth of the given binary tree
+ * @brief Returns the current maximum depth of the given branch, computed without recursion
+ * @param branchRoot Root node of the branch to get the maximum depth
+ * @return The maximum depth of the given branch, -1 if the traversal stack allocation failed
  */
 int bitree_maxDepthBranch(BinaryTreeNode *branchRoot);
 
@@ -141,7 +161,7 @@ int bitree_maxDepthBranch(BinaryTreeNode *branchRoot);
  * @param equals Node compare function
  * @param left Left node to be compared
  * @param right Right node to be compared
- * @return true if two nodes are in the same tree, false otherwise
+ * @return true if two nodes are in the same tree, false otherwise or if the traversal stack allocation failed
  */
 bool
 bitree_isSameTree(bool (*equals)(const void *value1, const void *value2), BinaryTreeNode *left, BinaryTreeNode *right);
@@ -154,9 +174,9 @@ bitree_isSameTree(bool (*equals)(const void *value1, const void *value2), Binary
 bool bitree_invert(BinaryTree *out, BinaryTree *tree);
 
 /**
- * @brief Invert the current branch starting from the given node
+ * @brief Invert the current branch starting from the given node, without recursion
  * @param branchRoot Relative branchRoot where to start to invert the binary tree
- * @return The reversed branch
+ * @return The reversed branch, NULL if the traversal stack allocation failed
  */
 BinaryTreeNode *bitree_invertBranch(BinaryTreeNode *branchRoot);
 /**
@@ -164,22 +184,76 @@ BinaryTreeNode *bitree_invertBranch(BinaryTreeNode *branchRoot);
  * @param equals Nodes value compare function, usefully used to add some other nodes comparer
  * @param left Left node to be compared
  * @param right Right node to be compared
- * @return true if given nodes are symmetric, false otherwise
+ * @return true if given nodes are symmetric, false otherwise or if the traversal stack allocation failed
  */
 bool
 bitree_isMirror(bool (*equals)(const void *value1, const void *value2), BinaryTreeNode *left, BinaryTreeNode *right);
 
+/**
+ * @brief Visit the values of the given binary tree in pre-order, without recursion nor allocation
+ * @details Morris traversal, the tree links are temporarily threaded so the tree MUST NOT be read or modified
+ * during the traversal, all the links are restored when the call returns
+ * @param tree Binary tree to visit
+ * @param visit User visitor, returns false to stop the traversal
+ * @param data User data given to the visitor
+ * @return true if all the values were visited, false if the visitor stopped the traversal
+ * @complexity O(n) where n is the number of nodes
+ */
+bool bitree_preorder(BinaryTree *tree, bool (*visit)(void *value, void *data), void *data);
+
+/**
+ * @brief Visit the values of the given binary tree in in-order, without recursion nor allocation
+ * @details Morris traversal, the tree links are temporarily threaded so the tree MUST NOT be read or modified
+ * during the traversal, all the links are restored when the call returns
+ * @param tree Binary tree to visit
+ * @param visit User visitor, returns false to stop the traversal
+ * @param data User data given to the visitor
+ * @return true if all the values were visited, false if the visitor stopped the traversal
+ * @complexity O(n) where n is the number of nodes
+ */
+bool bitree_inorder(BinaryTree *tree, bool (*visit)(void *value, void *data), void *data);
+
+/**
+ * @brief Visit the values of the given binary tree in post-order, without recursion nor allocation
+ * @details Morris traversal, the tree links are temporarily threaded and reversed so the tree MUST NOT be read or
+ * modified during the traversal, all the links are restored when the call returns
+ * @param tree Binary tree to visit
+ * @param visit User visitor, returns false to stop the traversal
+ * @param data User data given to the visitor
+ * @return true if all the values were visited, false if the visitor stopped the traversal
+ * @complexity O(n) where n is the number of nodes
+ */
+bool bitree_postorder(BinaryTree *tree, bool (*visit)(void *value, void *data), void *data);
+
+/**
+ * @brief Returns the values of a binary tree in level order, levels are delimited by an offsets array
+ * @details Single pass BFS without queue, the values and the offsets are allocated in a single block released by
+ * freeing the returned array, the values of the level i are in [offsets[i], offsets[i + 1])
+ * @param tree Tree to traverse
+ * @param levels Output number of levels in the binary tree
+ * @param offsets Output pointer on the levels + 1 offsets, offsets[levels] is the number of values
+ * @return Array of values in level order, NULL if the tree is empty, its size is lower than its nodes or the
+ * allocation failed
+ * @complexity O(n) where n is the number of nodes
+ */
+void **bitree_levelOrderFlat(BinaryTree *tree, int *levels, int **offsets);
+
 /**
  * @brief Returns a binary tree by level
+ * @details The level arrays, the values and the column sizes are allocated in a single block released by freeing
+ * the returned array
  * @param tree Tree to return as an array of arrays
  * @param returnSize Number of levels in the binary tree
  * @param returnColumnSizes Number of elements per level
- * @return Array of values per level in the given binary tree
+ * @return Array of values per level in the given binary tree, NULL if the tree is empty or the allocation failed
+ * @complexity O(n) where n is the number of nodes
  */
 void **bitree_levelOrder(BinaryTree *tree, int *returnSize, int **returnColumnSizes);
 
 /**
  * @brief Construct a binary tree from preorder and inorder traversal.
+ * @details Recursive builder searching every value in the inorder array, each node is allocated on its own,
+ * bitree_build_from_preorder_inorder builds whole trees in linear time
  *
  * @param preorder An array representing the preorder traversal of the tree.
  * @param preorder_size The size of the preorder array.
@@ -188,6 +262,7 @@ void **bitree_levelOrder(BinaryTree *tree, int *returnSize, int **returnColumnSi
  * @param equals Node value equals function
  *
  * @return A pointer to the root node of the constructed binary tree.
+ * @complexity O(n²) where n is the number of nodes
  */
 BinaryTreeNode *
 bitree_build_from_preorder_inorder_branch(void **preorder, int preorder_size, void **inorder, int inorder_size,
@@ -195,6 +270,8 @@ bitree_build_from_preorder_inorder_branch(void **preorder, int preorder_size, vo
 
 /**
  * @brief Construct a binary tree from inorder and postorder traversal.
+ * @details Recursive builder searching every value in the inorder array, each node is allocated on its own,
+ * bitree_build_from_inorder_postorder builds whole trees in linear time
  *
  * @param inorder An array representing the inorder traversal of the tree.
  * @param inorderSize The size of the inorder array.
@@ -202,6 +279,7 @@ bitree_build_from_preorder_inorder_branch(void **preorder, int preorder_size, vo
  * @param postorderSize The size of the postorder array.
  * @param equals Node value equals function
  * @return A pointer to the root node of the constructed binary tree.
+ * @complexity O(n²) where n is the number of nodes
  */
 BinaryTreeNode *bitree_build_from_inorder_postorder_branch(void **inorder, int inorderSize, int **postorder,
                                                            int postorderSize,
@@ -209,6 +287,9 @@ BinaryTreeNode *bitree_build_from_inorder_postorder_branch(void **inorder, int i
 
 /**
  * @brief Construct a binary tree from preorder and inorder traversal.
+ * @details Iterative builder, a stack of the nodes waiting for their right child is matched against the inorder
+ * array so the comparisons are linear, the values MUST be distinct and all the nodes are allocated in a single
+ * block owned by the tree
  *
  * @param preorder An array representing the preorder traversal of the tree.
  * @param preorder_size The size of the preorder array.
@@ -217,7 +298,8 @@ BinaryTreeNode *bitree_build_from_inorder_postorder_branch(void **inorder, int i
  * @param destroy The destroy function of the created binary tree
  * @param equals Node value equals function
  *
- * @return A pointer to the constructed binary tree.
+ * @return A pointer to the constructed binary tree, NULL if the sizes differ or the allocation failed.
+ * @complexity O(n) where n is the number of nodes
  */
 BinaryTree *bitree_build_from_preorder_inorder(void **preorder, int preorder_size, void **inorder, int inorder_size,
                                                void(*destroy)(void *value),
@@ -225,6 +307,9 @@ BinaryTree *bitree_build_from_preorder_inorder(void **preorder, int preorder_siz
 
 /**
 * @brief Construct a binary tree from inorder and postorder traversal.
+* @details Iterative builder reading both traversals backward, a stack of the nodes waiting for their left child is
+* matched against the inorder array so the comparisons are linear, the values MUST be distinct and all the nodes
+* are allocated in a single block owned by the tree
 *
 * @param inorder An array representing the inorder traversal of the tree.
 * @param inorderSize The size of the inorder array.
@@ -232,7 +317,8 @@ BinaryTree *bitree_build_from_preorder_inorder(void **preorder, int preorder_siz
 * @param postorderSize The size of the postorder array.
 * @param destroy The destroy function of the created binary tree
 * @param equals Node value equals function
-* @return A pointer to the root node of the constructed binary tree.
+* @return A pointer to the constructed binary tree, NULL if the sizes differ or the allocation failed.
+* @complexity O(n) where n is the number of nodes
 */
 BinaryTree *bitree_build_from_inorder_postorder(void **inorder,
                                                 int inorderSize,
@@ -242,10 +328,10 @@ BinaryTree *bitree_build_from_inorder_postorder(void **inorder,
                                                 bool (*equals)(const void *value1, const void *value2));
 
 /**
- * @brief Returns the longest path length in the given branch
+ * @brief Returns the height of the given branch and its longest path length, computed without recursion
  * @param root Root node of the given branch to find longest path
  * @param diameter Pointer to the returned longest path length
- * @return
+ * @return The height of the given branch, -1 if the traversal stack allocation failed
  */
 int bitree_height(BinaryTreeNode *root, int *diameter);
 
@@ -266,10 +352,62 @@ int bitree_nodeCount(BinaryTree *tree);
 /**
  * @brief Count the number of nodes in the given branch
  * @param node Binary tree to count nodes
- * @return Node count of the given branch
+ * @return Node count of the given branch, -1 if the traversal stack allocation failed
  */
 int bitree_branchNodeCount(BinaryTreeNode *node);
 
+/**
+ * @brief Count the number of nodes in the given binary tree, the top levels are forked on the given pool
+ * @details Subtrees below the fork levels are counted sequentially, the result doesn't depend on the scheduling
+ * @param pool Thread pool running the count
+ * @param tree Binary tree to count nodes
+ * @return Node count of the given binary tree, -1 if a traversal stack allocation failed
+ * @complexity O(n / t + h) where n is the number of nodes, t the number of threads and h the height
+ */
+int bitree_parallelNodeCount(ParallelPool *pool, BinaryTree *tree);
+
+/**
+ * @brief Returns the maximum depth of the given binary tree, the top levels are forked on the given pool
+ * @param pool Thread pool running the walk
+ * @param tree Binary tree to get the maximum depth
+ * @return The maximum depth of the given binary tree, -1 if a traversal stack allocation failed
+ * @complexity O(n / t + h) where n is the number of nodes, t the number of threads and h the height
+ */
+int bitree_parallelMaxDepth(ParallelPool *pool, BinaryTree *tree);
+
+/**
+ * @brief Returns the longest path length in the given binary tree, the top levels are forked on the given pool
+ * @param pool Thread pool running the walk
+ * @param tree Tree to get the longest path on
+ * @return The longest path length of the given binary tree, -1 if a traversal stack allocation failed
+ * @complexity O(n / t + h) where n is the number of nodes, t the number of threads and h the height
+ */
+int bitree_parallelDiameter(ParallelPool *pool, BinaryTree *tree);
+
+/**
+ * @brief Determines if two branches are equal, the top levels are compared in parallel on the given pool
+ * @param pool Thread pool running the comparison
+ * @param equals Node compare function, called concurrently
+ * @param left Left node to be compared
+ * @param right Right node to be compared
+ * @return true if the branches are equal, false otherwise or if a traversal stack allocation failed
+ * @complexity O(n / t + h) where n is the number of nodes, t the number of threads and h the height
+ */
+bool bitree_parallelIsSameTree(ParallelPool *pool, bool (*equals)(const void *value1, const void *value2),
+                               BinaryTreeNode *left, BinaryTreeNode *right);
+
+/**
+ * @brief Determine if two branches are symmetric, the top levels are compared in parallel on the given pool
+ * @param pool Thread pool running the comparison
+ * @param equals Nodes value compare function, called concurrently
+ * @param left Left node to be compared
+ * @param right Right node to be compared
+ * @return true if given branches are symmetric, false otherwise or if a traversal stack allocation failed
+ * @complexity O(n / t + h) where n is the number of nodes, t the number of threads and h the height
+ */
+bool bitree_parallelIsMirror(ParallelPool *pool, bool (*equals)(const void *value1, const void *value2),
+                             BinaryTreeNode *left, BinaryTreeNode *right);
+
 #ifdef __cplusplus
 /**
  * @brief Inline function that evaluates the size of the given binary tree
@@ -337,13 +475,13 @@ static inline BinaryTreeNode  *bitree_left(BinaryTreeNode *node){
 /**
  * @brief Inline function that evaluates if the given tree is symmetric or not
  */
-static inline bool bitree_isSymmetric(BinaryTree * tree) { return bitree_isMirror((tree)->root, (tree)->root); }
+static inline bool bitree_isSymmetric(BinaryTree * tree) { return bitree_isMirror((tree)->equals, (tree)->root, (tree)->root); }
 #else
 
 /**
  * @brief Macro that evaluates if the given tree is symmetric or not
  */
-#define bitree_isSymmetric(tree) (bitree_isMirror((tree)->root, (tree)->root))
+#define bitree_isSymmetric(tree) (bitree_isMirror((tree)->equals, (tree)->root, (tree)->root))
 
 /**
  * @brief Macro that evaluates the size of the given binary tree
@@ -371,7 +509,7 @@ static inline bool bitree_isSymmetric(BinaryTree * tree) { return bitree_isMirro
  * @param node Node to determine if it's a leaf
  * @return true if is the given node is a leaf, false otherwise
  */
-#define bitree_isNodeLeaf(node) ((node)->left == NULL (node)->right == NULL)
+#define bitree_isNodeLeaf(node) ((node)->left == NULL && (node)->right == NULL)
 
 /**
  * @brief Macro that evaluates the value of a given node
@@ -392,7 +530,7 @@ static inline bool bitree_isSymmetric(BinaryTree * tree) { return bitree_isMirro
  * @param node Node to return the right child
  * @return The right child of the given node
  */
-#define bitree_right(node) ((node)->left)
+#define bitree_right(node) ((node)->right)
 
 #endif
 
@@ -0,0 +1,202 @@
+/**
+ * @file bitset.h
+ * @brief This file contains the API for dense bit sets of small integers
+ * @author Maxime Loukhal
+ * @date 18/10/2026
+ */
+#ifndef COLLECTIONS_COMMONS_BITSET_H
+#define COLLECTIONS_COMMONS_BITSET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstdint>
+#include <cstdbool>
+#include <climits>
+#else
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <limits.h>
+#endif
+
+#include "set.h"
+#include "hashset.h"
+
+/**
+ * @brief Largest capacity of a bit set, it holds the integers from 0 to BITSET_MAX_CAPACITY - 1
+ */
+#define BITSET_MAX_CAPACITY INT_MAX
+
+/**
+ * @brief Data structure definition for a dense set of non-negative integers, one bit per integer
+ */
+typedef struct BitSet {
+    /**
+     * @brief Number of integers the bit set can hold without growing, always a multiple of 256 or BITSET_MAX_CAPACITY
+     */
+    int capacity;
+    /**
+     * @brief Number of 64 bits words inside the bit set
+     */
+    int words;
+    /**
+     * @brief Bit set words, bit i of word w stands for the integer 64 * w + i
+     */
+    uint64_t *bits;
+} BitSet;
+
+/**
+ * @brief Create an empty bit set
+ * @param set Bit set to create
+ * @param capacity Number of integers to reserve, from 0 to capacity excluded, clamped to BITSET_MAX_CAPACITY
+ * @return true if the bit set was created, false otherwise
+ * @complexity O(n) where n is the capacity of the bit set
+ */
+bool bitset_create(BitSet *set, int capacity);
+
+/**
+ * @brief Destroy the given bit set
+ * @param set Bit set to destroy
+ * @complexity O(1)
+ */
+void bitset_destroy(BitSet *set);
+
+/**
+ * @brief Add an integer to the bit set, the bit set grows if the integer is out of its capacity
+ * @param set Bit set to add the integer in
+ * @param index Non-negative integer to add, lower than BITSET_MAX_CAPACITY
+ * @return true if the integer is in the bit set after the call, false if it's out of range or the allocation failed
+ * @complexity O(1), amortized when the bit set grows
+ */
+bool bitset_set(BitSet *set, int index);
+
+/**
+ * @brief Remove an integer from the bit set
+ * @param set Bit set to remove the integer from
+ * @param index Integer to remove
+ * @return true if the integer was in the bit set, false otherwise
+ * @complexity O(1)
+ */
+bool bitset_clear(BitSet *set, int index);
+
+/**
+ * @brief Test if an integer is in the bit set
+ * @param set Bit set to search in
+ * @param index Integer to search
+ * @return true if the integer is in the bit set, false otherwise
+ * @complexity O(1)
+ */
+bool bitset_test(const BitSet *set, int index);
+
+/**
+ * @brief Count the integers inside the bit set
+ * @param set Bit set to count the integers of
+ * @return The number of integers inside the bit set
+ * @complexity O(n / 64) where n is the capacity of the bit set
+ */
+int bitset_count(const BitSet *set);
+
+/**
+ * @brief Find the smallest integer of the bit set greater or equal to the given one
+ * @param set Bit set to search in
+ * @param from Integer to start the search from
+ * @return The next integer of the bit set, -1 if there is none
+ * @complexity O(n / 64) where n is the capacity of the bit set
+ */
+int bitset_nextSet(const BitSet *set, int from);
+
+/**
+ * @brief Build a bit set resulting of the union of left and right
+ * @param union_result Bit set created by the call
+ * @param left Left bit set operand
+ * @param right Right bit set operand
+ * @return true if the union succeed, false otherwise
+ * @complexity O(n / 64) where n is the largest capacity of the operands
+ */
+bool bitset_union(BitSet *union_result, const BitSet *left, const BitSet *right);
+
+/**
+ * @brief Build a bit set resulting of the intersection of left and right
+ * @param intersection_result Bit set created by the call
+ * @param left Left bit set operand
+ * @param right Right bit set operand
+ * @return true if the intersection succeed, false otherwise
+ * @complexity O(n / 64) where n is the smallest capacity of the operands
+ */
+bool bitset_intersection(BitSet *intersection_result, const BitSet *left, const BitSet *right);
+
+/**
+ * @brief Build a bit set resulting of the difference of left and right
+ * @param difference_result Bit set created by the call
+ * @param left Left bit set operand
+ * @param right Right bit set operand
+ * @return true if the difference succeed, false otherwise
+ * @complexity O(n / 64) where n is the capacity of left
+ */
+bool bitset_difference(BitSet *difference_result, const BitSet *left, const BitSet *right);
+
+/**
+ * @brief Test if the left operand is a subset of the right operand
+ * @param left Bit set to determine if it's a subset of right operand
+ * @param right Bit set to be compared with left operand
+ * @return true if left is a subset of right, false otherwise
+ * @complexity O(n / 64) where n is the capacity of left
+ */
+bool bitset_isSubset(const BitSet *left, const BitSet *right);
+
+/**
+ * @brief Test if left and right bit set operands are equal
+ * @param left Left bit set operand
+ * @param right Right bit set operand
+ * @return true if left and right hold the same integers, false otherwise
+ * @complexity O(n / 64) where n is the largest capacity of the operands
+ */
+bool bitset_equals(const BitSet *left, const BitSet *right);
+
+/**
+ * @brief Create a bit set from a Set of int values
+ * @param bitset Bit set created by the call
+ * @param set Set of pointers to non-negative int
+ * @return true if the bit set was created, false if a value is negative or the allocation failed
+ * @complexity O(n + m / 64) where n is the size of the set and m its greatest value
+ */
+bool bitset_fromSet(BitSet *bitset, const Set *set);
+
+/**
+ * @brief Create a bit set from a HashSet of int values
+ * @param bitset Bit set created by the call
+ * @param set HashSet of pointers to non-negative int
+ * @return true if the bit set was created, false if a value is negative or the allocation failed
+ * @complexity O(n + m / 64) where n is the size of the hashset and m its greatest value
+ */
+bool bitset_fromHashSet(BitSet *bitset, const HashSet *set);
+
+#ifdef __cplusplus
+/**
+ * @brief Inline function that evaluates the capacity of the given bit set
+ * @param set Bit set to get the capacity
+ * @return The number of integers the bit set can hold without growing
+ * @complexity O(1)
+ */
+static inline int bitset_capacity(const BitSet *set) {
+    return set->capacity;
+}
+#else
+/**
+ * @brief Macro that evaluates the capacity of the given bit set
+ * @param set Bit set to get the capacity
+ * @return The number of integers the bit set can hold without growing
+ * @complexity O(1)
+ */
+#define bitset_capacity(set) ((set)->capacity)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //COLLECTIONS_COMMONS_BITSET_H
@@ -7,4 +7,275 @@
 #ifndef COLLECTIONS_COMMONS_BTREE_H
 #define COLLECTIONS_COMMONS_BTREE_H
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstdint>
+#include <cstdbool>
+#else
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#endif
+
+#ifndef BTREE_NODE_KEYS
+/**
+ * @brief Maximum number of keys of a B+-tree node, 32 keys fill four 64 bytes cache lines and eight AVX2 compares
+ */
+#define BTREE_NODE_KEYS 32
+#endif
+
+/**
+ * @brief Data structure definition for the common part of B+-tree inner nodes and leaves
+ */
+typedef struct BTreeNode {
+    /**
+     * @brief Number of keys of the node
+     */
+    int count;
+    /**
+     * @brief true if the node is a leaf, false if it is an inner node
+     */
+    bool leaf;
+    /**
+     * @brief Sorted keys of the node, inner node keys are the lowest keys of their right subtrees
+     */
+    int64_t keys[BTREE_NODE_KEYS];
+} BTreeNode;
+
+/**
+ * @brief Data structure definition for a B+-tree inner node
+ */
+typedef struct BTreeInner {
+    /**
+     * @brief Keys of the node
+     */
+    BTreeNode node;
+    /**
+     * @brief Children of the node, count + 1 children are used
+     */
+    BTreeNode *children[BTREE_NODE_KEYS + 1];
+} BTreeInner;
+
+/**
+ * @brief Data structure definition for a B+-tree leaf, leaves are linked in key order
+ */
+typedef struct BTreeLeaf {
+    /**
+     * @brief Keys of the leaf
+     */
+    BTreeNode node;
+    /**
+     * @brief Values associated to the keys
+     */
+    void *values[BTREE_NODE_KEYS];
+    /**
+     * @brief Previous leaf, holding the lower keys
+     */
+    struct BTreeLeaf *previous;
+    /**
+     * @brief Next leaf, holding the greater keys
+     */
+    struct BTreeLeaf *next;
+} BTreeLeaf;
+
+/**
+ * @brief Data structure definition for an in-memory B+-tree ordered index of 64 bits integer keys
+ */
+typedef struct BTree {
+    /**
+     * @brief Number of keys inside the tree
+     */
+    int size;
+    /**
+     * @brief Number of levels of the tree, 0 if the tree is empty
+     */
+    int height;
+    /**
+     * @brief Optional destroy handle of the values
+     * @param value Value to destroy
+     */
+    void (*destroy)(void *value);
+    /**
+     * @brief Root node of the tree
+     */
+    BTreeNode *root;
+    /**
+     * @brief Leaf holding the lowest keys
+     */
+    BTreeLeaf *first;
+    /**
+     * @brief Leaf holding the greatest keys
+     */
+    BTreeLeaf *last;
+} BTree;
+
+/**
+ * @brief Data structure definition for a position inside the leaves of a B+-tree
+ */
+typedef struct BTreeIterator {
+    /**
+     * @brief Current leaf
+     */
+    const BTreeLeaf *leaf;
+    /**
+     * @brief Index of the current key inside the leaf
+     */
+    int index;
+} BTreeIterator;
+
+/**
+ * @brief Create an empty B+-tree
+ * @param tree B+-tree to create
+ * @param destroy Optional destroy function of the values
+ * @complexity O(1)
+ */
+void btree_create(BTree *tree, void (*destroy)(void *value));
+
+/**
+ * @brief Destroy the given B+-tree, values are destroyed with the user handle
+ * @param tree B+-tree to destroy
+ * @complexity O(n) where n is the number of keys
+ */
+void btree_destroy(BTree *tree);
+
+/**
+ * @brief Insert a key with its associated value in the given B+-tree
+ * @param tree B+-tree to insert in
+ * @param key Key to insert
+ * @param value Value associated to the key
+ * @return true if the key was inserted, false if the key is already present or the allocation failed
+ * @complexity O(log(n)) where n is the number of keys
+ */
+bool btree_insert(BTree *tree, int64_t key, const void *value);
+
+/**
+ * @brief Remove a key from the given B+-tree, the value is returned to the caller
+ * @param tree B+-tree to remove from
+ * @param key Key to remove
+ * @param value Optional output pointer on the removed value
+ * @return true if the key was removed, false otherwise
+ * @complexity O(log(n)) where n is the number of keys
+ */
+bool btree_remove(BTree *tree, int64_t key, void **value);
+
+/**
+ * @brief Search the value of a key
+ * @param tree B+-tree to search in
+ * @param key Key to search
+ * @param value Optional output pointer on the value of the key
+ * @return true if the key was found, false otherwise
+ * @complexity O(log(n)) where n is the number of keys
+ */
+bool btree_find(const BTree *tree, int64_t key, void **value);
+
+/**
+ * @brief Build the given empty B+-tree from sorted keys, leaves are filled bottom-up without any split
+ * @param tree Empty B+-tree to fill
+ * @param keys Strictly ascending keys
+ * @param values Values associated to the keys, NULL to associate NULL values
+ * @param count Number of keys
+ * @return true if the tree was built, false if the tree isn't empty, the keys aren't strictly ascending or the
+ * allocation failed
+ * @complexity O(n) where n is the number of keys
+ */
+bool btree_bulkLoad(BTree *tree, const int64_t *keys, void *const *values, int count);
+
+/**
+ * @brief Position an iterator on the lowest key of the given B+-tree
+ * @param tree B+-tree to iterate
+ * @param iterator Iterator to position
+ * @return true if the iterator is on a key, false if the tree is empty
+ * @complexity O(1)
+ */
+bool btree_first(const BTree *tree, BTreeIterator *iterator);
+
+/**
+ * @brief Position an iterator on the first key not lower than the given key
+ * @param tree B+-tree to iterate
+ * @param key Key to search
+ * @param iterator Iterator to position
+ * @return true if the iterator is on a key, false if there is no such key
+ * @complexity O(log(n)) where n is the number of keys
+ */
+bool btree_seek(const BTree *tree, int64_t key, BTreeIterator *iterator);
+
+/**
+ * @brief Move an iterator on the next key, following the leaves links
+ * @param iterator Iterator to move
+ * @return true if the iterator is on a key, false if the iteration is over
+ * @complexity O(1)
+ */
+bool btree_next(BTreeIterator *iterator);
+
+/**
+ * @brief Visit in ascending order the keys of the [low, high] range
+ * @param tree B+-tree to visit
+ * @param low Lowest key of the range
+ * @param high Greatest key of the range
+ * @param visit User visitor, returns false to stop the iteration
+ * @param data User data given to the visitor
+ * @return true if all the keys of the range were visited, false if the visitor stopped the iteration
+ * @complexity O(log(n) + k) where n is the number of keys and k the number of visited keys
+ */
+bool btree_range(const BTree *tree, int64_t low, int64_t high, bool (*visit)(int64_t key, void *value, void *data),
+                 void *data);
+
+#ifdef __cplusplus
+/**
+ * @brief Inline function that evaluates the number of keys inside the given B+-tree
+ * @return The number of keys of the tree
+ * @complexity O(1)
+ */
+static inline int btree_size(const BTree *tree) {
+    return tree->size;
+}
+
+/**
+ * @brief Inline function that evaluates the key of the current iterator position
+ * @return The key of the iterator position
+ * @complexity O(1)
+ */
+static inline int64_t btree_key(const BTreeIterator *iterator) {
+    return iterator->leaf->node.keys[iterator->index];
+}
+
+/**
+ * @brief Inline function that evaluates the value of the current iterator position
+ * @return The value of the iterator position
+ * @complexity O(1)
+ */
+static inline void *btree_value(const BTreeIterator *iterator) {
+    return iterator->leaf->values[iterator->index];
+}
+#else
+/**
+ * @brief Macro that evaluates the number of keys inside the given B+-tree
+ * @return The number of keys of the tree
+ * @complexity O(1)
+ */
+#define btree_size(tree) ((tree)->size)
+
+/**
+ * @brief Macro that evaluates the key of the current iterator position
+ * @return The key of the iterator position
+ * @complexity O(1)
+ */
+#define btree_key(iterator) ((iterator)->leaf->node.keys[(iterator)->index])
+
+/**
+ * @brief Macro that evaluates the value of the current iterator position
+ * @return The value of the iterator position
+ * @complexity O(1)
+ */
+#define btree_value(iterator) ((iterator)->leaf->values[(iterator)->index])
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif //COLLECTIONS_COMMONS_BTREE_H
@@ -142,6 +142,16 @@ DLinkedElement *dlist_getRandom(DLinkedList *list);
  */
 bool dlist_replace(DLinkedList *list, DLinkedElement *element, void **value);
 
+/**
+ * @brief Sort the list by relinking its elements with a bottom-up merge sort, no element is allocated or freed
+ * @details The sort is stable, equal values keep their order. The elements stay the same so references to them
+ * remain valid, the head, the tail and the previous links are updated
+ * @param list Reference of the list to sort
+ * @param compare User compare function of the values, negative if key1 goes before key2, 0 if equal, positive otherwise
+ * @complexity O(n log n) time and O(1) extra space where n is the number of elements in the current list
+ */
+void dlist_sort(DLinkedList *list, int (*compare)(const void *key1, const void *key2));
+
 /* ----- MACRO C++ COMPATIBILITY -----*/
 #ifdef __cplusplus
 
@@ -0,0 +1,156 @@
+/**
+ * @file eytree.h
+ * @brief This file contains the API for static search trees using the Eytzinger layout
+ * @author Maxime Loukhal
+ * @date 18/10/2026
+ */
+#ifndef COLLECTIONS_COMMONS_EYTREE_H
+#define COLLECTIONS_COMMONS_EYTREE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstdint>
+#include <cstdbool>
+#else
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#endif
+
+/**
+ * @brief Data structure definition for a read-only search tree of 64 bits integer keys stored in Eytzinger order
+ * @details The implicit tree is stored in breadth-first order, the children of the node k are the nodes 2k and
+ * 2k + 1, so a search reads a single array whose top levels stay in cache and needs no pointer chasing
+ */
+typedef struct EytzingerTree {
+    /**
+     * @brief Number of keys inside the tree
+     */
+    int size;
+    /**
+     * @brief Optional destroy handle of the values
+     * @param value Value to destroy
+     */
+    void (*destroy)(void *value);
+    /**
+     * @brief Keys in Eytzinger order starting at index 1, the index 0 is unused
+     */
+    int64_t *keys;
+    /**
+     * @brief Values associated to the keys, in the same order, allocated in the block of the keys
+     */
+    void **values;
+} EytzingerTree;
+
+/**
+ * @brief Build an Eytzinger tree from sorted keys
+ * @param tree Eytzinger tree to build
+ * @param keys Keys sorted in ascending order, duplicates are allowed
+ * @param values Values associated to the keys, NULL to associate NULL values
+ * @param size Number of keys
+ * @param destroy Optional destroy function of the values
+ * @return true if the tree was built, false if the keys aren't sorted or the allocation failed
+ * @complexity O(n) where n is the number of keys
+ */
+bool eytree_create(EytzingerTree *tree, const int64_t *keys, void *const *values, int size,
+                   void (*destroy)(void *value));
+
+/**
+ * @brief Build an Eytzinger tree from an array of values sorted by key, like the output of list_toArray
+ * @param tree Eytzinger tree to build
+ * @param values Values sorted in ascending key order
+ * @param size Number of values
+ * @param key User function extracting the key of a value
+ * @param destroy Optional destroy function of the values
+ * @return true if the tree was built, false if the values aren't sorted or the allocation failed
+ * @complexity O(n) where n is the number of values
+ */
+bool eytree_createFromArray(EytzingerTree *tree, void *const *values, int size, int64_t (*key)(const void *value),
+                            void (*destroy)(void *value));
+
+/**
+ * @brief Destroy the given Eytzinger tree, values are destroyed with the user handle
+ * @param tree Eytzinger tree to destroy
+ * @complexity O(n) where n is the number of keys
+ */
+void eytree_destroy(EytzingerTree *tree);
+
+/**
+ * @brief Search the first key not lower than the given key
+ * @details Branch-free descent, the eight descendants three levels below are prefetched at each step
+ * @param tree Eytzinger tree to search in
+ * @param key Key to search
+ * @return The Eytzinger index of the found key, 0 if every key is lower than the given key
+ * @complexity O(log(n)) where n is the number of keys
+ */
+int eytree_lowerBound(const EytzingerTree *tree, int64_t key);
+
+/**
+ * @brief Search the value of a key
+ * @param tree Eytzinger tree to search in
+ * @param key Key to search
+ * @param value Optional output pointer on the value of the key
+ * @return true if the key was found, false otherwise
+ * @complexity O(log(n)) where n is the number of keys
+ */
+bool eytree_find(const EytzingerTree *tree, int64_t key, void **value);
+
+#ifdef __cplusplus
+/**
+ * @brief Inline function that evaluates the number of keys inside the given Eytzinger tree
+ * @return The number of keys of the tree
+ * @complexity O(1)
+ */
+static inline int eytree_size(const EytzingerTree *tree) {
+    return tree->size;
+}
+
+/**
+ * @brief Inline function that evaluates the key at an Eytzinger index returned by a search
+ * @return The key at the index
+ * @complexity O(1)
+ */
+static inline int64_t eytree_key(const EytzingerTree *tree, int index) {
+    return tree->keys[index];
+}
+
+/**
+ * @brief Inline function that evaluates the value at an Eytzinger index returned by a search
+ * @return The value at the index
+ * @complexity O(1)
+ */
+static inline void *eytree_value(const EytzingerTree *tree, int index) {
+    return tree->values[index];
+}
+#else
+/**
+ * @brief Macro that evaluates the number of keys inside the given Eytzinger tree
+ * @return The number of keys of the tree
+ * @complexity O(1)
+ */
+#define eytree_size(tree) ((tree)->size)
+
+/**
+ * @brief Macro that evaluates the key at an Eytzinger index returned by a search
+ * @return The key at the index
+ * @complexity O(1)
+ */
+#define eytree_key(tree, index) ((tree)->keys[(index)])
+
+/**
+ * @brief Macro that evaluates the value at an Eytzinger index returned by a search
+ * @return The value at the index
+ * @complexity O(1)
+ */
+#define eytree_value(tree, index) ((tree)->values[(index)])
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //COLLECTIONS_COMMONS_EYTREE_H
@@ -18,6 +18,7 @@
 #endif
 
 #include "list.h"
+#include "bitset.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -38,6 +39,23 @@ int frame_alloc(LinkedList *frames);
  */
 bool frame_destroy(LinkedList *frames, int frame_id);
 
+/**
+ * @brief Try to allocate the lowest available frame of a bit set of available frames, then returns its index
+ * @param frames Bit set where each available frame id is set
+ * @return The allocated frame's index, otherwise -1
+ * @complexity O(n / 64) where n is the capacity of the bit set
+ */
+int frame_allocBitSet(BitSet *frames);
+
+/**
+ * @brief Give back a frame to a bit set of available frames
+ * @param frames Bit set where each available frame id is set
+ * @param frame_id Frame id to give back
+ * @return true if the frame is available again, false otherwise
+ * @complexity O(1)
+ */
+bool frame_destroyBitSet(BitSet *frames, int frame_id);
+
 #ifdef __cplusplus
 }
 #endif
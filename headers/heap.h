@@ -0,0 +1,337 @@
+/**
+ * @file heap.h
+ * @brief This file contains the API for heaps used as priority queues
+ * @author Maxime Loukhal
+ * @date 18/10/2026
+ */
+#ifndef COLLECTIONS_COMMONS_HEAP_H
+#define COLLECTIONS_COMMONS_HEAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstdbool>
+#else
+#include <stdlib.h>
+#include <stdbool.h>
+#endif
+
+/**
+ * @brief Number of children of a node when the arity given to heap_create is lower than 2
+ */
+#define HEAP_DEFAULT_ARITY 4
+
+/**
+ * @brief Data structure definition for a d-ary min heap stored in an array
+ * @details The top value is the lowest one for the compare handle, reverse the handle for a max heap. Each pushed
+ * value gets a handle that stays valid until the value leaves the heap, to update or remove it in O(d log n)
+ */
+typedef struct Heap {
+    /**
+     * @brief Number of values inside the heap
+     */
+    int size;
+    /**
+     * @brief Number of allocated slots
+     */
+    int capacity;
+    /**
+     * @brief Number of children of a node
+     */
+    int arity;
+    /**
+     * @brief Index of the first free handle, -1 if there is none
+     */
+    int freeHandles;
+    /**
+     * @brief User compare handle of the values
+     * @param key1 Key 1 to be compared
+     * @param key2 Key 2 to be compared
+     * @return A negative value if key1 goes before key2, 0 if equal, a positive value otherwise
+     */
+    int (*compare)(const void *key1, const void *key2);
+    /**
+     * @brief User destroy method to clean heap's values
+     * @param value Value to be removed from the heap
+     */
+    void (*destroy)(void *value);
+    /**
+     * @brief Values in heap order
+     */
+    void **values;
+    /**
+     * @brief Handle of the value at each position
+     */
+    int *handles;
+    /**
+     * @brief Position of the value of each handle, a negative value for free handles
+     */
+    int *positions;
+} Heap;
+
+/**
+ * @brief Data structure definition for a pairing heap node, it is the handle of its value
+ */
+typedef struct PairingHeapNode {
+    /**
+     * @brief Node's value
+     */
+    void *value;
+    /**
+     * @brief First child of the node
+     */
+    struct PairingHeapNode *child;
+    /**
+     * @brief Next sibling of the node
+     */
+    struct PairingHeapNode *sibling;
+    /**
+     * @brief Previous sibling of the node, its parent for a first child
+     */
+    struct PairingHeapNode *previous;
+} PairingHeapNode;
+
+/**
+ * @brief Data structure definition for a pairing min heap, two heaps are merged in O(1)
+ */
+typedef struct PairingHeap {
+    /**
+     * @brief Number of values inside the heap
+     */
+    int size;
+    /**
+     * @brief User compare handle of the values
+     * @param key1 Key 1 to be compared
+     * @param key2 Key 2 to be compared
+     * @return A negative value if key1 goes before key2, 0 if equal, a positive value otherwise
+     */
+    int (*compare)(const void *key1, const void *key2);
+    /**
+     * @brief User destroy method to clean heap's values
+     * @param value Value to be removed from the heap
+     */
+    void (*destroy)(void *value);
+    /**
+     * @brief Root node holding the top value, NULL if the heap is empty
+     */
+    PairingHeapNode *root;
+} PairingHeap;
+
+/**
+ * @brief Creates an empty d-ary heap
+ * @param heap Heap to be created
+ * @param arity Number of children of a node, HEAP_DEFAULT_ARITY if lower than 2
+ * @param compare User compare function of the values
+ * @param destroy Destroy user handle
+ * @complexity O(1)
+ */
+void heap_create(Heap *heap, int arity, int (*compare)(const void *key1, const void *key2),
+                 void (*destroy)(void *value));
+
+/**
+ * @brief Destroys a d-ary heap, values are destroyed with the user handle
+ * @param heap Heap to be destroyed
+ * @complexity O(n) where n is the number of values
+ */
+void heap_destroy(Heap *heap);
+
+/**
+ * @brief Allocate the slots for the given number of values, further pushes don't reallocate them
+ * @param heap Heap to grow
+ * @param size Number of values the heap must hold
+ * @return true if the heap can hold the values, false if the allocation failed
+ * @complexity O(n) where n is the number of slots
+ */
+bool heap_reserve(Heap *heap, int size);
+
+/**
+ * @brief Fill an empty heap with the values of an array, the handle of each value is its index in the array
+ * @param heap Empty heap to fill
+ * @param values Values to add
+ * @param size Number of values
+ * @return true if the heap was filled, false if it isn't empty or the allocation failed
+ * @complexity O(n) where n is the number of values
+ */
+bool heap_heapify(Heap *heap, void *const *values, int size);
+
+/**
+ * @brief Push a value in the heap, the reference to the value MUST stay accessible while it's in the heap
+ * @param heap Heap to push the value in
+ * @param value Value to push
+ * @return The handle of the value, -1 if the allocation failed
+ * @complexity O(log n) amortized where n is the number of values
+ */
+int heap_push(Heap *heap, const void *value);
+
+/**
+ * @brief Remove the top value of the heap
+ * @param heap Heap to remove the top value from
+ * @param value Reference to the removed value
+ * @return true if a value was removed, false if the heap is empty
+ * @complexity O(d log n) where d is the arity and n the number of values
+ */
+bool heap_pop(Heap *heap, void **value);
+
+/**
+ * @brief Replace the value of a handle and restore the heap order, the value can be the same one whose key changed
+ * @details Used as decrease-key by priority queues, an increased key is moved down as well
+ * @param heap Heap holding the handle
+ * @param handle Handle of the value to update
+ * @param value New value of the handle
+ * @return true if the value was updated, false if the handle isn't in the heap
+ * @complexity O(d log n) where d is the arity and n the number of values
+ */
+bool heap_update(Heap *heap, int handle, const void *value);
+
+/**
+ * @brief Remove the value of a handle from the heap
+ * @param heap Heap holding the handle
+ * @param handle Handle of the value to remove
+ * @param value Reference to the removed value
+ * @return true if the value was removed, false if the handle isn't in the heap
+ * @complexity O(d log n) where d is the arity and n the number of values
+ */
+bool heap_remove(Heap *heap, int handle, void **value);
+
+/**
+ * @brief Creates an empty pairing heap
+ * @param heap Pairing heap to be created
+ * @param compare User compare function of the values
+ * @param destroy Destroy user handle
+ * @complexity O(1)
+ */
+void pheap_create(PairingHeap *heap, int (*compare)(const void *key1, const void *key2),
+                  void (*destroy)(void *value));
+
+/**
+ * @brief Destroys a pairing heap without recursion, values are destroyed with the user handle
+ * @param heap Pairing heap to be destroyed
+ * @complexity O(n) where n is the number of values
+ */
+void pheap_destroy(PairingHeap *heap);
+
+/**
+ * @brief Push a value in the pairing heap, the reference to the value MUST stay accessible while it's in the heap
+ * @param heap Pairing heap to push the value in
+ * @param value Value to push
+ * @return The node of the value used as handle, NULL if the allocation failed
+ * @complexity O(1)
+ */
+PairingHeapNode *pheap_push(PairingHeap *heap, const void *value);
+
+/**
+ * @brief Remove the top value of the pairing heap
+ * @param heap Pairing heap to remove the top value from
+ * @param value Reference to the removed value
+ * @return true if a value was removed, false if the heap is empty
+ * @complexity O(log n) amortized where n is the number of values
+ */
+bool pheap_pop(PairingHeap *heap, void **value);
+
+/**
+ * @brief Replace the value of a node with a value that doesn't go after it
+ * @param heap Pairing heap holding the node
+ * @param node Node of the value to decrease
+ * @param value New value of the node, it can be the same one whose key decreased
+ * @return true if the value was decreased, false if the new value goes after the current one
+ * @complexity O(1), the cost is paid by the next pop
+ */
+bool pheap_decreaseKey(PairingHeap *heap, PairingHeapNode *node, const void *value);
+
+/**
+ * @brief Remove the value of a node from the pairing heap
+ * @param heap Pairing heap holding the node
+ * @param node Node of the value to remove, it is released
+ * @param value Reference to the removed value
+ * @complexity O(log n) amortized where n is the number of values
+ */
+void pheap_remove(PairingHeap *heap, PairingHeapNode *node, void **value);
+
+/**
+ * @brief Move the values of a pairing heap into another one, the handles stay valid
+ * @param heap Pairing heap receiving the values
+ * @param other Pairing heap with the same compare handle, it is left empty
+ * @complexity O(1)
+ */
+void pheap_merge(PairingHeap *heap, PairingHeap *other);
+
+#ifdef __cplusplus
+/**
+ * @brief Inline function that evaluates the number of values of the given heap
+ * @return Current size of the given heap
+ */
+static inline int heap_size(const Heap *heap) {
+    return heap->size;
+}
+
+/**
+ * @brief Inline function that peeks the top value of the given heap without removing it
+ * @return The top value, NULL if the heap is empty
+ */
+static inline void *heap_peek(const Heap *heap) {
+    return heap->size == 0 ? nullptr : heap->values[0];
+}
+
+/**
+ * @brief Inline function that evaluates the value of a handle in the heap
+ * @return The value of the given handle
+ */
+static inline void *heap_value(const Heap *heap, int handle) {
+    return heap->values[heap->positions[handle]];
+}
+
+/**
+ * @brief Inline function that evaluates the number of values of the given pairing heap
+ * @return Current size of the given pairing heap
+ */
+static inline int pheap_size(const PairingHeap *heap) {
+    return heap->size;
+}
+
+/**
+ * @brief Inline function that peeks the top value of the given pairing heap without removing it
+ * @return The top value, NULL if the heap is empty
+ */
+static inline void *pheap_peek(const PairingHeap *heap) {
+    return heap->root == nullptr ? nullptr : heap->root->value;
+}
+#else
+/**
+ * @brief Macro that evaluates the number of values of the given heap
+ * @return Current size of the given heap
+ */
+#define heap_size(heap) ((heap)->size)
+
+/**
+ * @brief Macro that peeks the top value of the given heap without removing it
+ * @return The top value, NULL if the heap is empty
+ */
+#define heap_peek(heap) ((heap)->size == 0 ? NULL : (heap)->values[0])
+
+/**
+ * @brief Macro that evaluates the value of a handle in the heap
+ * @return The value of the given handle
+ */
+#define heap_value(heap, handle) ((heap)->values[(heap)->positions[(handle)]])
+
+/**
+ * @brief Macro that evaluates the number of values of the given pairing heap
+ * @return Current size of the given pairing heap
+ */
+#define pheap_size(heap) ((heap)->size)
+
+/**
+ * @brief Macro that peeks the top value of the given pairing heap without removing it
+ * @return The top value, NULL if the heap is empty
+ */
+#define pheap_peek(heap) ((heap)->root == NULL ? NULL : (heap)->root->value)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //COLLECTIONS_COMMONS_HEAP_H
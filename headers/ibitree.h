@@ -0,0 +1,258 @@
+/**
+ * @file ibitree.h
+ * @brief This file contains the API for binary trees stored in a contiguous array of nodes linked by indexes
+ * @author Maxime Loukhal
+ * @date 18/10/2026
+ */
+#ifndef COLLECTIONS_COMMONS_IBITREE_H
+#define COLLECTIONS_COMMONS_IBITREE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstdint>
+#include <cstdbool>
+#else
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#endif
+
+#include "bitree.h"
+
+/**
+ * @brief Index of the missing nodes, the slot 0 of the node array is never used
+ */
+#define IBITREE_NULL 0u
+
+/**
+ * @brief Data structure definition for an indexed binary tree node, 16 bytes instead of 24 for a BinaryTreeNode
+ */
+typedef struct IndexedBinaryTreeNode {
+    /**
+     * @brief Node's value
+     */
+    void *value;
+    /**
+     * @brief Index of the node's left child, IBITREE_NULL if there is none, next free slot for a free slot
+     */
+    uint32_t left;
+    /**
+     * @brief Index of the node's right child, IBITREE_NULL if there is none
+     */
+    uint32_t right;
+} IndexedBinaryTreeNode;
+
+/**
+ * @brief Data structure definition for a binary tree whose nodes live in a single growable array
+ * @details Nodes are linked by 32 bits indexes that stay valid when the array is reallocated, removed nodes are kept
+ * in a free list reused by the next insertions
+ */
+typedef struct IndexedBinaryTree {
+    /**
+     * @brief Number of nodes inside the tree
+     */
+    int size;
+    /**
+     * @brief Number of used slots of the node array, free slots and the slot 0 included
+     */
+    uint32_t count;
+    /**
+     * @brief Number of allocated slots of the node array
+     */
+    uint32_t capacity;
+    /**
+     * @brief Index of the root node, IBITREE_NULL if the tree is empty
+     */
+    uint32_t root;
+    /**
+     * @brief Index of the first free slot, IBITREE_NULL if there is none
+     */
+    uint32_t freeSlots;
+    /**
+     * @brief User destroy method to clean node's value
+     * @param value Value to be removed from the tree
+     */
+    void (*destroy)(void *value);
+    /**
+     * @brief Node array
+     */
+    IndexedBinaryTreeNode *nodes;
+} IndexedBinaryTree;
+
+/**
+ * @brief Creates an empty indexed binary tree
+ * @param tree Tree to be created
+ * @param destroy Destroy user handle
+ * @complexity O(1)
+ */
+void ibitree_create(IndexedBinaryTree *tree, void (*destroy)(void *value));
+
+/**
+ * @brief Destroys an indexed binary tree, values are destroyed with the user handle while scanning the node array
+ * @param tree Indexed binary tree to be destroyed
+ * @complexity O(n) where n is the number of slots
+ */
+void ibitree_destroy(IndexedBinaryTree *tree);
+
+/**
+ * @brief Allocate the node array for the given number of nodes, further insertions don't reallocate it
+ * @param tree Indexed binary tree to grow
+ * @param size Number of nodes the tree must hold
+ * @return true if the tree can hold the nodes, false if the allocation failed
+ * @complexity O(n) where n is the number of slots
+ */
+bool ibitree_reserve(IndexedBinaryTree *tree, int size);
+
+/**
+ * @brief Try to create a new left child node of the given node in the given tree
+ * @param tree Tree to add a left node
+ * @param node Index of the node to add a left child, IBITREE_NULL to add the root of an empty tree
+ * @param value Value to be added
+ * @return true if the left node was created, false otherwise
+ * @complexity O(1) amortized
+ */
+bool ibitree_addLeft(IndexedBinaryTree *tree, uint32_t node, const void *value);
+
+/**
+ * @brief Try to create a new right child node of the given node in the given tree
+ * @param tree Tree to add a right node
+ * @param node Index of the node to add a right child, IBITREE_NULL to add the root of an empty tree
+ * @param value Value to be added
+ * @return true if the right node was created, false otherwise
+ * @complexity O(1) amortized
+ */
+bool ibitree_addRight(IndexedBinaryTree *tree, uint32_t node, const void *value);
+
+/**
+ * @brief Remove the left child of the given node with its whole subtree, without recursion
+ * @param tree Indexed binary tree where to remove the left node
+ * @param node Index of the node to remove the left child, IBITREE_NULL to remove the whole tree
+ * @complexity O(k) where k is the number of removed nodes
+ */
+void ibitree_removeLeft(IndexedBinaryTree *tree, uint32_t node);
+
+/**
+ * @brief Remove the right child of the given node with its whole subtree, without recursion
+ * @param tree Indexed binary tree where to remove the right node
+ * @param node Index of the node to remove the right child, IBITREE_NULL to remove the whole tree
+ * @complexity O(k) where k is the number of removed nodes
+ */
+void ibitree_removeRight(IndexedBinaryTree *tree, uint32_t node);
+
+/**
+ * @brief Merges the left and right trees into out where value will be set as root's value
+ * @details The node arrays are copied one after the other, the given trees are left empty
+ * @param out Output tree after tree merge operation
+ * @param left Left indexed binary tree to be merged
+ * @param right Right indexed binary tree to be merged
+ * @param value Value to be designated as out root's node value
+ * @return true if the trees were merged, false if the allocation failed
+ * @complexity O(n) where n is the number of slots of both trees
+ */
+bool ibitree_merge(IndexedBinaryTree *out, IndexedBinaryTree *left, IndexedBinaryTree *right, const void *value);
+
+/**
+ * @brief Copy a binary tree into an empty indexed binary tree, nodes are stored in level order
+ * @param out Empty indexed binary tree to fill
+ * @param tree Binary tree to copy, its values are shared
+ * @return true if the tree was copied, false if out isn't empty or the allocation failed
+ * @complexity O(n) where n is the number of nodes
+ */
+bool ibitree_fromBitree(IndexedBinaryTree *out, BinaryTree *tree);
+
+#ifdef __cplusplus
+/**
+ * @brief Inline function that evaluates the size of the given indexed binary tree
+ * @return Current size of the given indexed binary tree
+ */
+static inline int ibitree_size(const IndexedBinaryTree *tree) {
+    return tree->size;
+}
+
+/**
+ * @brief Inline function that evaluates the root index of the given indexed binary tree
+ * @return Index of the root node, IBITREE_NULL if the tree is empty
+ */
+static inline uint32_t ibitree_root(const IndexedBinaryTree *tree) {
+    return tree->root;
+}
+
+/**
+ * @brief Inline function that evaluates the left child index of a given node
+ * @return Index of the left child, IBITREE_NULL if there is none
+ */
+static inline uint32_t ibitree_left(const IndexedBinaryTree *tree, uint32_t node) {
+    return tree->nodes[node].left;
+}
+
+/**
+ * @brief Inline function that evaluates the right child index of a given node
+ * @return Index of the right child, IBITREE_NULL if there is none
+ */
+static inline uint32_t ibitree_right(const IndexedBinaryTree *tree, uint32_t node) {
+    return tree->nodes[node].right;
+}
+
+/**
+ * @brief Inline function that evaluates the value of a given node
+ * @return The value of the given node
+ */
+static inline void *ibitree_value(const IndexedBinaryTree *tree, uint32_t node) {
+    return tree->nodes[node].value;
+}
+
+/**
+ * @brief Inline function that evaluates if a node is leaf in its tree
+ * @return true if is the given node is a leaf, false otherwise
+ */
+static inline bool ibitree_isNodeLeaf(const IndexedBinaryTree *tree, uint32_t node) {
+    return tree->nodes[node].left == IBITREE_NULL && tree->nodes[node].right == IBITREE_NULL;
+}
+#else
+/**
+ * @brief Macro that evaluates the size of the given indexed binary tree
+ * @return Current size of the given indexed binary tree
+ */
+#define ibitree_size(tree) ((tree)->size)
+
+/**
+ * @brief Macro that evaluates the root index of the given indexed binary tree
+ * @return Index of the root node, IBITREE_NULL if the tree is empty
+ */
+#define ibitree_root(tree) ((tree)->root)
+
+/**
+ * @brief Macro that evaluates the left child index of a given node
+ * @return Index of the left child, IBITREE_NULL if there is none
+ */
+#define ibitree_left(tree, node) ((tree)->nodes[(node)].left)
+
+/**
+ * @brief Macro that evaluates the right child index of a given node
+ * @return Index of the right child, IBITREE_NULL if there is none
+ */
+#define ibitree_right(tree, node) ((tree)->nodes[(node)].right)
+
+/**
+ * @brief Macro that evaluates the value of a given node
+ * @return The value of the given node
+ */
+#define ibitree_value(tree, node) ((tree)->nodes[(node)].value)
+
+/**
+ * @brief Macro that evaluates if a node is leaf in its tree
+ * @return true if is the given node is a leaf, false otherwise
+ */
+#define ibitree_isNodeLeaf(tree, node) \
+    ((tree)->nodes[(node)].left == IBITREE_NULL && (tree)->nodes[(node)].right == IBITREE_NULL)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //COLLECTIONS_COMMONS_IBITREE_H
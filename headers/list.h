@@ -58,6 +58,18 @@ typedef struct LinkedList {
      */
     void (*destroy)(void *value);
 
+    /**
+     * @brief Optional hash handle, when set the list elements are indexed by their hashed value (hashed Set backend)
+     * @param value Value to hash
+     * @return The hash of the given value
+     */
+    int (*hash)(const void *value);
+
+    /**
+     * @brief Optional hash index of the list elements, NULL if the list isn't hashed
+     */
+    struct ListIndex *index;
+
     /**
      *  @brief First element of the list
      */
@@ -126,6 +138,16 @@ LinkedElement *list_getRandom(LinkedList *list);
  */
 bool list_replace(LinkedList *list, LinkedElement *element, void **value);
 
+/**
+ * @brief Sort the list by relinking its elements with a bottom-up merge sort, no element is allocated or freed
+ * @details The sort is stable, equal values keep their order. The elements stay the same so references to them and
+ * the hash index of a hashed list remain valid, the head and the tail are updated
+ * @param list Reference of the list to sort
+ * @param compare User compare function of the values, negative if key1 goes before key2, 0 if equal, positive otherwise
+ * @complexity O(n log n) time and O(1) extra space where n is the number of elements in the current list
+ */
+void list_sort(LinkedList *list, int (*compare)(const void *key1, const void *key2));
+
 /* ----- MACRO C++ COMPATIBILITY -----*/
 #ifdef __cplusplus
 /**
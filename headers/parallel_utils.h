@@ -0,0 +1,195 @@
+/**
+ * @file parallel_utils.h
+ * @brief This file contains the API for the fork-join work-stealing thread pool
+ * @author Maxime Loukhal
+ * @date 18/10/2026
+ */
+#ifndef COLLECTIONS_COMMONS_PARALLEL_UTILS_H
+#define COLLECTIONS_COMMONS_PARALLEL_UTILS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstdbool>
+#else
+#include <stdlib.h>
+#include <stdbool.h>
+#endif
+
+#include <pthread.h>
+
+#ifndef PARALLEL_DEQUE_CAPACITY
+/**
+ * @brief Maximum number of pending tasks of a worker, a fork beyond it runs the task immediately
+ */
+#define PARALLEL_DEQUE_CAPACITY 256
+#endif
+
+struct ParallelWorker;
+
+/**
+ * @brief Data structure definition for a forked task, it lives in the frame of the forking function until joined
+ */
+typedef struct ParallelTask {
+    /**
+     * @brief Task body
+     * @param worker Worker running the task, used to fork and join sub tasks
+     * @param data User data of the task
+     */
+    void (*run)(struct ParallelWorker *worker, void *data);
+    /**
+     * @brief User data of the task
+     */
+    void *data;
+    /**
+     * @brief 1 once the task was run, read and written atomically
+     */
+    int done;
+} ParallelTask;
+
+/**
+ * @brief Data structure definition for a worker of a pool, the thread calling parallel_run is the worker 0
+ */
+typedef struct ParallelWorker {
+    /**
+     * @brief Pool of the worker
+     */
+    struct ParallelPool *pool;
+    /**
+     * @brief Seed of the victim selection
+     */
+    unsigned int seed;
+    /**
+     * @brief Lock of the task deque
+     */
+    pthread_mutex_t lock;
+    /**
+     * @brief Index of the oldest pending task, taken by the thieves
+     */
+    int top;
+    /**
+     * @brief Index after the newest pending task, pushed and popped by the owner
+     */
+    int bottom;
+    /**
+     * @brief Pending tasks of the worker
+     */
+    ParallelTask *tasks[PARALLEL_DEQUE_CAPACITY];
+} ParallelWorker;
+
+/**
+ * @brief Data structure definition for a fork-join thread pool, idle workers steal the oldest tasks of the others
+ */
+typedef struct ParallelPool {
+    /**
+     * @brief Number of workers, the calling thread included
+     */
+    int threads;
+    /**
+     * @brief Number of tasks waiting in the deques
+     */
+    int pending;
+    /**
+     * @brief true once the pool is destroyed
+     */
+    bool stop;
+    /**
+     * @brief Lock of the pending counter and the stop flag
+     */
+    pthread_mutex_t lock;
+    /**
+     * @brief Signaled when a task is forked or the pool stops
+     */
+    pthread_cond_t wake;
+    /**
+     * @brief Serializes the parallel_run calls, the worker 0 is shared
+     */
+    pthread_mutex_t run;
+    /**
+     * @brief Workers of the pool
+     */
+    ParallelWorker *workers;
+    /**
+     * @brief Threads of the workers 1 to threads - 1
+     */
+    pthread_t *handles;
+} ParallelPool;
+
+/**
+ * @brief Create a thread pool
+ * @param pool Thread pool to create
+ * @param threads Number of workers including the calling thread, 0 or lower to use every online processor
+ * @return true if the pool was created, false if the allocation or a thread creation failed
+ * @complexity O(t) where t is the number of threads
+ */
+bool parallel_create(ParallelPool *pool, int threads);
+
+/**
+ * @brief Stop and join the threads of the given pool, no task may be running
+ * @param pool Thread pool to destroy
+ * @complexity O(t) where t is the number of threads
+ */
+void parallel_destroy(ParallelPool *pool);
+
+/**
+ * @brief Run a root task on the calling thread, the workers help through forked tasks until it returns
+ * @param pool Thread pool running the task
+ * @param run Task body
+ * @param data User data of the task
+ */
+void parallel_run(ParallelPool *pool, void (*run)(ParallelWorker *worker, void *data), void *data);
+
+/**
+ * @brief Fork a task that any worker may run until it is joined
+ * @param worker Worker running the current task
+ * @param task Task to fork, it MUST stay alive until it is joined
+ * @param run Task body
+ * @param data User data of the task
+ */
+void parallel_fork(ParallelWorker *worker, ParallelTask *task, void (*run)(ParallelWorker *worker, void *data),
+                   void *data);
+
+/**
+ * @brief Wait for a forked task, the waiting worker runs pending tasks meanwhile
+ * @param worker Worker that forked the task
+ * @param task Task to join
+ */
+void parallel_join(ParallelWorker *worker, ParallelTask *task);
+
+/**
+ * @brief Apply a body on the [begin, end) range split in halves forked until they are under the grain
+ * @param worker Worker running the current task
+ * @param begin First index of the range
+ * @param end Index after the last index of the range
+ * @param grain Maximum number of indexes of a chunk given to the body
+ * @param body User function applied on each chunk
+ * @param data User data given to the body
+ * @complexity O(n / t + log(n)) where n is the number of indexes and t the number of threads
+ */
+void parallel_for(ParallelWorker *worker, int begin, int end, int grain,
+                  void (*body)(int begin, int end, void *data), void *data);
+
+#ifdef __cplusplus
+/**
+ * @brief Inline function that evaluates the number of workers of the given pool
+ * @return The number of workers, the calling thread included
+ */
+static inline int parallel_threads(const ParallelPool *pool) {
+    return pool->threads;
+}
+#else
+/**
+ * @brief Macro that evaluates the number of workers of the given pool
+ * @return The number of workers, the calling thread included
+ */
+#define parallel_threads(pool) ((pool)->threads)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //COLLECTIONS_COMMONS_PARALLEL_UTILS_H
@@ -8,4 +8,279 @@
 #ifndef COLLECTIONS_COMMONS_RBTREE_H
 #define COLLECTIONS_COMMONS_RBTREE_H
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstdbool>
+#else
+#include <stdlib.h>
+#include <stdbool.h>
+#endif
+
+/**
+ * @brief Color of a Red-Black tree node
+ */
+typedef enum RedBlackColor {
+    RBTREE_RED = 0,
+    RBTREE_BLACK = 1
+} RedBlackColor;
+
+/**
+ * @brief Data structure definition for a Red-Black tree node, a key with its associated value
+ */
+typedef struct RedBlackNode {
+    /**
+     * @brief Key of the node
+     */
+    void *key;
+    /**
+     * @brief Value associated to the key, NULL when the tree is used as an ordered set
+     */
+    void *value;
+    /**
+     * @brief Parent node, NULL for the root
+     */
+    struct RedBlackNode *parent;
+    /**
+     * @brief Left child, holding the lower keys
+     */
+    struct RedBlackNode *left;
+    /**
+     * @brief Right child, holding the greater keys
+     */
+    struct RedBlackNode *right;
+    /**
+     * @brief Color of the node
+     */
+    RedBlackColor color;
+} RedBlackNode;
+
+/**
+ * @brief Data structure definition for an ordered map based on a Red-Black tree, nodes are allocated from a pool
+ */
+typedef struct RedBlackTree {
+    /**
+     * @brief Number of nodes inside the tree
+     */
+    int size;
+
+    /**
+     * @brief User compare handle, defines the order of the keys
+     * @param key1 Left key to compare
+     * @param key2 Right key to compare
+     * @return A negative value if key1 < key2, 0 if key1 == key2, a positive value otherwise
+     */
+    int (*compare)(const void *key1, const void *key2);
+
+    /**
+     * @brief Optional destroy handle of the keys
+     * @param key Key to destroy
+     */
+    void (*destroyKey)(void *key);
+
+    /**
+     * @brief Optional destroy handle of the values
+     * @param value Value to destroy
+     */
+    void (*destroyValue)(void *value);
+
+    /**
+     * @brief Root node of the tree
+     */
+    RedBlackNode *root;
+
+    /**
+     * @brief Released nodes of the pool, chained through their right child
+     */
+    RedBlackNode *freeNodes;
+
+    /**
+     * @brief Node blocks of the pool
+     */
+    struct RedBlackBlock *blocks;
+
+    /**
+     * @brief Number of nodes of the next pool block
+     */
+    int blockNodes;
+} RedBlackTree;
+
+/**
+ * @brief Create an empty Red-Black tree
+ * @param tree Red-Black tree to create
+ * @param compare User compare function of the keys
+ * @param destroy_key Optional destroy function of the keys
+ * @param destroy_value Optional destroy function of the values
+ * @complexity O(1)
+ */
+void rbtree_create(RedBlackTree *tree, int (*compare)(const void *key1, const void *key2),
+                   void (*destroy_key)(void *key), void (*destroy_value)(void *value));
+
+/**
+ * @brief Destroy the given Red-Black tree, keys and values are destroyed with the user handles
+ * @param tree Red-Black tree to destroy
+ * @complexity O(n) where n is the number of nodes
+ */
+void rbtree_destroy(RedBlackTree *tree);
+
+/**
+ * @brief Insert a key with its associated value in the given Red-Black tree
+ * @param tree Red-Black tree to insert in
+ * @param key Key to insert
+ * @param value Value associated to the key
+ * @return true if the key was inserted, false if the key is already present or the allocation failed
+ * @complexity O(log(n)) where n is the number of nodes
+ */
+bool rbtree_insert(RedBlackTree *tree, const void *key, const void *value);
+
+/**
+ * @brief Remove a key from the given Red-Black tree, the stored key and value are returned to the caller
+ * @param tree Red-Black tree to remove from
+ * @param key Key to remove
+ * @param stored_key Optional output pointer on the removed key
+ * @param value Optional output pointer on the removed value
+ * @return true if the key was removed, false otherwise
+ * @complexity O(log(n)) where n is the number of nodes
+ */
+bool rbtree_remove(RedBlackTree *tree, const void *key, void **stored_key, void **value);
+
+/**
+ * @brief Remove a node from the given Red-Black tree, the stored key and value are returned to the caller
+ * @param tree Red-Black tree to remove from
+ * @param node Node of the tree to remove
+ * @param stored_key Optional output pointer on the removed key
+ * @param value Optional output pointer on the removed value
+ * @complexity O(log(n)) where n is the number of nodes
+ */
+void rbtree_removeNode(RedBlackTree *tree, RedBlackNode *node, void **stored_key, void **value);
+
+/**
+ * @brief Search the node of a key
+ * @param tree Red-Black tree to search in
+ * @param key Key to search
+ * @return The node of the key, NULL if not found
+ * @complexity O(log(n)) where n is the number of nodes
+ */
+RedBlackNode *rbtree_find(const RedBlackTree *tree, const void *key);
+
+/**
+ * @brief Search the first node whose key is not lower than the given key
+ * @param tree Red-Black tree to search in
+ * @param key Key to search
+ * @return The first node with a key >= key, NULL if there is none
+ * @complexity O(log(n)) where n is the number of nodes
+ */
+RedBlackNode *rbtree_lowerBound(const RedBlackTree *tree, const void *key);
+
+/**
+ * @brief Search the first node whose key is greater than the given key
+ * @param tree Red-Black tree to search in
+ * @param key Key to search
+ * @return The first node with a key > key, NULL if there is none
+ * @complexity O(log(n)) where n is the number of nodes
+ */
+RedBlackNode *rbtree_upperBound(const RedBlackTree *tree, const void *key);
+
+/**
+ * @brief Evaluate the node of the lowest key
+ * @param tree Red-Black tree to search in
+ * @return The node of the lowest key, NULL if the tree is empty
+ * @complexity O(log(n)) where n is the number of nodes
+ */
+RedBlackNode *rbtree_first(const RedBlackTree *tree);
+
+/**
+ * @brief Evaluate the node of the greatest key
+ * @param tree Red-Black tree to search in
+ * @return The node of the greatest key, NULL if the tree is empty
+ * @complexity O(log(n)) where n is the number of nodes
+ */
+RedBlackNode *rbtree_last(const RedBlackTree *tree);
+
+/**
+ * @brief Evaluate the in-order successor of a node
+ * @param node Node to evaluate the successor of
+ * @return The successor node, NULL if the node holds the greatest key
+ * @complexity O(1) amortized over a full iteration, O(log(n)) in the worst case
+ */
+RedBlackNode *rbtree_next(const RedBlackNode *node);
+
+/**
+ * @brief Evaluate the in-order predecessor of a node
+ * @param node Node to evaluate the predecessor of
+ * @return The predecessor node, NULL if the node holds the lowest key
+ * @complexity O(1) amortized over a full iteration, O(log(n)) in the worst case
+ */
+RedBlackNode *rbtree_previous(const RedBlackNode *node);
+
+/**
+ * @brief Visit in ascending order the nodes whose keys are in the [low, high) range
+ * @param tree Red-Black tree to visit
+ * @param low Lowest key of the range, NULL for no lower bound
+ * @param high Upper excluded key of the range, NULL for no upper bound
+ * @param visit User visitor, returns false to stop the iteration
+ * @param data User data given to the visitor
+ * @return true if all the nodes of the range were visited, false if the visitor stopped the iteration
+ * @complexity O(log(n) + k) where n is the number of nodes and k the number of visited nodes
+ */
+bool rbtree_range(const RedBlackTree *tree, const void *low, const void *high,
+                  bool (*visit)(const void *key, void *value, void *data), void *data);
+
+#ifdef __cplusplus
+/**
+ * @brief Inline function that evaluates the number of nodes inside the given Red-Black tree
+ * @return The number of nodes of the tree
+ * @complexity O(1)
+ */
+static inline int rbtree_size(const RedBlackTree *tree) {
+    return tree->size;
+}
+
+/**
+ * @brief Inline function that evaluates the key of a Red-Black tree node
+ * @return The key of the node
+ * @complexity O(1)
+ */
+static inline void *rbtree_key(const RedBlackNode *node) {
+    return node->key;
+}
+
+/**
+ * @brief Inline function that evaluates the value of a Red-Black tree node
+ * @return The value of the node
+ * @complexity O(1)
+ */
+static inline void *rbtree_value(const RedBlackNode *node) {
+    return node->value;
+}
+#else
+/**
+ * @brief Macro that evaluates the number of nodes inside the given Red-Black tree
+ * @return The number of nodes of the tree
+ * @complexity O(1)
+ */
+#define rbtree_size(tree) ((tree)->size)
+
+/**
+ * @brief Macro that evaluates the key of a Red-Black tree node
+ * @return The key of the node
+ * @complexity O(1)
+ */
+#define rbtree_key(node) ((node)->key)
+
+/**
+ * @brief Macro that evaluates the value of a Red-Black tree node
+ * @return The value of the node
+ * @complexity O(1)
+ */
+#define rbtree_value(node) ((node)->value)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif //COLLECTIONS_COMMONS_RBTREE_H
@@ -0,0 +1,229 @@
+/**
+ * @file roaring.h
+ * @brief This file contains the API for compressed bitmaps of 32 bits integers (Roaring bitmaps)
+ * @author Maxime Loukhal
+ * @date 18/10/2026
+ */
+#ifndef COLLECTIONS_COMMONS_ROARING_H
+#define COLLECTIONS_COMMONS_ROARING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstdint>
+#include <cstdbool>
+#else
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#endif
+
+/**
+ * @brief Kind of storage of a Roaring container
+ */
+typedef enum RoaringContainerType {
+    /**
+     * @brief Sorted array of up to 4096 low 16 bits values
+     */
+    ROARING_ARRAY = 0,
+    /**
+     * @brief Bitmap of the 65536 low 16 bits values
+     */
+    ROARING_BITMAP = 1,
+    /**
+     * @brief Sorted runs of consecutive low 16 bits values, stored as (start, length - 1) pairs
+     */
+    ROARING_RUN = 2
+} RoaringContainerType;
+
+/**
+ * @brief Data structure definition for the values of a Roaring bitmap sharing the same high 16 bits
+ */
+typedef struct RoaringContainer {
+    /**
+     * @brief High 16 bits shared by the container values
+     */
+    uint16_t key;
+    /**
+     * @brief Storage kind of the container
+     */
+    RoaringContainerType type;
+    /**
+     * @brief Number of values inside the container
+     */
+    int cardinality;
+    /**
+     * @brief Number of runs of a run container
+     */
+    int runs;
+    /**
+     * @brief Number of 16 bits words allocated for array and run containers
+     */
+    int capacity;
+    /**
+     * @brief Container storage, uint16_t values, uint64_t bitmap words or uint16_t run pairs
+     */
+    void *data;
+} RoaringContainer;
+
+/**
+ * @brief Data structure definition for a compressed set of 32 bits unsigned integers, split in 65536 values chunks
+ */
+typedef struct RoaringBitmap {
+    /**
+     * @brief Number of containers
+     */
+    int size;
+    /**
+     * @brief Number of allocated containers
+     */
+    int capacity;
+    /**
+     * @brief Containers sorted by key
+     */
+    RoaringContainer *containers;
+} RoaringBitmap;
+
+/**
+ * @brief Create an empty Roaring bitmap
+ * @param bitmap Roaring bitmap to create
+ * @complexity O(1)
+ */
+void roaring_create(RoaringBitmap *bitmap);
+
+/**
+ * @brief Destroy the given Roaring bitmap
+ * @param bitmap Roaring bitmap to destroy
+ * @complexity O(c) where c is the number of containers
+ */
+void roaring_destroy(RoaringBitmap *bitmap);
+
+/**
+ * @brief Try to add a value in the given Roaring bitmap
+ * @param bitmap Roaring bitmap to add the value in
+ * @param value Value to add
+ * @return true if the value was added, false if it was already present or the allocation failed
+ * @complexity O(log(c) + 4096) in the worst case of an array container insertion
+ */
+bool roaring_add(RoaringBitmap *bitmap, uint32_t value);
+
+/**
+ * @brief Remove a value from the given Roaring bitmap
+ * @param bitmap Roaring bitmap to remove the value from
+ * @param value Value to remove
+ * @return true if the value was removed, false otherwise
+ * @complexity O(log(c) + 4096) in the worst case of an array container removal
+ */
+bool roaring_remove(RoaringBitmap *bitmap, uint32_t value);
+
+/**
+ * @brief Test if a value is in the given Roaring bitmap
+ * @param bitmap Roaring bitmap to search in
+ * @param value Value to search
+ * @return true if the value is in the bitmap, false otherwise
+ * @complexity O(log(c) + log(4096))
+ */
+bool roaring_contains(const RoaringBitmap *bitmap, uint32_t value);
+
+/**
+ * @brief Count the values inside the given Roaring bitmap
+ * @param bitmap Roaring bitmap to count the values of
+ * @return The number of values inside the bitmap
+ * @complexity O(c) where c is the number of containers
+ */
+uint64_t roaring_cardinality(const RoaringBitmap *bitmap);
+
+/**
+ * @brief Build a Roaring bitmap resulting of the union of left and right
+ * @param union_result Roaring bitmap created by the call
+ * @param left Left Roaring bitmap operand
+ * @param right Right Roaring bitmap operand
+ * @return true if the union succeed, false otherwise
+ * @complexity O(m + n) where m and n are the storage sizes of the operands
+ */
+bool roaring_union(RoaringBitmap *union_result, const RoaringBitmap *left, const RoaringBitmap *right);
+
+/**
+ * @brief Build a Roaring bitmap resulting of the intersection of left and right
+ * @param intersection_result Roaring bitmap created by the call
+ * @param left Left Roaring bitmap operand
+ * @param right Right Roaring bitmap operand
+ * @return true if the intersection succeed, false otherwise
+ * @complexity O(m + n) where m and n are the storage sizes of the common containers of the operands
+ */
+bool roaring_intersection(RoaringBitmap *intersection_result, const RoaringBitmap *left, const RoaringBitmap *right);
+
+/**
+ * @brief Convert the containers holding long runs of consecutive values into run containers when they are smaller
+ * @details Run containers are read-only, they are converted back to array or bitmap containers when modified
+ * @param bitmap Roaring bitmap to optimize
+ * @return true if at least one container was converted, false otherwise
+ * @complexity O(n) where n is the storage size of the bitmap
+ */
+bool roaring_runOptimize(RoaringBitmap *bitmap);
+
+/**
+ * @brief Visit the values of the given Roaring bitmap in ascending order
+ * @param bitmap Roaring bitmap to visit
+ * @param visit User visitor, returns false to stop the iteration
+ * @param data User data given to the visitor
+ * @return true if all the values were visited, false if the visitor stopped the iteration
+ * @complexity O(n) where n is the number of values
+ */
+bool roaring_forEach(const RoaringBitmap *bitmap, bool (*visit)(uint32_t value, void *data), void *data);
+
+/**
+ * @brief Compute the number of bytes needed to serialize the given Roaring bitmap
+ * @param bitmap Roaring bitmap to serialize
+ * @return The serialized size in bytes
+ * @complexity O(c) where c is the number of containers
+ */
+size_t roaring_serializedSize(const RoaringBitmap *bitmap);
+
+/**
+ * @brief Serialize the given Roaring bitmap in a portable little endian format
+ * @param bitmap Roaring bitmap to serialize
+ * @param buffer Output buffer, it MUST hold roaring_serializedSize bytes
+ * @return The number of bytes written
+ * @complexity O(n) where n is the storage size of the bitmap
+ */
+size_t roaring_serialize(const RoaringBitmap *bitmap, void *buffer);
+
+/**
+ * @brief Create a Roaring bitmap from its serialized form
+ * @param bitmap Roaring bitmap created by the call
+ * @param buffer Serialized bitmap
+ * @param size Number of bytes inside the buffer
+ * @return true if the bitmap was deserialized, false if the buffer is malformed or the allocation failed
+ * @complexity O(n) where n is the storage size of the bitmap
+ */
+bool roaring_deserialize(RoaringBitmap *bitmap, const void *buffer, size_t size);
+
+#ifdef __cplusplus
+/**
+ * @brief Inline function that evaluates if the given Roaring bitmap is empty
+ * @param bitmap Roaring bitmap to test
+ * @return true if the bitmap holds no value, false otherwise
+ * @complexity O(1)
+ */
+static inline bool roaring_isEmpty(const RoaringBitmap *bitmap) {
+    return bitmap->size == 0;
+}
+#else
+/**
+ * @brief Macro that evaluates if the given Roaring bitmap is empty
+ * @param bitmap Roaring bitmap to test
+ * @return true if the bitmap holds no value, false otherwise
+ * @complexity O(1)
+ */
+#define roaring_isEmpty(bitmap) ((bitmap)->size == 0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //COLLECTIONS_COMMONS_ROARING_H
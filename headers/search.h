@@ -0,0 +1,124 @@
+/**
+ * @file search.h
+ * @brief This file contains the API for searching sorted arrays
+ * @author Maxime Loukhal
+ * @date 18/10/2026
+ */
+#ifndef COLLECTIONS_COMMONS_SEARCH_H
+#define COLLECTIONS_COMMONS_SEARCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstdint>
+#include <cstdbool>
+#else
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#endif
+
+/**
+ * @brief Number of integers up to which the integer searches scan the whole array instead of halving it
+ */
+#define SEARCH_LINEAR_THRESHOLD 16
+
+/**
+ * @brief Search the first element of a sorted generic array that doesn't go before the given key
+ * @details Branchless binary search, the range is halved by a conditional move whatever the compare result so the
+ * loop has no mispredicted branch and runs exactly ceil(log2(n)) times
+ * @param base Array sorted in the compare order
+ * @param count Number of elements inside the array
+ * @param size Size of an element in bytes
+ * @param key Key to search, passed to the compare function as its second argument
+ * @param compare User compare function
+ * @return The index of the first element not lower than the key, count if every element is lower
+ * @complexity O(log(n)) where n is the number of elements
+ */
+int array_lowerBound(const void *base, int count, size_t size, const void *key,
+                     int (*compare)(const void *key1, const void *key2));
+
+/**
+ * @brief Search the first element of a sorted generic array that goes after the given key
+ * @param base Array sorted in the compare order
+ * @param count Number of elements inside the array
+ * @param size Size of an element in bytes
+ * @param key Key to search, passed to the compare function as its second argument
+ * @param compare User compare function
+ * @return The index of the first element greater than the key, count if no element is greater
+ * @complexity O(log(n)) where n is the number of elements
+ */
+int array_upperBound(const void *base, int count, size_t size, const void *key,
+                     int (*compare)(const void *key1, const void *key2));
+
+/**
+ * @brief Search the range of the elements of a sorted generic array equal to the given key
+ * @param base Array sorted in the compare order
+ * @param count Number of elements inside the array
+ * @param size Size of an element in bytes
+ * @param key Key to search, passed to the compare function as its second argument
+ * @param compare User compare function
+ * @param first Output index of the first equal element, the lower bound of the key
+ * @return The number of elements equal to the key
+ * @complexity O(log(n)) where n is the number of elements
+ */
+int array_equalRange(const void *base, int count, size_t size, const void *key,
+                     int (*compare)(const void *key1, const void *key2), int *first);
+
+/**
+ * @brief Search an element of a sorted generic array equal to the given key
+ * @param base Array sorted in the compare order
+ * @param count Number of elements inside the array
+ * @param size Size of an element in bytes
+ * @param key Key to search, passed to the compare function as its second argument
+ * @param compare User compare function
+ * @return The index of the first element equal to the key, -1 if there is none
+ * @complexity O(log(n)) where n is the number of elements
+ */
+int array_search(const void *base, int count, size_t size, const void *key,
+                 int (*compare)(const void *key1, const void *key2));
+
+/**
+ * @brief Search the first integer of a sorted array that is greater or equal to the given key
+ * @details Arrays up to SEARCH_LINEAR_THRESHOLD integers are scanned by a counting kernel, with AVX2 if the CPU
+ * supports it, larger ones by a branchless binary search prefetching both possible next probes
+ * @param values Integers sorted in ascending order
+ * @param count Number of integers
+ * @param key Key to search
+ * @return The index of the first integer not lower than the key, count if every integer is lower
+ * @complexity O(log(n)) where n is the number of integers
+ */
+int array_lowerBoundInt64(const int64_t *values, int count, int64_t key);
+
+/**
+ * @brief Search the first integer of a sorted array that is greater than the given key
+ * @param values Integers sorted in ascending order
+ * @param count Number of integers
+ * @param key Key to search
+ * @return The index of the first integer greater than the key, count if no integer is greater
+ * @complexity O(log(n)) where n is the number of integers
+ */
+int array_upperBoundInt64(const int64_t *values, int count, int64_t key);
+
+/**
+ * @brief Search the first integer of a sorted array that is greater or equal to the given key, probing where the
+ * key would be if the integers were uniformly distributed
+ * @details Each interpolated probe is followed by a probe about sqrt(n) integers away that brackets the key when the
+ * integers are uniform, and by a bisection when the range didn't halve so skewed inputs stay logarithmic. The last
+ * SEARCH_LINEAR_THRESHOLD integers are scanned. Worth it over array_lowerBoundInt64 for large uniform arrays only
+ * @param values Integers sorted in ascending order
+ * @param count Number of integers
+ * @param key Key to search
+ * @return The index of the first integer not lower than the key, count if every integer is lower
+ * @complexity O(log(log(n))) on average for uniform integers where n is the number of integers, O(log(n)) otherwise
+ */
+int array_interpolationSearch(const int64_t *values, int count, int64_t key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //COLLECTIONS_COMMONS_SEARCH_H
@@ -18,6 +18,36 @@ extern "C" {
  */
 typedef LinkedList Set;
 
+/**
+ * @brief Data structure definition for a generic dataset stored as a sorted array, for read-mostly sets
+ */
+typedef struct SortedSet {
+    /**
+     * @brief Current size of the set
+     */
+    int size;
+    /**
+     * @brief Number of values the set can hold without reallocation
+     */
+    int capacity;
+    /**
+     * @brief User compare handle, defines the order of the set values
+     * @param key1 Left value to compare
+     * @param key2 Right value to compare
+     * @return A negative value if key1 < key2, 0 if they are equal, a positive value otherwise
+     */
+    int (*compare)(const void *key1, const void *key2);
+    /**
+     * @brief Destroy handle
+     * @param value Reference to value to destroy
+     */
+    void (*destroy)(void *value);
+    /**
+     * @brief Set values in ascending order
+     */
+    void **values;
+} SortedSet;
+
 /**
  * @brief Data structure for a set identify by a generic key
  */
@@ -27,13 +57,23 @@ typedef struct KeySetEntry {
 } KeySetEntry;
 
 /**
- * @brief Determine if sets from hashtable to equals are covering ALL hashtable, if true return the best solution
- * @param elements Elements to be covered
- * @param elements_to_equals Sub sets to determine if they can cover ALL hashtable
- * @param equalsed_elements Shortest list of hashtable that equals ALL hashtable
- * @return True if hashtable to equals are covering ALL hashtable, false otherwise
+ * @brief Greedy set cover, determine if the candidate sets are covering ALL elements, if true return the selected candidates
+ * @details Candidates are selected by lazy greedy: they are kept in a priority queue keyed by their last known number of
+ * uncovered elements and only the top candidate is re-evaluated on each round. Covered elements are removed from
+ * elements (destroyed if it has a destroy function) and selected candidates are removed from elements_to_match.
+ * Ties are broken in favor of the first candidate of elements_to_match.
+ * @param elements Elements to be covered, a hashed Set makes the elements indexing linear
+ * @param elements_to_match Candidate sets, a Set of KeySetEntry
+ * @param matched_elements Set created by the call, receives the selected KeySetEntry
+ * @return True if the selected candidates are covering ALL elements, false otherwise
+ * @complexity O(t log(m)) where t is the total size of the m candidate sets, O(t n) to index elements without hash
+ */
+bool set_match_entries(Set *elements, Set *elements_to_match, Set *matched_elements);
+
+/**
+ * @brief Former name of set_match_entries
  */
-bool set_equals_entries(Set *elements, Set *elements_to_equals, Set *equalsed_elements);
+#define set_equals_entries set_match_entries
 
 /**
  * @brief Create a Set
@@ -44,12 +84,36 @@ bool set_equals_entries(Set *elements, Set *elements_to_equals, Set *equalsed_el
  */
 void set_create(Set *set, bool (*equals)(const void *left, const void *right), void (*destroy)(void *value));
 
+/**
+ * @brief Create a hashed Set, its elements are indexed by the given hash function so membership tests are O(1)
+ * @param set Set reference to create
+ * @param containers Expected number of elements, used to size the internal hash index
+ * @param hash User hash function for the set values, equal values MUST have the same hash
+ * @param equals User equals function to determine if hashtable are equals or not
+ * @param destroy User destroy function to clean set hashtable on remove
+ * @return true if the set was created, false otherwise
+ * @complexity O(m) where m is the number of slots of the internal hash index
+ * @note A hashed Set MUST only be modified through the set API, list operations would desynchronize its index
+ */
+bool set_createHashed(Set *set,
+                      int containers,
+                      int (*hash)(const void *value),
+                      bool (*equals)(const void *left, const void *right),
+                      void (*destroy)(void *value));
+
+/**
+ * @brief Destroy the given set, after the call no other further operations will be permit
+ * @param set Set to destroy
+ * @complexity O(n) where n is the number of hashtable inside the given Set to destroy
+ */
+void set_destroy(Set *set);
+
 /**
  * @biref Try to insert a value in the given set
  * @param set Set to insert a value in
  * @param value Value to insert in the set
  * @return True if the value was inserted in the given Set, false otherwise
- * @complexity O(n) where n is the number of hashtable inside the given Set to compare with the parameter value
+ * @complexity O(n) where n is the number of hashtable inside the given Set to compare with the parameter value, O(1) for hashed sets
  */
 bool set_add(Set *set, const void *value);
 
@@ -58,7 +122,7 @@ bool set_add(Set *set, const void *value);
  * @param set Set to remove a value in
  * @param value Reference to the delete value in the given set
  * @return True if the value was correctly removed, otherwise
- * @complexity O(n) where n is the number of hashtable inside the given Set to compare with the parameter value
+ * @complexity O(n) where n is the number of hashtable inside the given Set to compare with the parameter value, O(1) for hashed sets
  */
 bool set_remove(Set *set, void **value);
 
@@ -68,7 +132,7 @@ bool set_remove(Set *set, void **value);
  * @param left Left Set to compare for union operation
  * @param right Right Set to compare for union operation
  * @return true if the union succeed, false otherwise
- * @complexity O(mn) where m and n are the number of hashtable in each operand
+ * @complexity O(mn) where m and n are the number of hashtable in each operand, O(m + n) if left is hashed
  */
 bool set_union(Set *union_result, const Set *left, const Set *right);
 
@@ -78,7 +142,7 @@ bool set_union(Set *union_result, const Set *left, const Set *right);
  * @param left Left Set to compare for intersection operation
  * @param right Right Set to compare for intersection operation
  * @return true if the intersection succeed, false otherwise
- * @complexity O(mn) where m and n are the number of hashtable in each operand
+ * @complexity O(mn) where m and n are the number of hashtable in each operand, O(m) if right is hashed
  */
 bool set_intersection(Set *intersection_result, const Set *left, const Set *right);
 
@@ -88,7 +152,7 @@ bool set_intersection(Set *intersection_result, const Set *left, const Set *righ
  * @param left Left Set to compare for difference operation
  * @param right Right Set to compare for difference operation
  * @return true if the difference succeed, false otherwise
- * @complexity O(mn) where m and n are the number of hashtable in each operand
+ * @complexity O(mn) where m and n are the number of hashtable in each operand, O(m) if right is hashed
  */
 bool set_difference(Set *difference_result, const Set *left, const Set *right);
 
@@ -97,7 +161,7 @@ bool set_difference(Set *difference_result, const Set *left, const Set *right);
  * @param set Set to search in
  * @param value Value to search in the set
  * @return true if the element is in the set, false otherwise
- * @complexity O(n) where n is the number of hashtable inside the given Set to compare with the parameter value
+ * @complexity O(n) where n is the number of hashtable inside the given Set to compare with the parameter value, O(1) for hashed sets
  */
 bool set_isMember(const Set *set, const void *value);
 
@@ -106,7 +170,7 @@ bool set_isMember(const Set *set, const void *value);
  * @param left Set to determine if it's a subset of right operand
  * @param right Set to be compared with left operand
  * @return true if the left Set is a subset of the right Set, false otherwise
- * @complexity O(mn) where m and n are the number of hashtable in each operand
+ * @complexity O(mn) where m and n are the number of hashtable in each operand, O(m) if right is hashed
  */
 bool set_isSubset(const Set *left, const Set *right);
 
@@ -115,7 +179,7 @@ bool set_isSubset(const Set *left, const Set *right);
  * @param left Left Set reference operand
  * @param right Right Set reference operand
  * @return true if left and right are equal, false otherwise
- * @complexity O(n ^ 2 ) where n is the number of hashtable inside left AND right
+ * @complexity O(n ^ 2 ) where n is the number of hashtable inside left AND right, O(n) if right is hashed
  */
 bool set_equals(const Set *left, const Set *right);
 
@@ -126,6 +190,132 @@ bool set_equals(const Set *left, const Set *right);
  */
 Set *set_toHashSet(Set *set, int (*hash)(const void *key));
 
+/**
+ * @brief Create an empty sorted set
+ * @param set Sorted set to create
+ * @param capacity Number of values to reserve
+ * @param compare User compare function defining the order of the values
+ * @param destroy User destroy function to clean set values on destroy
+ * @return true if the sorted set was created, false otherwise
+ * @complexity O(1)
+ */
+bool sortedset_create(SortedSet *set, int capacity, int (*compare)(const void *key1, const void *key2),
+                      void (*destroy)(void *value));
+
+/**
+ * @brief Create a sorted set from an array of values, duplicated values are kept once
+ * @param set Sorted set to create
+ * @param values Array of values, for example the result of a *_toArray function
+ * @param count Number of values inside the array
+ * @param compare User compare function defining the order of the values
+ * @param destroy User destroy function to clean set values on destroy, duplicates are not destroyed
+ * @return true if the sorted set was created, false otherwise
+ * @complexity O(n log(n)) where n is the number of values
+ */
+bool sortedset_fromArray(SortedSet *set, void **values, int count, int (*compare)(const void *key1, const void *key2),
+                         void (*destroy)(void *value));
+
+/**
+ * @brief Destroy the given sorted set
+ * @param set Sorted set to destroy
+ * @complexity O(n) where n is the number of values inside the set
+ */
+void sortedset_destroy(SortedSet *set);
+
+/**
+ * @brief Remove all the values of the given sorted set without releasing its storage, values are not destroyed
+ * @param set Sorted set to clear
+ * @complexity O(1)
+ */
+void sortedset_clear(SortedSet *set);
+
+/**
+ * @brief Try to insert a value in the given sorted set
+ * @param set Sorted set to insert a value in
+ * @param value Value to insert
+ * @return true if the value was inserted, false if it was already present or the allocation failed
+ * @complexity O(n) where n is the number of values inside the set
+ */
+bool sortedset_add(SortedSet *set, const void *value);
+
+/**
+ * @brief Remove from the sorted set a value that equals the value parameter then return a pointer to the removed value
+ * @param set Sorted set to remove a value in
+ * @param value Reference to the value to remove, returns the removed value
+ * @return true if the value was removed, false otherwise
+ * @complexity O(n) where n is the number of values inside the set
+ */
+bool sortedset_remove(SortedSet *set, void **value);
+
+/**
+ * @brief Test if the value is in the given sorted set
+ * @param set Sorted set to search in
+ * @param value Value to search
+ * @return true if the value is in the set, false otherwise
+ * @complexity O(log(n)) where n is the number of values inside the set
+ */
+bool sortedset_isMember(const SortedSet *set, const void *value);
+
+/**
+ * @brief Build the union of left and right into an existing sorted set, left and right MUST stay accessible before result is destroy
+ * @param union_result Created sorted set receiving the union, its storage is reused and grown at most once
+ * @param left Left sorted set operand
+ * @param right Right sorted set operand
+ * @return true if the union succeed, false otherwise
+ * @complexity O(m + n) where m and n are the number of values in each operand
+ */
+bool sortedset_union(SortedSet *union_result, const SortedSet *left, const SortedSet *right);
+
+/**
+ * @brief Build the intersection of left and right into an existing sorted set, left and right MUST stay accessible before result is destroy
+ * @param intersection_result Created sorted set receiving the intersection, its storage is reused and grown at most once
+ * @param left Left sorted set operand
+ * @param right Right sorted set operand
+ * @return true if the intersection succeed, false otherwise
+ * @complexity O(m + n), O(m log(n / m)) when one operand is much smaller than the other
+ */
+bool sortedset_intersection(SortedSet *intersection_result, const SortedSet *left, const SortedSet *right);
+
+/**
+ * @brief Build the difference of left and right into an existing sorted set, left and right MUST stay accessible before result is destroy
+ * @param difference_result Created sorted set receiving the difference, its storage is reused and grown at most once
+ * @param left Left sorted set operand
+ * @param right Right sorted set operand
+ * @return true if the difference succeed, false otherwise
+ * @complexity O(m + n), O(m log(n / m)) when one operand is much smaller than the other
+ */
+bool sortedset_difference(SortedSet *difference_result, const SortedSet *left, const SortedSet *right);
+
+/**
+ * @brief Test if the left operand is a subset of the right operand
+ * @param left Sorted set to determine if it's a subset of right operand
+ * @param right Sorted set to be compared with left operand
+ * @return true if left is a subset of right, false otherwise
+ * @complexity O(m + n), O(m log(n / m)) when left is much smaller than right
+ */
+bool sortedset_isSubset(const SortedSet *left, const SortedSet *right);
+
+/**
+ * @brief Test if left and right sorted set operands are equal
+ * @param left Left sorted set operand
+ * @param right Right sorted set operand
+ * @return true if left and right are equal, false otherwise
+ * @complexity O(n) where n is the number of values inside left AND right
+ */
+bool sortedset_equals(const SortedSet *left, const SortedSet *right);
+
+/**
+ * @brief Intersect two strictly ascending integer arrays, using AVX2 kernels when the CPU supports them
+ * @param left Left sorted integers
+ * @param left_size Number of integers inside left
+ * @param right Right sorted integers
+ * @param right_size Number of integers inside right
+ * @param out Output array, it MUST be able to hold the smallest operand size
+ * @return The number of integers written into out
+ * @complexity O(m + n), O(m + n / 8) when one operand is much smaller than the other
+ */
+int sortedset_intersectInt(const int *left, int left_size, const int *right, int right_size, int *out);
+
 #ifdef __cplusplus
 /**
  * @brief Inline function to get the current Set size
@@ -138,19 +328,31 @@ static inline int set_size(const Set *set) {
 } ;
 
 /**
- * @brief Inline function to destroy a set
- * @param set Set to destroy
- * @complexity O(n) where n is the number of hashtable inside the given Set to destroy
+ * @brief Inline function that returns a random element from the set
  */
-static inline void set_destroy(Set *set) {
-    list_destroy(set);
+static inline LinkedElement *set_getRandom(Set *set) {
+    return list_getRandom(set);
 }
 
 /**
- * @brief Inline function that returns a random element from the set
+ * @brief Inline function to get the current sorted set size
+ * @param set Reference sorted set to get the size
+ * @return The size of the current sorted set
+ * @complexity O(1)
  */
-static inline LinkedElement *set_getRandom(Set *set) {
-    return list_getRandom(set);
+static inline int sortedset_size(const SortedSet *set) {
+    return set->size;
+}
+
+/**
+ * @brief Inline function that evaluates the value at the given rank of a sorted set
+ * @param set Reference sorted set
+ * @param index Rank of the value, from 0 to the set size excluded
+ * @return The value at the given rank
+ * @complexity O(1)
+ */
+static inline void *sortedset_value(const SortedSet *set, int index) {
+    return set->values[index];
 }
 #else
 /**
@@ -162,16 +364,26 @@ static inline LinkedElement *set_getRandom(Set *set) {
 #define set_size(set) ((set)->size)
 
 /**
- * @brief Macro that evaluates destruction of a given set
- * @param set Set to destroy
- * @complexity O(n) where n is the number of hashtable inside the given Set to destroy
+ * @brief Macro that evaluates a random element from the set and returns it
  */
-#define set_destroy(set) list_destroy
+#define set_get_random(set) list_getRandom
 
 /**
- * @brief Macro that evaluates a random element from the set and returns it
+ * @brief Macro that evaluates the size of a given sorted set
+ * @param set Reference sorted set to get the size
+ * @return The size of the current sorted set
+ * @complexity O(1)
  */
-#define set_get_random(set) list_getRandom
+#define sortedset_size(set) ((set)->size)
+
+/**
+ * @brief Macro that evaluates the value at the given rank of a sorted set
+ * @param set Reference sorted set
+ * @param index Rank of the value, from 0 to the set size excluded
+ * @return The value at the given rank
+ * @complexity O(1)
+ */
+#define sortedset_value(set, index) ((set)->values[(index)])
 
 #endif
 
@@ -0,0 +1,45 @@
+/**
+ * @file simd_utils.h
+ * @brief This file contains the API for SIMD runtime dispatch utility methods
+ * @author Maxime Loukhal
+ * @date 18/10/2026
+ */
+#ifndef COLLECTIONS_COMMONS_SIMD_UTILS_H
+#define COLLECTIONS_COMMONS_SIMD_UTILS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+#include <cstdbool>
+#else
+#include <stdbool.h>
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+/**
+ * @brief Defined to 1 when AVX2 kernels can be compiled, they are only called if the running CPU supports AVX2
+ */
+#define COLLECTIONS_SIMD_AVX2 1
+/**
+ * @brief Function attribute compiling a single function for AVX2 without changing the library build flags
+ */
+#define COLLECTIONS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define COLLECTIONS_SIMD_AVX2 0
+#define COLLECTIONS_TARGET_AVX2
+#endif
+
+/**
+ * @brief Determine if the running CPU supports AVX2 instructions, the result is computed once
+ * @return true if AVX2 kernels can be used, false otherwise
+ * @complexity O(1)
+ */
+bool simd_hasAvx2(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //COLLECTIONS_COMMONS_SIMD_UTILS_H
@@ -14,16 +14,19 @@ extern "C" {
 #ifdef __cplusplus
 #include <cstdlib>
 #include <cstring>
+#include <cstdint>
 #include <cstdbool>
 #else
 
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 
 #endif
 
 #include "arrays_utils.h"
+#include "parallel_utils.h"
 
 /**
  * @brief Determine if a generic array is sorted or not
@@ -36,6 +39,375 @@ extern "C" {
 bool
 array_is_sort(void *value, int element_count, size_t element_size, int (*compare)(const void *key1, const void *key2));
 
+/**
+ * @brief Sort a generic array with the pattern-defeating quicksort, the order of equal elements isn't kept
+ * @details Small partitions are sorted by insertion, sorted and reversed inputs are detected and a heapsort takes
+ * over when the partitions keep being unbalanced. Elements of 4, 8 and 16 bytes are swapped through registers
+ * @param base Array to sort
+ * @param count Number of elements inside the array
+ * @param size Size of an element in bytes
+ * @param compare User compare function
+ * @complexity O(n log(n)) where n is the number of elements, O(n) for sorted inputs
+ */
+void array_sort(void *base, int count, size_t size, int (*compare)(const void *key1, const void *key2));
+
+/**
+ * @brief Reorder a generic array so the element at the nth position is the one a full sort would put there
+ * @details Introselect, the range holding the nth position is partitioned as in array_sort until it is small enough
+ * to be sorted by insertion, a heapsort of the range takes over when the partitions keep being unbalanced. Elements
+ * before the nth position don't go after it, elements after it don't go before it
+ * @param base Array to reorder
+ * @param count Number of elements inside the array
+ * @param size Size of an element in bytes
+ * @param nth Position of the element to select, from 0 to count - 1
+ * @param compare User compare function
+ * @complexity O(n) on average where n is the number of elements, O(n log(n)) in the worst case
+ */
+void array_nthElement(void *base, int count, size_t size, int nth,
+                      int (*compare)(const void *key1, const void *key2));
+
+/**
+ * @brief Sort the k lowest elements of a generic array at its beginning, the other elements are left in any order
+ * @param base Array to partially sort
+ * @param count Number of elements inside the array
+ * @param size Size of an element in bytes
+ * @param k Number of elements to sort, the whole array is sorted if it is greater than count
+ * @param compare User compare function
+ * @complexity O(n + k log(k)) on average where n is the number of elements
+ */
+void array_partialSort(void *base, int count, size_t size, int k, int (*compare)(const void *key1, const void *key2));
+
+/**
+ * @brief Number of elements up to which the typed sorts use a single sorting network
+ */
+#define SORT_NETWORK_MAX 64
+
+/**
+ * @brief Sort an array of int32 in ascending order
+ * @details Introsort whose ranges up to SORT_NETWORK_MAX elements are sorted by AVX2 bitonic sorting networks when
+ * the running CPU supports them, by insertion otherwise. The order of equal elements is irrelevant for integers
+ * @param values Integers to sort
+ * @param count Number of integers
+ * @complexity O(n log(n)) where n is the number of integers
+ */
+void array_sortInt32(int32_t *values, int count);
+
+/**
+ * @brief Sort an array of int64 in ascending order, with the same introsort and sorting networks as array_sortInt32
+ * @param values Integers to sort
+ * @param count Number of integers
+ * @complexity O(n log(n)) where n is the number of integers
+ */
+void array_sortInt64(int64_t *values, int count);
+
+/**
+ * @brief Sort an array of floats in ascending order, their bits are sorted as int32 by array_sortInt32
+ * @details The order is total: -0.0 goes before 0.0, the NaN with a sign bit go before -inf and the other ones
+ * after inf
+ * @param values Floats to sort
+ * @param count Number of floats
+ * @complexity O(n log(n)) where n is the number of floats
+ */
+void array_sortFloat(float *values, int count);
+
+/**
+ * @brief Number of elements the scratch buffer of a stable sort of count elements must hold
+ */
+#define SORT_STABLE_SCRATCH(count) ((count) / 2)
+
+/**
+ * @brief Sort a generic array keeping the order of equal elements
+ * @details Natural runs are detected and extended by binary insertion, then merged with galloping so partially
+ * sorted inputs cost close to O(n). Repeated sorts can share a scratch buffer to allocate nothing
+ * @param base Array to sort
+ * @param count Number of elements inside the array
+ * @param size Size of an element in bytes
+ * @param compare User compare function
+ * @param scratch Buffer of SORT_STABLE_SCRATCH(count) elements, NULL to allocate it for the call
+ * @return true if the array was sorted, false if the scratch buffer allocation failed
+ * @complexity O(n log(n)) where n is the number of elements
+ */
+bool array_stableSort(void *base, int count, size_t size, int (*compare)(const void *key1, const void *key2),
+                      void *scratch);
+
+/**
+ * @brief Sort an array of values, such as the *_toArray arrays, keeping the order of equal values
+ * @param values Values to sort
+ * @param count Number of values
+ * @param compare User compare function of the values
+ * @param scratch Buffer of SORT_STABLE_SCRATCH(count) values, NULL to allocate it for the call
+ * @return true if the values were sorted, false if the scratch buffer allocation failed
+ * @complexity O(n log(n)) where n is the number of values
+ */
+bool array_stableSortValues(void **values, int count, int (*compare)(const void *key1, const void *key2),
+                            void **scratch);
+
+/**
+ * @brief Sort a generic array on the threads of the given pool, the order of equal elements isn't kept
+ * @details Parallel merge sort, the leaves are sorted with array_sort and merged by recursive splits so every
+ * thread takes part in the merges. Small arrays, single thread pools and a failed scratch allocation fall back to
+ * array_sort. It MUST NOT be called from a task of the same pool
+ * @param pool Thread pool running the sort, NULL to sort sequentially
+ * @param base Array to sort
+ * @param count Number of elements inside the array
+ * @param size Size of an element in bytes
+ * @param compare User compare function, called concurrently
+ * @complexity O(n log(n) / t + log(n)^3) where n is the number of elements and t the number of threads
+ */
+void array_parallelSort(ParallelPool *pool, void *base, int count, size_t size,
+                        int (*compare)(const void *key1, const void *key2));
+
+/**
+ * @brief Sort a generic array by the bytes of its unsigned integer keys, from the lowest to the highest one
+ * @details LSD radix sort, the order of equal keys is kept and the passes over a byte shared by every key are
+ * skipped. Signed keys are sorted by flipping their sign bit in the key function
+ * @param base Array to sort
+ * @param count Number of elements inside the array
+ * @param size Size of an element in bytes
+ * @param key User key function, NULL if the elements are 4 or 8 bytes unsigned integers
+ * @param keyBits Number of significant bits of the keys, up to 64
+ * @param scratch Buffer of count elements, NULL to allocate it for the call
+ * @param pool Thread pool counting the bytes of large arrays, NULL to count them sequentially
+ * @return true if the array was sorted, false if the arguments are invalid or an allocation failed
+ * @complexity O(n * b / 8) where n is the number of elements and b the number of key bits
+ */
+bool array_radixSort(void *base, int count, size_t size, uint64_t (*key)(const void *element), int keyBits,
+                     void *scratch, ParallelPool *pool);
+
+/**
+ * @brief Sort an array of null-terminated strings in the strcmp order of their bytes
+ * @details MSD radix sort permuting the strings in place bucket by bucket (American flag sort), small buckets are
+ * sorted by insertion
+ * @param strings Strings to sort
+ * @param count Number of strings
+ * @param pool Thread pool counting the first bytes of large arrays, NULL to count them sequentially
+ * @return true if the strings were sorted, false if the bucket stack allocation failed
+ * @complexity O(n * k) where n is the number of strings and k the length of their distinguishing prefixes
+ */
+bool array_stringSort(char **strings, int count, ParallelPool *pool);
+
+/**
+ * @brief Data structure definition for a tournament tree merging k sorted runs, each internal node keeps the run
+ * that lost the match played there so a new element replays a single leaf-to-root path
+ * @details Runs are pulled through a next handle, equal elements come out in the run order so the merge is stable
+ */
+typedef struct LoserTree {
+    /**
+     * @brief Number of merged runs
+     */
+    int k;
+    /**
+     * @brief User compare handle of the elements
+     * @param key1 Key 1 to be compared
+     * @param key2 Key 2 to be compared
+     * @return A negative value if key1 goes before key2, 0 if equal, a positive value otherwise
+     */
+    int (*compare)(const void *key1, const void *key2);
+    /**
+     * @brief User handle pulling the next element of a run
+     * @param run Run to pull the element from
+     * @return The next element of the run, NULL when the run is exhausted
+     */
+    const void *(*next)(void *run);
+    /**
+     * @brief Merged runs
+     */
+    void **runs;
+    /**
+     * @brief Current element of each run, NULL for an exhausted run
+     */
+    const void **heads;
+    /**
+     * @brief Loser run of each internal node, the first slot holds the overall winner
+     */
+    int *losers;
+} LoserTree;
+
+/**
+ * @brief Creates a loser tree over k sorted runs and pulls their first elements
+ * @param tree Loser tree to be created
+ * @param runs Runs to merge, the array is copied but the runs MUST stay accessible until the tree is destroyed
+ * @param k Number of runs
+ * @param next User function pulling the next element of a run, the element MUST stay valid until the next pull
+ * @param compare User compare function of the elements
+ * @return true if the tree was created, false if k is lower than 1 or the allocation failed
+ * @complexity O(k)
+ */
+bool losertree_create(LoserTree *tree, void **runs, int k, const void *(*next)(void *run),
+                      int (*compare)(const void *key1, const void *key2));
+
+/**
+ * @brief Destroys a loser tree, the runs are left to the caller
+ * @param tree Loser tree to be destroyed
+ * @complexity O(1)
+ */
+void losertree_destroy(LoserTree *tree);
+
+/**
+ * @brief Replace the current winner with the next element of its run and replay its path
+ * @param tree Loser tree to advance
+ * @complexity O(log(k)) compares
+ */
+void losertree_advance(LoserTree *tree);
+
+/**
+ * @brief Stream the remaining merged elements to an output handle
+ * @param tree Loser tree to drain
+ * @param output User handle called on each element in the merged order, it returns false to stop the merge
+ * @param data User data passed to the output handle
+ * @return true if every element was output, false if the output handle stopped the merge
+ * @complexity O(n log(k)) where n is the number of remaining elements
+ */
+bool losertree_merge(LoserTree *tree, bool (*output)(const void *element, void *data), void *data);
+
+/**
+ * @brief Merge k sorted array views with a loser tree, streaming the merged elements to an output handle
+ * @param runs Sorted views to merge
+ * @param k Number of views
+ * @param compare User compare function of the elements
+ * @param output User handle called on each element in the merged order, it returns false to stop the merge
+ * @param data User data passed to the output handle
+ * @return true if every element was output, false if the allocation failed or the output handle stopped the merge
+ * @complexity O(n log(k)) where n is the total number of elements
+ */
+bool array_mergeRuns(const ArrayView *runs, int k, int (*compare)(const void *key1, const void *key2),
+                     bool (*output)(const void *element, void *data), void *data);
+
+/**
+ * @brief Data structure definition for a streaming accumulator of the k lowest elements pushed into it
+ * @details The kept elements are copied into a bounded max heap, an element going after all of them costs a single
+ * compare so streams much larger than k are ranked in O(n) on average
+ */
+typedef struct TopK {
+    /**
+     * @brief Number of kept elements
+     */
+    int size;
+    /**
+     * @brief Maximum number of kept elements
+     */
+    int k;
+    /**
+     * @brief Size of an element in bytes
+     */
+    size_t elementSize;
+    /**
+     * @brief User compare handle of the elements
+     * @param key1 Key 1 to be compared
+     * @param key2 Key 2 to be compared
+     * @return A negative value if key1 goes before key2, 0 if equal, a positive value otherwise
+     */
+    int (*compare)(const void *key1, const void *key2);
+    /**
+     * @brief Kept elements in max heap order, the greatest one first
+     */
+    char *elements;
+} TopK;
+
+/**
+ * @brief Creates an empty top-k accumulator
+ * @param topk Accumulator to be created
+ * @param k Maximum number of kept elements, at least 1
+ * @param size Size of an element in bytes
+ * @param compare User compare function
+ * @return true if the accumulator was created, false if the arguments are invalid or the allocation failed
+ * @complexity O(1)
+ */
+bool topk_create(TopK *topk, int k, size_t size, int (*compare)(const void *key1, const void *key2));
+
+/**
+ * @brief Destroys a top-k accumulator, the kept elements are copies so nothing is destroyed with them
+ * @param topk Accumulator to be destroyed
+ * @complexity O(1)
+ */
+void topk_destroy(TopK *topk);
+
+/**
+ * @brief Push an element into the accumulator, it is copied if it belongs to the k lowest elements pushed so far
+ * @details An element equal to the greatest kept one is dropped
+ * @param topk Accumulator to push the element in
+ * @param element Element to push
+ * @return true if the element was kept, false otherwise
+ * @complexity O(log(k)) when the element is kept, O(1) otherwise
+ */
+bool topk_push(TopK *topk, const void *element);
+
+/**
+ * @brief Push every element of a generic array into the accumulator
+ * @param topk Accumulator to push the elements in
+ * @param base Array of elements of the accumulator element size
+ * @param count Number of elements inside the array
+ * @complexity O(n log(k)) in the worst case where n is the number of elements, O(n) for random inputs
+ */
+void topk_pushArray(TopK *topk, const void *base, int count);
+
+/**
+ * @brief Copy the kept elements from the lowest to the greatest, the accumulator keeps them
+ * @param topk Accumulator to read
+ * @param out Buffer of at least topk_size(topk) elements receiving the sorted elements
+ * @return The number of elements copied
+ * @complexity O(k log(k))
+ */
+int topk_result(const TopK *topk, void *out);
+
+#ifdef __cplusplus
+/**
+ * @brief Inline function that evaluates the number of elements kept by the given accumulator
+ * @return Current number of kept elements
+ */
+static inline int topk_size(const TopK *topk) {
+    return topk->size;
+}
+
+/**
+ * @brief Inline function that peeks the greatest kept element, the one the next kept element replaces
+ * @return The greatest kept element, NULL if fewer than k elements were kept
+ */
+static inline void *topk_bound(const TopK *topk) {
+    return topk->size < topk->k ? nullptr : topk->elements;
+}
+
+/**
+ * @brief Inline function that peeks the lowest current element of the runs of a loser tree
+ * @return The next merged element, NULL once every run is exhausted
+ */
+static inline const void *losertree_peek(const LoserTree *tree) {
+    return tree->heads[tree->losers[0]];
+}
+
+/**
+ * @brief Inline function that evaluates the run of the lowest current element of a loser tree
+ * @return The index of the run holding the next merged element
+ */
+static inline int losertree_run(const LoserTree *tree) {
+    return tree->losers[0];
+}
+#else
+/**
+ * @brief Macro that evaluates the number of elements kept by the given accumulator
+ * @return Current number of kept elements
+ */
+#define topk_size(topk) ((topk)->size)
+
+/**
+ * @brief Macro that peeks the greatest kept element, the one the next kept element replaces
+ * @return The greatest kept element, NULL if fewer than k elements were kept
+ */
+#define topk_bound(topk) ((topk)->size < (topk)->k ? NULL : (void *) (topk)->elements)
+
+/**
+ * @brief Macro that peeks the lowest current element of the runs of a loser tree
+ * @return The next merged element, NULL once every run is exhausted
+ */
+#define losertree_peek(tree) ((tree)->heads[(tree)->losers[0]])
+
+/**
+ * @brief Macro that evaluates the run of the lowest current element of a loser tree
+ * @return The index of the run holding the next merged element
+ */
+#define losertree_run(tree) ((tree)->losers[0])
+#endif
+
 #ifdef __cplusplus
 }
 #endif
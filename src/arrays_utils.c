@@ -0,0 +1,143 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#include <string.h>
+#include "arrays_utils.h"
+
+void arrayview_create(ArrayView *view, void *base, int count, ptrdiff_t stride) {
+    view->base = base;
+    view->count = count;
+    view->stride = stride;
+}
+
+bool arrayview_slice(const ArrayView *view, int start, int stop, ArrayView *slice) {
+    if (start < 0 || stop < start || stop > view->count) return false;
+    arrayview_create(slice, arrayview_at(view, start), stop - start, view->stride);
+    return true;
+}
+
+bool arrayview_step(const ArrayView *view, int step, ArrayView *result) {
+    // Magnitude of the step, computed unsigned so INT_MIN doesn't overflow
+    unsigned int distance = step < 0 ? 0u - (unsigned int) step : (unsigned int) step;
+    int count;
+
+    if (step == 0) return false;
+    if (view->count == 0) {
+        arrayview_create(result, view->base, 0, view->stride * step);
+        return true;
+    }
+
+    // A negative step starts from the last element, both walks keep the first element they start from
+    count = (int) ((unsigned int) (view->count - 1) / distance) + 1;
+    arrayview_create(result, step > 0 ? view->base : arrayview_at(view, view->count - 1), count,
+                     view->stride * step);
+    return true;
+}
+
+int arrayview_split(const ArrayView *view, int parts, ArrayView *out) {
+    int count = parts < view->count ? parts : view->count;
+    int start = 0;
+    int length;
+    int i;
+
+    // The first count % parts views get the remaining elements
+    for (i = 0; i < count; i++) {
+        length = view->count / count + (i < view->count % count ? 1 : 0);
+        arrayview_slice(view, start, start + length, &out[i]);
+        start += length;
+    }
+    return count < 0 ? 0 : count;
+}
+
+bool array_split(void ***out, int *out_size, void *in, size_t size, int start_index, int stop_index) {
+    void **result;
+    char *element = (char *) in + (size_t) start_index * size;
+    int i;
+
+    if (start_index < 0 || stop_index < start_index) return false;
+    if (stop_index == start_index) return true;
+    if ((result = (void **) realloc(*out, (size_t) (*out_size + stop_index - start_index) * sizeof(void *))) == NULL)
+        return false;
+
+    // Only addresses are stored, the elements stay in the input array
+    for (i = start_index; i < stop_index; i++, element += size) result[(*out_size)++] = element;
+    *out = result;
+    return true;
+}
+
+LinkedList *array_toList(void **array, int count) {
+    LinkedList *result;
+    int i;
+
+    if (count < 0 || (array == NULL && count > 0)) return NULL;
+    if ((result = (LinkedList *) malloc(sizeof(LinkedList))) == NULL) return NULL;
+    list_create(result, NULL);
+
+    // Values are added after the tail to keep the array order
+    for (i = 0; i < count; i++) {
+        if (!list_add(result, list_last(result), array[i])) {
+            list_destroy(result);
+            free(result);
+            return NULL;
+        }
+    }
+    return result;
+}
+
+DLinkedList *array_toDList(void **array, int count) {
+    DLinkedList *result;
+    int i;
+
+    if (count < 0 || (array == NULL && count > 0)) return NULL;
+    if ((result = (DLinkedList *) malloc(sizeof(DLinkedList))) == NULL) return NULL;
+    dlist_create(result, NULL);
+    for (i = 0; i < count; i++) {
+        if (!dlist_add(result, dlist_last(result), array[i])) {
+            dlist_destroy(result);
+            free(result);
+            return NULL;
+        }
+    }
+    return result;
+}
+
+CLinkedList *array_toCList(void **array, int count) {
+    CLinkedList *result;
+    CLinkedElement *last = NULL;
+    int i;
+
+    if (count < 0 || (array == NULL && count > 0)) return NULL;
+    if ((result = (CLinkedList *) malloc(sizeof(CLinkedList))) == NULL) return NULL;
+    clist_create(result, NULL);
+
+    // The head stays the first value, each value is added after the previous one
+    for (i = 0; i < count; i++) {
+        if (!clist_add(result, last, array[i])) {
+            clist_destroy(result);
+            free(result);
+            return NULL;
+        }
+        last = last == NULL ? clist_first(result) : clist_next(last);
+    }
+    return result;
+}
+
+Set *array_toSet(void **array, int count, bool(*equals)(const void *value1, const void *value2)) {
+    Set *result;
+    int i;
+
+    if (count < 0 || (array == NULL && count > 0)) return NULL;
+    if ((result = (Set *) malloc(sizeof(Set))) == NULL) return NULL;
+    set_create(result, equals, NULL);
+
+    // A value that isn't added nor already a member means the allocation failed
+    for (i = 0; i < count; i++) {
+        if (!set_add(result, array[i]) && !set_isMember(result, array[i])) {
+            set_destroy(result);
+            free(result);
+            return NULL;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,255 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#include "bistree.h"
+
+/**
+ * @brief Binary search tree node allocated with its AVL data in a single block
+ */
+typedef struct AvlTreeNode {
+    /**
+     * @brief Binary tree node, its value points to the AVL data
+     */
+    BinaryTreeNode node;
+    /**
+     * @brief AVL data of the node
+     */
+    AvlNode avl;
+} AvlTreeNode;
+
+/**
+ * @brief Private method to evaluate the height of a possibly NULL subtree
+ */
+static int bistree_height(const BinaryTreeNode *node) {
+    return node == NULL ? 0 : ((const AvlNode *) node->value)->height;
+}
+
+/**
+ * @brief Private method to evaluate the number of nodes of a possibly NULL subtree
+ */
+static int bistree_size(const BinaryTreeNode *node) {
+    return node == NULL ? 0 : ((const AvlNode *) node->value)->size;
+}
+
+/**
+ * @brief Private method to compute the height and the size of a node from its children
+ */
+static void bistree_update(BinaryTreeNode *node) {
+    int left = bistree_height(node->left);
+    int right = bistree_height(node->right);
+    AvlNode *avl = (AvlNode *) node->value;
+
+    avl->height = (left > right ? left : right) + 1;
+    avl->size = bistree_size(node->left) + bistree_size(node->right) + 1;
+}
+
+/**
+ * @brief Private method to rotate the subtree at the given position with its right child
+ */
+static void bistree_rotateLeft(BinaryTreeNode **position) {
+    BinaryTreeNode *node = *position;
+    BinaryTreeNode *pivot = node->right;
+
+    node->right = pivot->left;
+    pivot->left = node;
+    bistree_update(node);
+    bistree_update(pivot);
+    *position = pivot;
+}
+
+/**
+ * @brief Private method to rotate the subtree at the given position with its left child
+ */
+static void bistree_rotateRight(BinaryTreeNode **position) {
+    BinaryTreeNode *node = *position;
+    BinaryTreeNode *pivot = node->left;
+
+    node->left = pivot->right;
+    pivot->right = node;
+    bistree_update(node);
+    bistree_update(pivot);
+    *position = pivot;
+}
+
+/**
+ * @brief Private method to restore the AVL property of the subtree at the given position after an update of a child
+ */
+static void bistree_balance(BinaryTreeNode **position) {
+    BinaryTreeNode *node = *position;
+    int factor = bistree_height(node->left) - bistree_height(node->right);
+
+    if (factor > 1) {
+        // Left-right case needs a first rotation of the left child
+        if (bistree_height(node->left->left) < bistree_height(node->left->right)) bistree_rotateLeft(&node->left);
+        bistree_rotateRight(position);
+    } else if (factor < -1) {
+        // Right-left case needs a first rotation of the right child
+        if (bistree_height(node->right->right) < bistree_height(node->right->left)) bistree_rotateRight(&node->right);
+        bistree_rotateLeft(position);
+    } else {
+        bistree_update(node);
+    }
+}
+
+/**
+ * @brief Private method to insert a value inside the subtree at the given position
+ * @return 1 if the value was inserted, 0 if an equal value is already present, -1 if the allocation failed
+ */
+static int bistree_insertBranch(BinarySearchTree *tree, BinaryTreeNode **position, const void *value) {
+    AvlTreeNode *new_node;
+    int order;
+    int status;
+
+    if (*position == NULL) {
+        if ((new_node = (AvlTreeNode *) malloc(sizeof(AvlTreeNode))) == NULL) return -1;
+        new_node->avl.value = (void *) value;
+        new_node->avl.height = 1;
+        new_node->avl.size = 1;
+        new_node->node.value = &new_node->avl;
+        new_node->node.left = NULL;
+        new_node->node.right = NULL;
+        new_node->node.pooled = false;
+        *position = &new_node->node;
+        return 1;
+    }
+
+    if ((order = tree->compare(value, bistree_value(*position))) == 0) return 0;
+    status = bistree_insertBranch(tree, order < 0 ? &(*position)->left : &(*position)->right, value);
+    if (status == 1) bistree_balance(position);
+    return status;
+}
+
+/**
+ * @brief Private method to detach the node of the lowest value of the subtree at the given position
+ * @return The detached node
+ */
+static BinaryTreeNode *bistree_detachMinimum(BinaryTreeNode **position) {
+    BinaryTreeNode *minimum;
+
+    if ((*position)->left == NULL) {
+        minimum = *position;
+        *position = minimum->right;
+        return minimum;
+    }
+    minimum = bistree_detachMinimum(&(*position)->left);
+    bistree_balance(position);
+    return minimum;
+}
+
+/**
+ * @brief Private method to remove a value from the subtree at the given position
+ * @return true if the value was removed, false otherwise
+ */
+static bool bistree_removeBranch(BinarySearchTree *tree, BinaryTreeNode **position, void **value) {
+    BinaryTreeNode *node = *position;
+    BinaryTreeNode *successor;
+    int order;
+
+    if (node == NULL) return false;
+
+    if ((order = tree->compare(*value, bistree_value(node))) != 0) {
+        if (!bistree_removeBranch(tree, order < 0 ? &node->left : &node->right, value)) return false;
+        bistree_balance(position);
+        return true;
+    }
+
+    *value = bistree_value(node);
+    if (node->left == NULL || node->right == NULL) {
+        *position = node->left != NULL ? node->left : node->right;
+    } else {
+        // The successor takes the place of the removed node
+        successor = bistree_detachMinimum(&node->right);
+        successor->left = node->left;
+        successor->right = node->right;
+        *position = successor;
+        bistree_balance(position);
+    }
+    free(node);
+    return true;
+}
+
+/**
+ * @brief Private method to destroy the nodes of a subtree
+ */
+static void bistree_destroyBranch(BinarySearchTree *tree, BinaryTreeNode *node) {
+    if (node == NULL) return;
+    bistree_destroyBranch(tree, node->left);
+    bistree_destroyBranch(tree, node->right);
+    if (tree->destroy != NULL) tree->destroy(bistree_value(node));
+    free(node);
+}
+
+void bistree_create(BinarySearchTree *tree, int (*compare)(const void *key1, const void *key2),
+                    void (*destroy)(void *value)) {
+    bitree_create(tree, destroy);
+    tree->equals = NULL;
+    tree->compare = compare;
+}
+
+void bistree_destroy(BinarySearchTree *tree) {
+    bistree_destroyBranch(tree, tree->root);
+    tree->root = NULL;
+    tree->size = 0;
+}
+
+bool bistree_insert(BinarySearchTree *tree, const void *value) {
+    if (bistree_insertBranch(tree, &tree->root, value) != 1) return false;
+    tree->size++;
+    return true;
+}
+
+bool bistree_remove(BinarySearchTree *tree, void **value) {
+    if (!bistree_removeBranch(tree, &tree->root, value)) return false;
+    tree->size--;
+    return true;
+}
+
+bool bistree_lookup(const BinarySearchTree *tree, void **value) {
+    BinaryTreeNode *node = tree->root;
+    int order;
+
+    while (node != NULL) {
+        if ((order = tree->compare(*value, bistree_value(node))) == 0) {
+            *value = bistree_value(node);
+            return true;
+        }
+        node = order < 0 ? node->left : node->right;
+    }
+    return false;
+}
+
+int bistree_rank(const BinarySearchTree *tree, const void *value) {
+    BinaryTreeNode *node = tree->root;
+    int rank = 0;
+
+    while (node != NULL) {
+        if (tree->compare(value, bistree_value(node)) <= 0) {
+            node = node->left;
+        } else {
+            rank += bistree_size(node->left) + 1;
+            node = node->right;
+        }
+    }
+    return rank;
+}
+
+bool bistree_select(const BinarySearchTree *tree, int rank, void **value) {
+    BinaryTreeNode *node = tree->root;
+    int left;
+
+    if (rank < 0 || rank >= tree->size) return false;
+    while (node != NULL) {
+        left = bistree_size(node->left);
+        if (rank < left) {
+            node = node->left;
+        } else if (rank > left) {
+            rank -= left + 1;
+            node = node->right;
+        } else {
+            *value = bistree_value(node);
+            return true;
+        }
+    }
+    return false;
+}
@@ -2,55 +2,399 @@
 // Created by maxim on 8/03/2024.
 //
 #include <memory.h>
-#include <math.h>
 #include "bitree.h"
-#include "queue.h"
 
-int bitree_branchNodeCount( BinaryTreeNode* root) {
-    if (root == NULL)
-        return 0;
-    int count = 1;
-    count += bitree_branchNodeCount(root->left);
-    count += bitree_branchNodeCount(root->right);
+/**
+ * @brief Number of frames of a traversal stack kept on the call stack before switching to the heap
+ */
+#define BITREE_STACK_INLINE 64
+
+/**
+ * @brief State of a post-order frame whose children weren't visited yet
+ */
+#define BITREE_FRAME_NEW (-2)
+
+/**
+ * @brief State of a post-order frame whose left child is being visited
+ */
+#define BITREE_FRAME_LEFT (-1)
+
+/**
+ * @brief Number of tree levels forked by the parallel walks on top of log2 of the number of threads
+ */
+#define BITREE_PARALLEL_LEVELS 4
+
+/**
+ * @brief Frame of an explicit traversal stack
+ */
+typedef struct BinaryTreeFrame {
+    /**
+     * @brief Visited node
+     */
+    BinaryTreeNode *node;
+    /**
+     * @brief Node of the other tree visited together with the node
+     */
+    BinaryTreeNode *other;
+    /**
+     * @brief Traversal state of the frame, a depth or a child height
+     */
+    int state;
+} BinaryTreeFrame;
+
+/**
+ * @brief Explicit traversal stack, the first frames live on the call stack
+ */
+typedef struct BinaryTreeStack {
+    /**
+     * @brief Current frames
+     */
+    BinaryTreeFrame *frames;
+    /**
+     * @brief Number of frames
+     */
+    int size;
+    /**
+     * @brief Number of allocated frames
+     */
+    int capacity;
+    /**
+     * @brief Frames used until the stack outgrows them
+     */
+    BinaryTreeFrame inline_frames[BITREE_STACK_INLINE];
+} BinaryTreeStack;
+
+/**
+ * @brief Private method to create an empty traversal stack
+ */
+static void bitree_stackCreate(BinaryTreeStack *stack) {
+    stack->frames = stack->inline_frames;
+    stack->size = 0;
+    stack->capacity = BITREE_STACK_INLINE;
+}
+
+/**
+ * @brief Private method to release a traversal stack
+ */
+static void bitree_stackDestroy(BinaryTreeStack *stack) {
+    if (stack->frames != stack->inline_frames) free(stack->frames);
+}
+
+/**
+ * @brief Private method to push a frame, the stack moves to the heap when the inline frames are full
+ * @return true if the frame was pushed, false if the allocation failed
+ */
+static bool bitree_stackPush(BinaryTreeStack *stack, BinaryTreeNode *node, BinaryTreeNode *other, int state) {
+    BinaryTreeFrame *frames;
+
+    if (stack->size == stack->capacity) {
+        if (stack->frames == stack->inline_frames) {
+            if ((frames = (BinaryTreeFrame *) malloc(2 * stack->capacity * sizeof(BinaryTreeFrame))) == NULL)
+                return false;
+            memcpy(frames, stack->inline_frames, stack->size * sizeof(BinaryTreeFrame));
+        } else if ((frames = (BinaryTreeFrame *) realloc(stack->frames,
+                                                         2 * stack->capacity * sizeof(BinaryTreeFrame))) == NULL) {
+            return false;
+        }
+        stack->frames = frames;
+        stack->capacity *= 2;
+    }
+    stack->frames[stack->size].node = node;
+    stack->frames[stack->size].other = other;
+    stack->frames[stack->size].state = state;
+    stack->size++;
+    return true;
+}
+
+/**
+ * @brief Block of nodes allocated at once by the tree builders
+ */
+typedef struct BinaryTreeBlock {
+    /**
+     * @brief Next block of the tree
+     */
+    struct BinaryTreeBlock *next;
+    /**
+     * @brief Number of nodes of the block
+     */
+    int count;
+    /**
+     * @brief Nodes of the block
+     */
+    BinaryTreeNode nodes[];
+} BinaryTreeBlock;
+
+/**
+ * @brief Private method to release a node, the pooled nodes of a block are released with their block
+ */
+static void bitree_freeNode(BinaryTreeNode *node) {
+    if (!node->pooled) free(node);
+}
+
+/**
+ * @brief Private method to destroy a branch without recursion, left children are rotated up until the branch is a
+ * right chain that is freed while walking it
+ * @return The number of destroyed nodes
+ */
+static int bitree_destroyBranch(BinaryTree *tree, BinaryTreeNode *node) {
+    BinaryTreeNode *next;
+    int count = 0;
+
+    while (node != NULL) {
+        if (node->left != NULL) {
+            // Right rotation, the left child becomes the current node
+            next = node->left;
+            node->left = next->right;
+            next->right = node;
+        } else {
+            next = node->right;
+            if (tree->destroy != NULL) tree->destroy(node->value);
+            bitree_freeNode(node);
+            count++;
+        }
+        node = next;
+    }
+    return count;
+}
+
+/**
+ * @brief Private method to reverse the right links of the chain going from a node to one of its right descendants
+ */
+static void bitree_reverseChain(BinaryTreeNode *from, BinaryTreeNode *to) {
+    BinaryTreeNode *current = from;
+    BinaryTreeNode *next = from->right;
+    BinaryTreeNode *after;
+
+    if (from == to) return;
+    while (current != to) {
+        after = next->right;
+        next->right = current;
+        current = next;
+        next = after;
+    }
+}
+
+int bitree_branchNodeCount(BinaryTreeNode *root) {
+    BinaryTreeStack stack;
+    BinaryTreeNode *node;
+    int count = 0;
+
+    if (root == NULL) return 0;
+    bitree_stackCreate(&stack);
+    bitree_stackPush(&stack, root, NULL, 0);
+    while (stack.size > 0) {
+        node = stack.frames[--stack.size].node;
+        count++;
+        if ((node->left != NULL && !bitree_stackPush(&stack, node->left, NULL, 0)) ||
+            (node->right != NULL && !bitree_stackPush(&stack, node->right, NULL, 0))) {
+            count = -1;
+            break;
+        }
+    }
+    bitree_stackDestroy(&stack);
     return count;
 }
 
 bool
 bitree_isMirror(bool (*equals)(const void *value1, const void *value2), BinaryTreeNode *left, BinaryTreeNode *right) {
-    if (left == NULL && right == NULL)
-        return true;
-    if (left == NULL || right == NULL)
-        return false;
-    return (equals(left->value, right->value) && bitree_isMirror(equals, left->right, right->left) &&
-            bitree_isMirror(equals, left->left, right->right));
+    BinaryTreeStack stack;
+    BinaryTreeFrame frame;
+    bool mirror = true;
+
+    bitree_stackCreate(&stack);
+    bitree_stackPush(&stack, left, right, 0);
+    while (mirror && stack.size > 0) {
+        frame = stack.frames[--stack.size];
+        if (frame.node == NULL && frame.other == NULL) continue;
+        if (frame.node == NULL || frame.other == NULL || !equals(frame.node->value, frame.other->value)) {
+            mirror = false;
+            break;
+        }
+        mirror = bitree_stackPush(&stack, frame.node->right, frame.other->left, 0) &&
+                 bitree_stackPush(&stack, frame.node->left, frame.other->right, 0);
+    }
+    bitree_stackDestroy(&stack);
+    return mirror;
 }
 
 BinaryTreeNode *bitree_invertBranch(BinaryTreeNode *branchRoot) {
-    if (branchRoot == NULL)
-        return NULL;
-    BinaryTreeNode *temp = branchRoot->left;
-    branchRoot->left = bitree_invertBranch(branchRoot->right);
-    branchRoot->right = bitree_invertBranch(temp);
+    BinaryTreeStack stack;
+    BinaryTreeNode *node;
+    BinaryTreeNode *temp;
+
+    if (branchRoot == NULL) return NULL;
+    bitree_stackCreate(&stack);
+    bitree_stackPush(&stack, branchRoot, NULL, 0);
+    while (stack.size > 0) {
+        node = stack.frames[--stack.size].node;
+        temp = node->left;
+        node->left = node->right;
+        node->right = temp;
+        if ((node->left != NULL && !bitree_stackPush(&stack, node->left, NULL, 0)) ||
+            (node->right != NULL && !bitree_stackPush(&stack, node->right, NULL, 0))) {
+            branchRoot = NULL;
+            break;
+        }
+    }
+    bitree_stackDestroy(&stack);
     return branchRoot;
 }
 
 bool
 bitree_isSameTree(bool (*equals)(const void *value1, const void *value2), BinaryTreeNode *left, BinaryTreeNode *right) {
-    if (left == NULL && right == NULL)
-        return true;
-    if (left == NULL || right == NULL)
-        return false;
-    if (!equals(left->value, right->value))
-        return false;
-    return bitree_isSameTree(equals, left->left, right->left) && bitree_isSameTree(equals, left->right, right->right);
+    BinaryTreeStack stack;
+    BinaryTreeFrame frame;
+    bool same = true;
+
+    bitree_stackCreate(&stack);
+    bitree_stackPush(&stack, left, right, 0);
+    while (same && stack.size > 0) {
+        frame = stack.frames[--stack.size];
+        if (frame.node == NULL && frame.other == NULL) continue;
+        if (frame.node == NULL || frame.other == NULL || !equals(frame.node->value, frame.other->value)) {
+            same = false;
+            break;
+        }
+        same = bitree_stackPush(&stack, frame.node->right, frame.other->right, 0) &&
+               bitree_stackPush(&stack, frame.node->left, frame.other->left, 0);
+    }
+    bitree_stackDestroy(&stack);
+    return same;
 }
 
 int bitree_maxDepthBranch(BinaryTreeNode *branchRoot) {
-    if (branchRoot == NULL)
-        return 0;
-    int left_depth = bitree_maxDepthBranch(branchRoot->left);
-    int right_depth = bitree_maxDepthBranch(branchRoot->right);
-    return (left_depth > right_depth ? left_depth : right_depth) + 1;
+    BinaryTreeStack stack;
+    BinaryTreeFrame frame;
+    int depth = 0;
+
+    if (branchRoot == NULL) return 0;
+    bitree_stackCreate(&stack);
+    bitree_stackPush(&stack, branchRoot, NULL, 1);
+    while (stack.size > 0) {
+        frame = stack.frames[--stack.size];
+        if (frame.state > depth) depth = frame.state;
+        if ((frame.node->left != NULL && !bitree_stackPush(&stack, frame.node->left, NULL, frame.state + 1)) ||
+            (frame.node->right != NULL && !bitree_stackPush(&stack, frame.node->right, NULL, frame.state + 1))) {
+            depth = -1;
+            break;
+        }
+    }
+    bitree_stackDestroy(&stack);
+    return depth;
+}
+
+/**
+ * @brief Private method to visit a value unless the visitor already stopped the traversal
+ */
+static void bitree_visit(bool (*visit)(void *value, void *data), void *value, void *data, bool *running) {
+    if (*running) *running = visit(value, data);
+}
+
+/**
+ * @brief Private method to visit from bottom to top the right chain going from a node to one of its right descendants
+ */
+static void bitree_visitChain(BinaryTreeNode *from, BinaryTreeNode *to, bool (*visit)(void *value, void *data),
+                              void *data, bool *running) {
+    BinaryTreeNode *node;
+
+    if (!*running) return;
+    bitree_reverseChain(from, to);
+    for (node = to;; node = node->right) {
+        bitree_visit(visit, node->value, data, running);
+        if (node == from) break;
+    }
+    bitree_reverseChain(to, from);
+}
+
+/**
+ * @brief Private method to find the in-order predecessor of a node with a left child, or the node itself if the
+ * predecessor is already threaded to it
+ */
+static BinaryTreeNode *bitree_predecessor(BinaryTreeNode *node) {
+    BinaryTreeNode *predecessor = node->left;
+
+    while (predecessor->right != NULL && predecessor->right != node) predecessor = predecessor->right;
+    return predecessor;
+}
+
+bool bitree_preorder(BinaryTree *tree, bool (*visit)(void *value, void *data), void *data) {
+    BinaryTreeNode *current = tree->root;
+    BinaryTreeNode *predecessor;
+    bool running = true;
+    int threads = 0;
+
+    // Morris traversal, once stopped it only goes on until every thread is removed
+    while (current != NULL && (running || threads > 0)) {
+        if (current->left == NULL) {
+            bitree_visit(visit, current->value, data, &running);
+            current = current->right;
+        } else if ((predecessor = bitree_predecessor(current))->right == NULL) {
+            bitree_visit(visit, current->value, data, &running);
+            predecessor->right = current;
+            threads++;
+            current = current->left;
+        } else {
+            predecessor->right = NULL;
+            threads--;
+            current = current->right;
+        }
+    }
+    return running;
+}
+
+bool bitree_inorder(BinaryTree *tree, bool (*visit)(void *value, void *data), void *data) {
+    BinaryTreeNode *current = tree->root;
+    BinaryTreeNode *predecessor;
+    bool running = true;
+    int threads = 0;
+
+    // Morris traversal, once stopped it only goes on until every thread is removed
+    while (current != NULL && (running || threads > 0)) {
+        if (current->left == NULL) {
+            bitree_visit(visit, current->value, data, &running);
+            current = current->right;
+        } else if ((predecessor = bitree_predecessor(current))->right == NULL) {
+            predecessor->right = current;
+            threads++;
+            current = current->left;
+        } else {
+            predecessor->right = NULL;
+            threads--;
+            bitree_visit(visit, current->value, data, &running);
+            current = current->right;
+        }
+    }
+    return running;
+}
+
+bool bitree_postorder(BinaryTree *tree, bool (*visit)(void *value, void *data), void *data) {
+    BinaryTreeNode dummy;
+    BinaryTreeNode *current = &dummy;
+    BinaryTreeNode *predecessor;
+    bool running = true;
+    int threads = 0;
+
+    // Morris traversal on a dummy parent of the root, the right chain of a left subtree is visited backward when
+    // its thread is removed
+    dummy.value = NULL;
+    dummy.left = tree->root;
+    dummy.right = NULL;
+    while (current != NULL && (running || threads > 0)) {
+        if (current->left == NULL) {
+            current = current->right;
+        } else if ((predecessor = bitree_predecessor(current))->right == NULL) {
+            predecessor->right = current;
+            threads++;
+            current = current->left;
+        } else {
+            // The chain reversal rewrites the thread, it is removed afterward
+            bitree_visitChain(current->left, predecessor, visit, data, &running);
+            predecessor->right = NULL;
+            threads--;
+            current = current->right;
+        }
+    }
+    return running;
 }
 
 int bitree_maxDepth(BinaryTree *tree) {
@@ -70,15 +414,24 @@ bool bitree_invert(BinaryTree *out, BinaryTree *tree) {
 
 void bitree_create(BinaryTree *tree, void(*destroy)(void *value)) {
     tree->size = 0;
+    tree->compare = NULL;
     tree->destroy = destroy;
     tree->root = NULL;
+    tree->blocks = NULL;
 }
 
 void bitree_destroy(BinaryTree *tree) {
+    BinaryTreeBlock *block;
+
     // Remove all the node from the tree
     bitree_removeLeft(tree, NULL);
+    // Release the node blocks of the builders
+    while ((block = tree->blocks) != NULL) {
+        tree->blocks = block->next;
+        free(block);
+    }
     // Erase the memory
-    memset(tree, 0, sizeof(BinaryTreeNode));
+    memset(tree, 0, sizeof(BinaryTree));
 }
 
 bool bitree_addLeft(BinaryTree *tree, BinaryTreeNode *node, const void *value) {
@@ -106,6 +459,7 @@ bool bitree_addLeft(BinaryTree *tree, BinaryTreeNode *node, const void *value) {
     new_node->value = (void *) value;
     new_node->left = NULL;
     new_node->right = NULL;
+    new_node->pooled = false;
     *position = new_node;
 
     tree->size++;
@@ -134,6 +488,7 @@ bool bitree_addRight(BinaryTree *tree, BinaryTreeNode *node, const void *value)
     new_node->value = (void *) value;
     new_node->left = NULL;
     new_node->right = NULL;
+    new_node->pooled = false;
     *position = new_node;
 
     tree->size++;
@@ -153,16 +508,8 @@ void bitree_removeLeft(BinaryTree *tree, BinaryTreeNode *node) {
         position = &node->left;
 
     if (*position != NULL) {
-        bitree_removeLeft(tree, *position);
-        bitree_removeRight(tree, *position);
-        if (tree->destroy != NULL) {
-            tree->destroy((*position)->value);
-        }
-
-        free(*position);
+        tree->size -= bitree_destroyBranch(tree, *position);
         *position = NULL;
-
-        tree->size--;
     }
 }
 
@@ -178,21 +525,14 @@ void bitree_removeRight(BinaryTree *tree, BinaryTreeNode *node) {
         position = &node->right;
 
     if (*position != NULL) {
-        bitree_removeLeft(tree, *position);
-        bitree_removeRight(tree, *position);
-        if (tree->destroy != NULL) {
-            tree->destroy((*position)->value);
-        }
-
-        free(*position);
+        tree->size -= bitree_destroyBranch(tree, *position);
         *position = NULL;
-
-        tree->size--;
     }
-
 }
 
 bool bitree_merge(BinaryTree *out, BinaryTree *left, BinaryTree *right, const void *value) {
+    BinaryTreeBlock **block;
+
     bitree_create(out, left->destroy);
 
     // Insert value at out's root
@@ -209,94 +549,98 @@ bool bitree_merge(BinaryTree *out, BinaryTree *left, BinaryTree *right, const vo
 
     out->size = out->size + bitree_size(left) + bitree_size(right);
 
+    // The fusion tree owns the node blocks of both trees
+    out->blocks = left->blocks;
+    for (block = &out->blocks; *block != NULL; block = &(*block)->next);
+    *block = right->blocks;
+
     // Original trees MUST not access to fusion nodes
     left->root = NULL;
     left->size = 0;
+    left->blocks = NULL;
     right->root = NULL;
     right->size = 0;
+    right->blocks = NULL;
 
     return true;
 }
 
-void **bitree_levelOrder(BinaryTree *tree, int *returnSize, int **returnColumnSizes) {
-    if (tree == NULL || tree->root) {
-        // Si l'arbre est vide, fixe la taille de retour à 0 et retourne NULL
-        *returnSize = 0;
+void **bitree_levelOrderFlat(BinaryTree *tree, int *levels, int **offsets) {
+    void **values;
+    void **shrunk;
+    BinaryTreeNode *node;
+    int *level_offsets;
+    int head;
+    int tail = 1;
+    int level_end = 1;
+    int level_count = 0;
+
+    *levels = 0;
+    *offsets = NULL;
+    if (tree == NULL || tree->root == NULL || tree->size <= 0) return NULL;
+
+    // Values and the worst case of one offset per node plus the end offset share a single block
+    if ((values = (void **) malloc(tree->size * sizeof(void *) + (tree->size + 1) * sizeof(int))) == NULL)
         return NULL;
+    level_offsets = (int *) (values + tree->size);
+    level_offsets[0] = 0;
+
+    // The values slots are the BFS queue, a slot holds its node until the whole tree is enqueued
+    values[0] = tree->root;
+    for (head = 0; head < tail; head++) {
+        if (head == level_end) {
+            level_offsets[++level_count] = head;
+            level_end = tail;
+        }
+        node = (BinaryTreeNode *) values[head];
+        if (tail + (node->left != NULL) + (node->right != NULL) > tree->size) {
+            // The tree holds more nodes than its size
+            free(values);
+            return NULL;
+        }
+        if (node->left != NULL) values[tail++] = node->left;
+        if (node->right != NULL) values[tail++] = node->right;
     }
+    level_offsets[++level_count] = tail;
+    for (head = 0; head < tail; head++) values[head] = ((BinaryTreeNode *) values[head])->value;
+
+    // Give back the unused offsets
+    if ((shrunk = (void **) realloc(values, tree->size * sizeof(void *) + (level_count + 1) * sizeof(int))) != NULL)
+        values = shrunk;
+    *levels = level_count;
+    *offsets = (int *) (values + tree->size);
+    return values;
+}
 
+void **bitree_levelOrder(BinaryTree *tree, int *returnSize, int **returnColumnSizes) {
+    void **values;
     void **result;
-
-    // Crée une file pour stocker les nœuds
-    Queue *queue, *nextQueue;
-    if ((queue = (Queue *) malloc(sizeof(Queue))) == NULL) return NULL;
-    queue_create(queue, tree->destroy);
-    // Ajoute la racine à la file
-    queue_enqueue(queue, tree->root);
-
-    // Initialisation des tableaux de résultats
-    int maxLevelNodes = bitree_maxDepth(tree);
-
-    // Alloue de l'espace mémoire pour le tableau de résultats et le tableau des tailles de colonnes
-    if ((result = (void **) malloc(maxLevelNodes * sizeof(void *)))) {
-        queue_destroy(queue);
-    }
-
-    *returnColumnSizes = (int *) malloc(maxLevelNodes * sizeof(int));
-
-    int levelIndex = 0; // Indice du niveau actuel
-
-    // On instancie une autre file pour stocker les noeuds du prochain niveau
-    if ((nextQueue = (Queue *) malloc(sizeof(Queue))) == NULL) {
-        queue_destroy(queue);
-        memset(result, 0, sizeof(void *));
+    void **level_values;
+    int *offsets;
+    int *column_sizes;
+    int levels;
+    int i;
+
+    *returnSize = 0;
+    *returnColumnSizes = NULL;
+    if ((values = bitree_levelOrderFlat(tree, &levels, &offsets)) == NULL) return NULL;
+
+    // Level arrays, values and column sizes are returned in a single block
+    if ((result = (void **) malloc((levels + offsets[levels]) * sizeof(void *) + levels * sizeof(int))) == NULL) {
+        free(values);
+        return NULL;
     }
-
-    while (list_first(queue) != NULL) {
-        // Taille arbitraire pour le tableau du niveau actuel
-        void **currentLevel;
-        if ((currentLevel = malloc(maxLevelNodes * sizeof(void *))) == NULL) {
-            queue_destroy(queue);
-            queue_destroy(nextQueue);
-            memset(result, 0, sizeof(void *));
-        }
-        int count = 0; // Compteur pour les nœuds dans chaque niveau
-
-        // Parcourt le niveau actuel jusqu'à ce que la file soit vide
-        while (list_first(queue) != NULL) {
-            // Récupère le nœud en tête de file
-            BinaryTreeNode *currNode;
-            queue_dequeue(queue, &currNode);
-            // Ajoute la valeur du nœud au tableau du niveau actuel
-            currentLevel[count++] = currNode->value;
-
-            // Ajoute les enfants du nœud au prochain niveau s'ils existent
-            if (currNode->left != NULL)
-                queue_enqueue(nextQueue, currNode->left);
-            if (currNode->right != NULL)
-                queue_enqueue(nextQueue, currNode->right);
-        }
-
-        // Ajuste la taille du tableau du niveau actuel et l'ajoute au résultat
-        if (levelIndex >= maxLevelNodes) {
-            // Double la taille du tableau
-            maxLevelNodes *= 2;
-            result = (void **) realloc(result, maxLevelNodes * sizeof(void *));
-            *returnColumnSizes =
-                    (int *) realloc(*returnColumnSizes, maxLevelNodes * sizeof(int));
-        }
-        currentLevel = (void *) realloc(currentLevel, count * sizeof(void *));
-        if (result != NULL) {
-            result[levelIndex] = currentLevel;
-            (*returnColumnSizes)[levelIndex++] = count;
-        }
-
-        // Passe au prochain niveau en échangeant les files
-        queue_destroy(queue);
-        queue = nextQueue;
-        queue_create(nextQueue, tree->destroy);
+    level_values = result + levels;
+    column_sizes = (int *) (level_values + offsets[levels]);
+    memcpy(level_values, values, offsets[levels] * sizeof(void *));
+    for (i = 0; i < levels; i++) {
+        result[i] = level_values + offsets[i];
+        column_sizes[i] = offsets[i + 1] - offsets[i];
     }
+    free(values);
 
+    *returnSize = levels;
+    *returnColumnSizes = column_sizes;
     return result;
 }
 
@@ -311,6 +655,7 @@ bitree_build_from_preorder_inorder_branch(void **preorder, int preorder_size, vo
     BinaryTreeNode *branchRoot;
     if ((branchRoot = malloc(sizeof(struct BinaryTreeNode))) == NULL) return NULL;
     branchRoot->value = preorder[0];
+    branchRoot->pooled = false;
 
     /*
      * We know branchRoot exists in our inorder array, so we can find the size of the
@@ -337,15 +682,84 @@ bitree_build_from_preorder_inorder_branch(void **preorder, int preorder_size, vo
     return branchRoot;
 }
 
-BinaryTree *bitree_build_from_preorder_inorder(void **preorder, int preorder_size, void **inorder, int inorder_size,
-                                               void(*destroy)(void *value),
-                                               bool (*equals)(const void *value1, const void *value2)) {
+/**
+ * @brief Private method to create the tree of a builder, all its nodes are allocated in a single block
+ * @return The created tree, NULL if the allocation failed
+ */
+static BinaryTree *bitree_buildTree(int size, void(*destroy)(void *value),
+                                    bool (*equals)(const void *value1, const void *value2), BinaryTreeNode **nodes) {
     BinaryTree *result;
+    BinaryTreeBlock *block;
+
     if ((result = (BinaryTree *) malloc(sizeof(BinaryTree))) == NULL) return NULL;
     bitree_create(result, destroy);
     result->equals = equals;
-    result->root = bitree_build_from_preorder_inorder_branch(preorder, preorder_size, inorder, inorder_size,
-                                                             result->equals);
+    *nodes = NULL;
+    if (size == 0) return result;
+
+    if ((block = (BinaryTreeBlock *) malloc(sizeof(BinaryTreeBlock) + size * sizeof(BinaryTreeNode))) == NULL) {
+        free(result);
+        return NULL;
+    }
+    block->next = NULL;
+    block->count = size;
+    result->blocks = block;
+    result->size = size;
+    *nodes = block->nodes;
+    return result;
+}
+
+BinaryTree *bitree_build_from_preorder_inorder(void **preorder, int preorder_size, void **inorder, int inorder_size,
+                                               void(*destroy)(void *value),
+                                               bool (*equals)(const void *value1, const void *value2)) {
+    BinaryTree *result;
+    BinaryTreeNode *nodes;
+    BinaryTreeNode *node;
+    BinaryTreeNode *top;
+    BinaryTreeNode *parent;
+    int inorder_index = 0;
+    int i;
+
+    if (preorder_size < 0 || preorder_size != inorder_size) return NULL;
+    if ((result = bitree_buildTree(preorder_size, destroy, equals, &nodes)) == NULL) return NULL;
+    if (preorder_size == 0) return result;
+
+    /*
+     * Nodes waiting for their right child are stacked, linked through their unused right links. A node is popped
+     * when it is the next inorder value, the last popped node gets the following preorder value as right child,
+     * otherwise the value is the left child of the top node
+     */
+    top = NULL;
+    for (i = 0; i < preorder_size; i++) {
+        node = &nodes[i];
+        node->value = preorder[i];
+        node->left = NULL;
+        node->pooled = true;
+
+        parent = NULL;
+        while (top != NULL && equals(top->value, inorder[inorder_index])) {
+            parent = top;
+            top = top->right;
+            parent->right = NULL;
+            inorder_index++;
+        }
+        if (parent != NULL)
+            parent->right = node;
+        else if (top != NULL)
+            top->left = node;
+
+        node->right = top;
+        top = node;
+    }
+
+    // The remaining nodes have no right child
+    while (top != NULL) {
+        node = top->right;
+        top->right = NULL;
+        top = node;
+    }
+
+    result->root = &nodes[0];
     return result;
 }
 
@@ -359,6 +773,7 @@ BinaryTreeNode *bitree_build_from_inorder_postorder_branch(void **inorder, int i
     if ((branchRoot = (BinaryTreeNode *) malloc(sizeof(struct BinaryTreeNode))) == NULL) return NULL;
 
     branchRoot->value = *(postorder + postorderSize - 1);
+    branchRoot->pooled = false;
     int index;
 
     for (index = 0; index < inorderSize; index++) {
@@ -381,24 +796,87 @@ BinaryTree *bitree_build_from_inorder_postorder(void **inorder,
                                                 void(*destroy)(void *value),
                                                 bool (*equals)(const void *value1, const void *value2)) {
     BinaryTree *result;
-    if ((result = (BinaryTree *) malloc(sizeof(BinaryTree))) == NULL) return NULL;
-    bitree_create(result, destroy);
-    result->equals = equals;
-    result->root = bitree_build_from_inorder_postorder_branch(inorder, 0, postorder, 0, result->equals);
+    BinaryTreeNode *nodes;
+    BinaryTreeNode *node;
+    BinaryTreeNode *top;
+    BinaryTreeNode *parent;
+    void **values = (void **) postorder;
+    int inorder_index = inorderSize - 1;
+    int i;
+
+    if (postorderSize < 0 || postorderSize != inorderSize) return NULL;
+    if ((result = bitree_buildTree(postorderSize, destroy, equals, &nodes)) == NULL) return NULL;
+    if (postorderSize == 0) return result;
+
+    // Mirror of the preorder builder, both traversals are read backward and nodes wait for their left child
+    top = NULL;
+    for (i = postorderSize - 1; i >= 0; i--) {
+        node = &nodes[i];
+        node->value = values[i];
+        node->right = NULL;
+        node->pooled = true;
+
+        parent = NULL;
+        while (top != NULL && equals(top->value, inorder[inorder_index])) {
+            parent = top;
+            top = top->left;
+            parent->left = NULL;
+            inorder_index--;
+        }
+        if (parent != NULL)
+            parent->left = node;
+        else if (top != NULL)
+            top->right = node;
+
+        node->left = top;
+        top = node;
+    }
+
+    // The remaining nodes have no left child
+    while (top != NULL) {
+        node = top->left;
+        top->left = NULL;
+        top = node;
+    }
+
+    result->root = &nodes[postorderSize - 1];
     return result;
 }
 
 int bitree_height(BinaryTreeNode *root, int *diameter) {
-    if (root == NULL) {
-        return 0;
+    BinaryTreeStack stack;
+    BinaryTreeFrame *frame;
+    int height = 0;
+    int left;
+
+    if (root == NULL) return 0;
+    bitree_stackCreate(&stack);
+    bitree_stackPush(&stack, root, NULL, BITREE_FRAME_NEW);
+
+    // Post-order walk, height holds the height of the last completed subtree
+    while (stack.size > 0) {
+        frame = &stack.frames[stack.size - 1];
+        if (frame->node == NULL) {
+            height = 0;
+            stack.size--;
+        } else if (frame->state == BITREE_FRAME_NEW) {
+            frame->state = BITREE_FRAME_LEFT;
+            if (!bitree_stackPush(&stack, frame->node->left, NULL, BITREE_FRAME_NEW)) break;
+        } else if (frame->state == BITREE_FRAME_LEFT) {
+            // The frame now keeps the left height
+            frame->state = height;
+            if (!bitree_stackPush(&stack, frame->node->right, NULL, BITREE_FRAME_NEW)) break;
+        } else {
+            left = frame->state;
+            if (left + height > *diameter) *diameter = left + height;
+            height = 1 + (left > height ? left : height);
+            stack.size--;
+        }
     }
 
-    int leftHeight = bitree_height(root->left, diameter);
-    int rightHeight = bitree_height(root->right, diameter);
-
-    *diameter = (int) fmax(*diameter, (leftHeight + rightHeight));
-
-    return 1 + (int) fmax(leftHeight, rightHeight);
+    if (stack.size > 0) height = -1;
+    bitree_stackDestroy(&stack);
+    return height;
 }
 
 int bitree_diameter(BinaryTree *tree) {
@@ -417,3 +895,184 @@ int bitree_nodeCount(BinaryTree *tree){
         return 0;
     return bitree_branchNodeCount(tree->root);
 }
+
+/**
+ * @brief Kind of parallel walk
+ */
+typedef enum BinaryTreeWalk {
+    BITREE_WALK_COUNT,
+    BITREE_WALK_DEPTH,
+    BITREE_WALK_DIAMETER,
+    BITREE_WALK_SAME,
+    BITREE_WALK_MIRROR
+} BinaryTreeWalk;
+
+/**
+ * @brief Parallel walk of a branch, or of a pair of branches for the comparisons
+ */
+typedef struct BinaryTreeJob {
+    /**
+     * @brief Kind of walk
+     */
+    BinaryTreeWalk walk;
+    /**
+     * @brief Number of levels still forked, the branch is walked sequentially at 0
+     */
+    int levels;
+    /**
+     * @brief Values compare function of the comparisons
+     */
+    bool (*equals)(const void *value1, const void *value2);
+    /**
+     * @brief Root of the walked branch
+     */
+    BinaryTreeNode *node;
+    /**
+     * @brief Root of the branch compared with the walked one
+     */
+    BinaryTreeNode *other;
+    /**
+     * @brief Count, depth, height or 1 if the branches match, -1 if an allocation failed
+     */
+    int result;
+    /**
+     * @brief Longest path length of the branch for the diameter walk
+     */
+    int diameter;
+} BinaryTreeJob;
+
+/**
+ * @brief Private method to walk a branch with the sequential functions
+ */
+static void bitree_walkBranch(BinaryTreeJob *job) {
+    switch (job->walk) {
+        case BITREE_WALK_COUNT:
+            job->result = bitree_branchNodeCount(job->node);
+            break;
+        case BITREE_WALK_DEPTH:
+            job->result = bitree_maxDepthBranch(job->node);
+            break;
+        case BITREE_WALK_DIAMETER:
+            job->diameter = 0;
+            job->result = bitree_height(job->node, &job->diameter);
+            break;
+        case BITREE_WALK_SAME:
+            job->result = bitree_isSameTree(job->equals, job->node, job->other);
+            break;
+        case BITREE_WALK_MIRROR:
+            job->result = bitree_isMirror(job->equals, job->node, job->other);
+            break;
+    }
+}
+
+/**
+ * @brief Private method to fork the right branch of a job and walk the left one, the results are combined in the
+ * same order whatever the worker that ran each branch
+ */
+static void bitree_parallelWalk(ParallelWorker *worker, void *data) {
+    BinaryTreeJob *job = (BinaryTreeJob *) data;
+    BinaryTreeJob left = *job;
+    BinaryTreeJob right = *job;
+    ParallelTask task;
+    bool pair = job->walk == BITREE_WALK_SAME || job->walk == BITREE_WALK_MIRROR;
+
+    if (job->levels == 0 || job->node == NULL || (pair && job->other == NULL)) {
+        bitree_walkBranch(job);
+        return;
+    }
+    if (pair && !job->equals(job->node->value, job->other->value)) {
+        job->result = 0;
+        return;
+    }
+
+    left.levels = right.levels = job->levels - 1;
+    left.node = job->node->left;
+    right.node = job->node->right;
+    if (job->walk == BITREE_WALK_SAME) {
+        left.other = job->other->left;
+        right.other = job->other->right;
+    } else if (job->walk == BITREE_WALK_MIRROR) {
+        left.other = job->other->right;
+        right.other = job->other->left;
+    }
+    parallel_fork(worker, &task, bitree_parallelWalk, &right);
+    bitree_parallelWalk(worker, &left);
+    parallel_join(worker, &task);
+
+    if (pair) {
+        job->result = left.result && right.result;
+    } else if (left.result < 0 || right.result < 0) {
+        job->result = -1;
+    } else if (job->walk == BITREE_WALK_COUNT) {
+        job->result = 1 + left.result + right.result;
+    } else {
+        job->result = 1 + (left.result > right.result ? left.result : right.result);
+        job->diameter = left.diameter > right.diameter ? left.diameter : right.diameter;
+        if (left.result + right.result > job->diameter) job->diameter = left.result + right.result;
+    }
+}
+
+/**
+ * @brief Private method to run a parallel walk, enough levels are forked to give several branches to each thread
+ */
+static void bitree_parallelRun(ParallelPool *pool, BinaryTreeJob *job) {
+    int threads;
+
+    job->levels = 0;
+    if (parallel_threads(pool) > 1) {
+        job->levels = BITREE_PARALLEL_LEVELS;
+        for (threads = parallel_threads(pool); threads > 1; threads >>= 1) job->levels++;
+    }
+    job->result = 0;
+    job->diameter = 0;
+    parallel_run(pool, bitree_parallelWalk, job);
+}
+
+int bitree_parallelNodeCount(ParallelPool *pool, BinaryTree *tree) {
+    BinaryTreeJob job = {BITREE_WALK_COUNT, 0, NULL, NULL, NULL, 0, 0};
+
+    if (tree == NULL) return 0;
+    job.node = tree->root;
+    bitree_parallelRun(pool, &job);
+    return job.result;
+}
+
+int bitree_parallelMaxDepth(ParallelPool *pool, BinaryTree *tree) {
+    BinaryTreeJob job = {BITREE_WALK_DEPTH, 0, NULL, NULL, NULL, 0, 0};
+
+    if (tree == NULL) return 0;
+    job.node = tree->root;
+    bitree_parallelRun(pool, &job);
+    return job.result;
+}
+
+int bitree_parallelDiameter(ParallelPool *pool, BinaryTree *tree) {
+    BinaryTreeJob job = {BITREE_WALK_DIAMETER, 0, NULL, NULL, NULL, 0, 0};
+
+    if (tree == NULL) return 0;
+    job.node = tree->root;
+    bitree_parallelRun(pool, &job);
+    return job.result < 0 ? -1 : job.diameter;
+}
+
+bool bitree_parallelIsSameTree(ParallelPool *pool, bool (*equals)(const void *value1, const void *value2),
+                               BinaryTreeNode *left, BinaryTreeNode *right) {
+    BinaryTreeJob job = {BITREE_WALK_SAME, 0, NULL, NULL, NULL, 0, 0};
+
+    job.equals = equals;
+    job.node = left;
+    job.other = right;
+    bitree_parallelRun(pool, &job);
+    return job.result != 0;
+}
+
+bool bitree_parallelIsMirror(ParallelPool *pool, bool (*equals)(const void *value1, const void *value2),
+                             BinaryTreeNode *left, BinaryTreeNode *right) {
+    BinaryTreeJob job = {BITREE_WALK_MIRROR, 0, NULL, NULL, NULL, 0, 0};
+
+    job.equals = equals;
+    job.node = left;
+    job.other = right;
+    bitree_parallelRun(pool, &job);
+    return job.result != 0;
+}
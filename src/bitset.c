@@ -0,0 +1,363 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#include <string.h>
+#include "bitset.h"
+#include "simd_utils.h"
+
+#if COLLECTIONS_SIMD_AVX2
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Number of 64 bits words processed by one AVX2 register, words are always allocated by multiple of it
+ */
+#define BITSET_BLOCK_WORDS 4
+
+/**
+ * @brief Word operations of the set algebra
+ */
+typedef enum BitSetOperation {
+    BITSET_UNION,
+    BITSET_INTERSECTION,
+    BITSET_DIFFERENCE
+} BitSetOperation;
+
+/**
+ * @brief Private method to count the bits of a word
+ */
+static int bitset_popcount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return (int) ((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * @brief Private method to find the lowest bit set of a non-zero word
+ */
+static int bitset_lowestBit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int bit = 0;
+    while ((word & 1) == 0) {
+        word >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+/**
+ * @brief Private scalar kernel applying a set operation word by word
+ */
+static void bitset_combineScalar(uint64_t *out, const uint64_t *left, const uint64_t *right, int words,
+                                 BitSetOperation operation) {
+    int i;
+
+    for (i = 0; i < words; i++) {
+        switch (operation) {
+            case BITSET_UNION:
+                out[i] = left[i] | right[i];
+                break;
+            case BITSET_INTERSECTION:
+                out[i] = left[i] & right[i];
+                break;
+            default:
+                out[i] = left[i] & ~right[i];
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Private scalar kernel testing if left words are included in right words
+ */
+static bool bitset_isSubsetScalar(const uint64_t *left, const uint64_t *right, int words) {
+    int i;
+
+    for (i = 0; i < words; i++) {
+        if ((left[i] & ~right[i]) != 0) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Private scalar kernel counting the bits of words
+ */
+static int bitset_countScalar(const uint64_t *bits, int words) {
+    int i, count = 0;
+
+    for (i = 0; i < words; i++) count += bitset_popcount(bits[i]);
+    return count;
+}
+
+#if COLLECTIONS_SIMD_AVX2
+
+/**
+ * @brief Private AVX2 kernel applying a set operation on 256 bits blocks
+ */
+COLLECTIONS_TARGET_AVX2
+static void bitset_combineAvx2(uint64_t *out, const uint64_t *left, const uint64_t *right, int words,
+                               BitSetOperation operation) {
+    int i;
+
+    for (i = 0; i < words; i += BITSET_BLOCK_WORDS) {
+        __m256i a = _mm256_loadu_si256((const __m256i *) &left[i]);
+        __m256i b = _mm256_loadu_si256((const __m256i *) &right[i]);
+        __m256i result;
+
+        if (operation == BITSET_UNION) result = _mm256_or_si256(a, b);
+        else if (operation == BITSET_INTERSECTION) result = _mm256_and_si256(a, b);
+        else result = _mm256_andnot_si256(b, a);
+        _mm256_storeu_si256((__m256i *) &out[i], result);
+    }
+}
+
+/**
+ * @brief Private AVX2 kernel testing if left blocks are included in right blocks
+ */
+COLLECTIONS_TARGET_AVX2
+static bool bitset_isSubsetAvx2(const uint64_t *left, const uint64_t *right, int words) {
+    int i;
+
+    for (i = 0; i < words; i += BITSET_BLOCK_WORDS) {
+        __m256i outside = _mm256_andnot_si256(_mm256_loadu_si256((const __m256i *) &right[i]),
+                                              _mm256_loadu_si256((const __m256i *) &left[i]));
+        if (!_mm256_testz_si256(outside, outside)) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Private AVX2 kernel counting the bits of 256 bits blocks with nibble lookups
+ */
+COLLECTIONS_TARGET_AVX2
+static int bitset_countAvx2(const uint64_t *bits, int words) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    __m256i total = _mm256_setzero_si256();
+    int i;
+
+    for (i = 0; i < words; i += BITSET_BLOCK_WORDS) {
+        __m256i block = _mm256_loadu_si256((const __m256i *) &bits[i]);
+        __m256i low = _mm256_and_si256(block, low_mask);
+        __m256i high = _mm256_and_si256(_mm256_srli_epi16(block, 4), low_mask);
+        __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+
+        // Sum the byte counts of each 64 bits lane
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+    }
+    return (int) (_mm256_extract_epi64(total, 0) + _mm256_extract_epi64(total, 1) +
+                  _mm256_extract_epi64(total, 2) + _mm256_extract_epi64(total, 3));
+}
+
+#endif
+
+/**
+ * @brief Private method applying a set operation with the best available kernel
+ */
+static void bitset_combine(uint64_t *out, const uint64_t *left, const uint64_t *right, int words,
+                           BitSetOperation operation) {
+#if COLLECTIONS_SIMD_AVX2
+    if (simd_hasAvx2()) {
+        bitset_combineAvx2(out, left, right, words, operation);
+        return;
+    }
+#endif
+    bitset_combineScalar(out, left, right, words, operation);
+}
+
+/**
+ * @brief Private method testing if left words are included in right words with the best available kernel
+ */
+static bool bitset_wordsSubset(const uint64_t *left, const uint64_t *right, int words) {
+#if COLLECTIONS_SIMD_AVX2
+    if (simd_hasAvx2()) return bitset_isSubsetAvx2(left, right, words);
+#endif
+    return bitset_isSubsetScalar(left, right, words);
+}
+
+/**
+ * @brief Private method testing if words are all zero
+ */
+static bool bitset_wordsEmpty(const uint64_t *bits, int words) {
+    int i;
+
+    for (i = 0; i < words; i++) {
+        if (bits[i] != 0) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Private method to grow a bit set, new words are zeroed
+ * @param set Bit set to grow
+ * @param capacity Number of integers the bit set MUST hold
+ * @return true if the bit set can hold the given number of integers, false otherwise
+ */
+static bool bitset_reserve(BitSet *set, int capacity) {
+    uint64_t *bits;
+    size_t words;
+
+    if (capacity <= set->capacity) return true;
+
+    // Round up to whole AVX2 blocks, computed in size_t as capacities near INT_MAX overflow an int
+    words = (((size_t) capacity + 255) / 256) * BITSET_BLOCK_WORDS;
+    if ((bits = (uint64_t *) realloc(set->bits, words * sizeof(uint64_t))) == NULL) return false;
+    memset(&bits[set->words], 0, (words - (size_t) set->words) * sizeof(uint64_t));
+    set->bits = bits;
+    set->words = (int) words;
+    set->capacity = words * 64 > BITSET_MAX_CAPACITY ? BITSET_MAX_CAPACITY : (int) (words * 64);
+    return true;
+}
+
+bool bitset_create(BitSet *set, int capacity) {
+    set->capacity = 0;
+    set->words = 0;
+    set->bits = NULL;
+    return bitset_reserve(set, capacity > 0 ? capacity : 1);
+}
+
+void bitset_destroy(BitSet *set) {
+    free(set->bits);
+    memset(set, 0, sizeof(BitSet));
+}
+
+bool bitset_set(BitSet *set, int index) {
+    int64_t grown = (int64_t) set->capacity * 2;
+
+    if (index < 0 || index >= BITSET_MAX_CAPACITY) return false;
+
+    // The capacity doubles up to BITSET_MAX_CAPACITY so repeated growth stays amortized
+    if (grown > BITSET_MAX_CAPACITY) grown = BITSET_MAX_CAPACITY;
+    if (index >= set->capacity && !bitset_reserve(set, index >= grown ? index + 1 : (int) grown)) return false;
+    set->bits[index / 64] |= (uint64_t) 1 << (index % 64);
+    return true;
+}
+
+bool bitset_clear(BitSet *set, int index) {
+    uint64_t mask;
+
+    if (!bitset_test(set, index)) return false;
+    mask = (uint64_t) 1 << (index % 64);
+    set->bits[index / 64] &= ~mask;
+    return true;
+}
+
+bool bitset_test(const BitSet *set, int index) {
+    if (index < 0 || index >= set->capacity) return false;
+    return (set->bits[index / 64] >> (index % 64)) & 1;
+}
+
+int bitset_count(const BitSet *set) {
+#if COLLECTIONS_SIMD_AVX2
+    if (simd_hasAvx2()) return bitset_countAvx2(set->bits, set->words);
+#endif
+    return bitset_countScalar(set->bits, set->words);
+}
+
+int bitset_nextSet(const BitSet *set, int from) {
+    int word;
+    uint64_t bits;
+
+    if (from < 0) from = 0;
+    if (from >= set->capacity) return -1;
+
+    // Mask the bits lower than from in its word
+    word = from / 64;
+    bits = set->bits[word] & (~(uint64_t) 0 << (from % 64));
+    while (bits == 0) {
+        if (++word == set->words) return -1;
+        bits = set->bits[word];
+    }
+    return word * 64 + bitset_lowestBit(bits);
+}
+
+bool bitset_union(BitSet *union_result, const BitSet *left, const BitSet *right) {
+    const BitSet *larger = left->words >= right->words ? left : right;
+    int words = left->words < right->words ? left->words : right->words;
+
+    if (!bitset_create(union_result, larger->capacity)) return false;
+    bitset_combine(union_result->bits, left->bits, right->bits, words, BITSET_UNION);
+    memcpy(&union_result->bits[words], &larger->bits[words], (larger->words - words) * sizeof(uint64_t));
+    return true;
+}
+
+bool bitset_intersection(BitSet *intersection_result, const BitSet *left, const BitSet *right) {
+    const BitSet *smaller = left->words < right->words ? left : right;
+    int words = smaller->words;
+
+    // The smaller capacity is already clamped, words * 64 overflows an int for the largest bit sets
+    if (!bitset_create(intersection_result, smaller->capacity)) return false;
+    bitset_combine(intersection_result->bits, left->bits, right->bits, words, BITSET_INTERSECTION);
+    return true;
+}
+
+bool bitset_difference(BitSet *difference_result, const BitSet *left, const BitSet *right) {
+    int words = left->words < right->words ? left->words : right->words;
+
+    if (!bitset_create(difference_result, left->capacity)) return false;
+    bitset_combine(difference_result->bits, left->bits, right->bits, words, BITSET_DIFFERENCE);
+    memcpy(&difference_result->bits[words], &left->bits[words], (left->words - words) * sizeof(uint64_t));
+    return true;
+}
+
+bool bitset_isSubset(const BitSet *left, const BitSet *right) {
+    int words = left->words < right->words ? left->words : right->words;
+
+    // Left integers out of right capacity can't be in right
+    return bitset_wordsSubset(left->bits, right->bits, words) &&
+           bitset_wordsEmpty(&left->bits[words], left->words - words);
+}
+
+bool bitset_equals(const BitSet *left, const BitSet *right) {
+    int words = left->words < right->words ? left->words : right->words;
+
+    return memcmp(left->bits, right->bits, words * sizeof(uint64_t)) == 0 &&
+           bitset_wordsEmpty(&left->bits[words], left->words - words) &&
+           bitset_wordsEmpty(&right->bits[words], right->words - words);
+}
+
+bool bitset_fromSet(BitSet *bitset, const Set *set) {
+    LinkedElement *current_element;
+    int max_value = 0;
+
+    // Size the bit set once from the greatest value
+    for (current_element = list_first(set); current_element != NULL; current_element = list_next(current_element)) {
+        int value = *((int *) list_value(current_element));
+        if (value < 0) return false;
+        if (value > max_value) max_value = value;
+    }
+
+    if (!bitset_create(bitset, max_value + 1)) return false;
+    for (current_element = list_first(set); current_element != NULL; current_element = list_next(current_element))
+        bitset_set(bitset, *((int *) list_value(current_element)));
+    return true;
+}
+
+bool bitset_fromHashSet(BitSet *bitset, const HashSet *set) {
+    DLinkedElement *current_element;
+    int max_value = 0;
+
+    // Size the bit set once from the greatest value
+    for (current_element = hashset_first(set);
+         current_element != NULL; current_element = hashset_next(current_element)) {
+        int value = *((int *) dlist_value(current_element));
+        if (value < 0) return false;
+        if (value > max_value) max_value = value;
+    }
+
+    if (!bitset_create(bitset, max_value + 1)) return false;
+    for (current_element = hashset_first(set);
+         current_element != NULL; current_element = hashset_next(current_element))
+        bitset_set(bitset, *((int *) dlist_value(current_element)));
+    return true;
+}
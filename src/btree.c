@@ -0,0 +1,539 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#include <string.h>
+#include "btree.h"
+#include "search.h"
+
+/**
+ * @brief Minimum number of keys of a node other than the root
+ */
+#define BTREE_MIN_KEYS (BTREE_NODE_KEYS / 2)
+
+/**
+ * @brief Maximum number of levels of a tree, far above the height of any tree of 2^31 keys
+ */
+#define BTREE_MAX_HEIGHT 48
+
+/**
+ * @brief Private method counting the keys lower than the given key, or lower or equal if inclusive is true
+ */
+static int btree_rank(const int64_t *keys, int count, int64_t key, bool inclusive) {
+    return inclusive ? array_upperBoundInt64(keys, count, key) : array_lowerBoundInt64(keys, count, key);
+}
+
+/**
+ * @brief Private method to allocate an empty leaf
+ */
+static BTreeLeaf *btree_newLeaf(void) {
+    BTreeLeaf *leaf;
+
+    if ((leaf = (BTreeLeaf *) malloc(sizeof(BTreeLeaf))) == NULL) return NULL;
+    leaf->node.count = 0;
+    leaf->node.leaf = true;
+    leaf->previous = NULL;
+    leaf->next = NULL;
+    return leaf;
+}
+
+/**
+ * @brief Private method to allocate an empty inner node
+ */
+static BTreeInner *btree_newInner(void) {
+    BTreeInner *inner;
+
+    if ((inner = (BTreeInner *) malloc(sizeof(BTreeInner))) == NULL) return NULL;
+    inner->node.count = 0;
+    inner->node.leaf = false;
+    return inner;
+}
+
+/**
+ * @brief Private method to free a subtree
+ */
+static void btree_freeNode(BTreeNode *node) {
+    int i;
+
+    if (!node->leaf) {
+        for (i = 0; i <= node->count; i++) btree_freeNode(((BTreeInner *) node)->children[i]);
+    }
+    free(node);
+}
+
+/**
+ * @brief Private method to descend to the leaf that may hold the given key
+ */
+static BTreeLeaf *btree_findLeaf(const BTree *tree, int64_t key) {
+    const BTreeNode *node = tree->root;
+
+    while (!node->leaf) {
+        node = ((const BTreeInner *) node)->children[btree_rank(node->keys, node->count, key, true)];
+    }
+    return (BTreeLeaf *) node;
+}
+
+/**
+ * @brief Private method to split a full leaf while inserting a key, the upper half moves into the right leaf
+ * @return The lowest key of the right leaf
+ */
+static int64_t btree_splitLeaf(BTreeLeaf *leaf, BTreeLeaf *right, int position, int64_t key, const void *value) {
+    int64_t keys[BTREE_NODE_KEYS + 1];
+    void *values[BTREE_NODE_KEYS + 1];
+    int left = (BTREE_NODE_KEYS + 1) / 2;
+
+    memcpy(keys, leaf->node.keys, position * sizeof(int64_t));
+    memcpy(values, leaf->values, position * sizeof(void *));
+    keys[position] = key;
+    values[position] = (void *) value;
+    memcpy(&keys[position + 1], &leaf->node.keys[position], (BTREE_NODE_KEYS - position) * sizeof(int64_t));
+    memcpy(&values[position + 1], &leaf->values[position], (BTREE_NODE_KEYS - position) * sizeof(void *));
+
+    memcpy(leaf->node.keys, keys, left * sizeof(int64_t));
+    memcpy(leaf->values, values, left * sizeof(void *));
+    leaf->node.count = left;
+    memcpy(right->node.keys, &keys[left], (BTREE_NODE_KEYS + 1 - left) * sizeof(int64_t));
+    memcpy(right->values, &values[left], (BTREE_NODE_KEYS + 1 - left) * sizeof(void *));
+    right->node.count = BTREE_NODE_KEYS + 1 - left;
+    return right->node.keys[0];
+}
+
+/**
+ * @brief Private method to split a full inner node while inserting a separator and its right child
+ * @return The separator moved up to the parent
+ */
+static int64_t btree_splitInner(BTreeInner *inner, BTreeInner *right, int slot, int64_t key, BTreeNode *child) {
+    int64_t keys[BTREE_NODE_KEYS + 1];
+    BTreeNode *children[BTREE_NODE_KEYS + 2];
+    int left = (BTREE_NODE_KEYS + 1) / 2;
+
+    memcpy(keys, inner->node.keys, slot * sizeof(int64_t));
+    keys[slot] = key;
+    memcpy(&keys[slot + 1], &inner->node.keys[slot], (BTREE_NODE_KEYS - slot) * sizeof(int64_t));
+    memcpy(children, inner->children, (slot + 1) * sizeof(BTreeNode *));
+    children[slot + 1] = child;
+    memcpy(&children[slot + 2], &inner->children[slot + 1], (BTREE_NODE_KEYS - slot) * sizeof(BTreeNode *));
+
+    memcpy(inner->node.keys, keys, left * sizeof(int64_t));
+    memcpy(inner->children, children, (left + 1) * sizeof(BTreeNode *));
+    inner->node.count = left;
+    memcpy(right->node.keys, &keys[left + 1], (BTREE_NODE_KEYS - left) * sizeof(int64_t));
+    memcpy(right->children, &children[left + 1], (BTREE_NODE_KEYS + 1 - left) * sizeof(BTreeNode *));
+    right->node.count = BTREE_NODE_KEYS - left;
+    return keys[left];
+}
+
+/**
+ * @brief Private method to merge the child right of a separator into the child left of it, then drop the separator
+ */
+static void btree_merge(BTree *tree, BTreeInner *parent, int index) {
+    BTreeNode *left = parent->children[index];
+    BTreeNode *right = parent->children[index + 1];
+    BTreeLeaf *left_leaf = (BTreeLeaf *) left;
+    BTreeLeaf *right_leaf = (BTreeLeaf *) right;
+    BTreeInner *left_inner = (BTreeInner *) left;
+    BTreeInner *right_inner = (BTreeInner *) right;
+
+    if (left->leaf) {
+        memcpy(&left->keys[left->count], right->keys, right->count * sizeof(int64_t));
+        memcpy(&left_leaf->values[left->count], right_leaf->values, right->count * sizeof(void *));
+        left->count += right->count;
+        left_leaf->next = right_leaf->next;
+        if (right_leaf->next != NULL) right_leaf->next->previous = left_leaf;
+        else tree->last = left_leaf;
+    } else {
+        left->keys[left->count] = parent->node.keys[index];
+        memcpy(&left->keys[left->count + 1], right->keys, right->count * sizeof(int64_t));
+        memcpy(&left_inner->children[left->count + 1], right_inner->children, (right->count + 1) * sizeof(BTreeNode *));
+        left->count += right->count + 1;
+    }
+    free(right);
+
+    memmove(&parent->node.keys[index], &parent->node.keys[index + 1],
+            (parent->node.count - index - 1) * sizeof(int64_t));
+    memmove(&parent->children[index + 1], &parent->children[index + 2],
+            (parent->node.count - index - 1) * sizeof(BTreeNode *));
+    parent->node.count--;
+}
+
+/**
+ * @brief Private method to move the greatest key of the left sibling into an underflowing child
+ */
+static void btree_borrowLeft(BTreeInner *parent, int slot) {
+    BTreeNode *left = parent->children[slot - 1];
+    BTreeNode *node = parent->children[slot];
+    BTreeInner *inner = (BTreeInner *) node;
+
+    memmove(&node->keys[1], node->keys, node->count * sizeof(int64_t));
+    if (node->leaf) {
+        memmove(&((BTreeLeaf *) node)->values[1], ((BTreeLeaf *) node)->values, node->count * sizeof(void *));
+        node->keys[0] = left->keys[left->count - 1];
+        ((BTreeLeaf *) node)->values[0] = ((BTreeLeaf *) left)->values[left->count - 1];
+        parent->node.keys[slot - 1] = node->keys[0];
+    } else {
+        memmove(&inner->children[1], inner->children, (node->count + 1) * sizeof(BTreeNode *));
+        node->keys[0] = parent->node.keys[slot - 1];
+        inner->children[0] = ((BTreeInner *) left)->children[left->count];
+        parent->node.keys[slot - 1] = left->keys[left->count - 1];
+    }
+    left->count--;
+    node->count++;
+}
+
+/**
+ * @brief Private method to move the lowest key of the right sibling into an underflowing child
+ */
+static void btree_borrowRight(BTreeInner *parent, int slot) {
+    BTreeNode *node = parent->children[slot];
+    BTreeNode *right = parent->children[slot + 1];
+    BTreeInner *right_inner = (BTreeInner *) right;
+
+    if (node->leaf) {
+        node->keys[node->count] = right->keys[0];
+        ((BTreeLeaf *) node)->values[node->count] = ((BTreeLeaf *) right)->values[0];
+        memmove(((BTreeLeaf *) right)->values, &((BTreeLeaf *) right)->values[1], (right->count - 1) * sizeof(void *));
+        memmove(right->keys, &right->keys[1], (right->count - 1) * sizeof(int64_t));
+        parent->node.keys[slot] = right->keys[0];
+    } else {
+        node->keys[node->count] = parent->node.keys[slot];
+        ((BTreeInner *) node)->children[node->count + 1] = right_inner->children[0];
+        parent->node.keys[slot] = right->keys[0];
+        memmove(right->keys, &right->keys[1], (right->count - 1) * sizeof(int64_t));
+        memmove(right_inner->children, &right_inner->children[1], right->count * sizeof(BTreeNode *));
+    }
+    right->count--;
+    node->count++;
+}
+
+/**
+ * @brief Private method to fix an underflowing child by borrowing a key from a sibling or merging with it
+ * @return true if two children were merged, the parent lost a key, false otherwise
+ */
+static bool btree_rebalance(BTree *tree, BTreeInner *parent, int slot) {
+    if (slot > 0 && parent->children[slot - 1]->count > BTREE_MIN_KEYS) {
+        btree_borrowLeft(parent, slot);
+        return false;
+    }
+    if (slot < parent->node.count && parent->children[slot + 1]->count > BTREE_MIN_KEYS) {
+        btree_borrowRight(parent, slot);
+        return false;
+    }
+    btree_merge(tree, parent, slot > 0 ? slot - 1 : slot);
+    return true;
+}
+
+void btree_create(BTree *tree, void (*destroy)(void *value)) {
+    tree->size = 0;
+    tree->height = 0;
+    tree->destroy = destroy;
+    tree->root = NULL;
+    tree->first = NULL;
+    tree->last = NULL;
+}
+
+void btree_destroy(BTree *tree) {
+    BTreeLeaf *leaf;
+    int i;
+
+    if (tree->destroy != NULL) {
+        for (leaf = tree->first; leaf != NULL; leaf = leaf->next) {
+            for (i = 0; i < leaf->node.count; i++) tree->destroy(leaf->values[i]);
+        }
+    }
+    if (tree->root != NULL) btree_freeNode(tree->root);
+    btree_create(tree, tree->destroy);
+}
+
+bool btree_insert(BTree *tree, int64_t key, const void *value) {
+    BTreeInner *path[BTREE_MAX_HEIGHT];
+    int slots[BTREE_MAX_HEIGHT];
+    BTreeNode *spares[BTREE_MAX_HEIGHT + 1];
+    BTreeNode *node;
+    BTreeNode *child;
+    BTreeInner *inner;
+    BTreeInner *root;
+    BTreeLeaf *leaf;
+    BTreeLeaf *right;
+    int64_t separator;
+    int depth = 0;
+    int splits;
+    int needed;
+    int position;
+    int level;
+    int i;
+
+    if (tree->root == NULL) {
+        if ((leaf = btree_newLeaf()) == NULL) return false;
+        tree->root = &leaf->node;
+        tree->first = leaf;
+        tree->last = leaf;
+        tree->height = 1;
+    }
+
+    for (node = tree->root; !node->leaf; depth++) {
+        path[depth] = (BTreeInner *) node;
+        slots[depth] = btree_rank(node->keys, node->count, key, true);
+        node = path[depth]->children[slots[depth]];
+    }
+    leaf = (BTreeLeaf *) node;
+    position = btree_rank(node->keys, node->count, key, false);
+    if (position < node->count && node->keys[position] == key) return false;
+
+    if (node->count < BTREE_NODE_KEYS) {
+        memmove(&node->keys[position + 1], &node->keys[position], (node->count - position) * sizeof(int64_t));
+        memmove(&leaf->values[position + 1], &leaf->values[position], (node->count - position) * sizeof(void *));
+        node->keys[position] = key;
+        leaf->values[position] = (void *) value;
+        node->count++;
+        tree->size++;
+        return true;
+    }
+
+    // Allocate every node of the split cascade first, so a failed allocation leaves the tree unchanged
+    for (splits = 1; splits <= depth && path[depth - splits]->node.count == BTREE_NODE_KEYS; splits++);
+    needed = splits > depth ? splits + 1 : splits;
+    for (i = 0; i < needed; i++) {
+        spares[i] = i == 0 ? (BTreeNode *) btree_newLeaf() : (BTreeNode *) btree_newInner();
+        if (spares[i] == NULL) {
+            while (i > 0) free(spares[--i]);
+            return false;
+        }
+    }
+
+    right = (BTreeLeaf *) spares[0];
+    separator = btree_splitLeaf(leaf, right, position, key, value);
+    right->previous = leaf;
+    right->next = leaf->next;
+    if (leaf->next != NULL) leaf->next->previous = right;
+    else tree->last = right;
+    leaf->next = right;
+    tree->size++;
+
+    child = spares[0];
+    for (level = depth - 1, i = 1; level >= 0; level--, i++) {
+        inner = path[level];
+        position = slots[level];
+        if (inner->node.count < BTREE_NODE_KEYS) {
+            memmove(&inner->node.keys[position + 1], &inner->node.keys[position],
+                    (inner->node.count - position) * sizeof(int64_t));
+            memmove(&inner->children[position + 2], &inner->children[position + 1],
+                    (inner->node.count - position) * sizeof(BTreeNode *));
+            inner->node.keys[position] = separator;
+            inner->children[position + 1] = child;
+            inner->node.count++;
+            return true;
+        }
+        separator = btree_splitInner(inner, (BTreeInner *) spares[i], position, separator, child);
+        child = spares[i];
+    }
+
+    // The root was split, the tree grows by one level
+    root = (BTreeInner *) spares[splits];
+    root->node.count = 1;
+    root->node.keys[0] = separator;
+    root->children[0] = tree->root;
+    root->children[1] = child;
+    tree->root = &root->node;
+    tree->height++;
+    return true;
+}
+
+bool btree_remove(BTree *tree, int64_t key, void **value) {
+    BTreeInner *path[BTREE_MAX_HEIGHT];
+    int slots[BTREE_MAX_HEIGHT];
+    BTreeNode *node;
+    BTreeNode *root;
+    BTreeLeaf *leaf;
+    int depth = 0;
+    int position;
+    int level;
+
+    if (tree->root == NULL) return false;
+    for (node = tree->root; !node->leaf; depth++) {
+        path[depth] = (BTreeInner *) node;
+        slots[depth] = btree_rank(node->keys, node->count, key, true);
+        node = path[depth]->children[slots[depth]];
+    }
+    leaf = (BTreeLeaf *) node;
+    position = btree_rank(node->keys, node->count, key, false);
+    if (position == node->count || node->keys[position] != key) return false;
+
+    if (value != NULL) *value = leaf->values[position];
+    memmove(&node->keys[position], &node->keys[position + 1], (node->count - position - 1) * sizeof(int64_t));
+    memmove(&leaf->values[position], &leaf->values[position + 1], (node->count - position - 1) * sizeof(void *));
+    node->count--;
+    tree->size--;
+
+    // Fix the underflows bottom-up, a merge may make the parent underflow
+    for (level = depth - 1; level >= 0 && node->count < BTREE_MIN_KEYS; level--) {
+        if (!btree_rebalance(tree, path[level], slots[level])) break;
+        node = &path[level]->node;
+    }
+
+    root = tree->root;
+    if (root->count == 0) {
+        if (root->leaf) {
+            free(root);
+            btree_create(tree, tree->destroy);
+        } else {
+            tree->root = ((BTreeInner *) root)->children[0];
+            tree->height--;
+            free(root);
+        }
+    }
+    return true;
+}
+
+bool btree_find(const BTree *tree, int64_t key, void **value) {
+    const BTreeLeaf *leaf;
+    int position;
+
+    if (tree->root == NULL) return false;
+    leaf = btree_findLeaf(tree, key);
+    position = btree_rank(leaf->node.keys, leaf->node.count, key, false);
+    if (position == leaf->node.count || leaf->node.keys[position] != key) return false;
+    if (value != NULL) *value = leaf->values[position];
+    return true;
+}
+
+bool btree_bulkLoad(BTree *tree, const int64_t *keys, void *const *values, int count) {
+    BTreeNode **nodes;
+    int64_t *lows;
+    BTreeLeaf *leaf;
+    BTreeLeaf *previous = NULL;
+    BTreeInner *inner;
+    int level_size;
+    int parents;
+    int height = 1;
+    int consumed;
+    int offset = 0;
+    bool failed = false;
+    int taken;
+    int base;
+    int extra;
+    int i;
+    int j;
+
+    if (tree->root != NULL || count < 0) return false;
+    for (i = 1; i < count; i++) {
+        if (keys[i] <= keys[i - 1]) return false;
+    }
+    if (count == 0) return true;
+
+    level_size = (count + BTREE_NODE_KEYS - 1) / BTREE_NODE_KEYS;
+    nodes = (BTreeNode **) malloc(level_size * sizeof(BTreeNode *));
+    lows = (int64_t *) malloc(level_size * sizeof(int64_t));
+    if (nodes == NULL || lows == NULL) {
+        free(nodes);
+        free(lows);
+        return false;
+    }
+
+    // Spread the keys evenly, so every leaf holds at least BTREE_MIN_KEYS keys
+    base = count / level_size;
+    extra = count % level_size;
+    consumed = level_size;
+    for (i = 0; i < level_size; i++) {
+        if ((leaf = btree_newLeaf()) == NULL) {
+            failed = true;
+            break;
+        }
+        taken = base + (i < extra ? 1 : 0);
+        memcpy(leaf->node.keys, &keys[offset], taken * sizeof(int64_t));
+        for (j = 0; j < taken; j++) leaf->values[j] = values != NULL ? values[offset + j] : NULL;
+        leaf->node.count = taken;
+        leaf->previous = previous;
+        if (previous != NULL) previous->next = leaf;
+        else tree->first = leaf;
+        previous = leaf;
+        nodes[i] = &leaf->node;
+        lows[i] = keys[offset];
+        offset += taken;
+    }
+    tree->last = previous;
+
+    // Build the inner levels bottom-up, parents are written in place of their already consumed children
+    while (!failed && level_size > 1) {
+        parents = (level_size + BTREE_NODE_KEYS) / (BTREE_NODE_KEYS + 1);
+        base = level_size / parents;
+        extra = level_size % parents;
+        consumed = 0;
+        for (i = 0; i < parents; i++) {
+            if ((inner = btree_newInner()) == NULL) {
+                failed = true;
+                break;
+            }
+            taken = base + (i < extra ? 1 : 0);
+            for (j = 0; j < taken; j++) {
+                inner->children[j] = nodes[consumed + j];
+                if (j > 0) inner->node.keys[j - 1] = lows[consumed + j];
+            }
+            inner->node.count = taken - 1;
+            lows[i] = lows[consumed];
+            nodes[i] = &inner->node;
+            consumed += taken;
+        }
+        if (failed) break;
+        level_size = parents;
+        height++;
+    }
+
+    if (failed) {
+        // Built nodes own the consumed ones, the remaining nodes of the level are still unowned
+        for (j = 0; j < i; j++) btree_freeNode(nodes[j]);
+        for (j = consumed; j < level_size; j++) btree_freeNode(nodes[j]);
+        btree_create(tree, tree->destroy);
+    } else {
+        tree->root = nodes[0];
+        tree->height = height;
+        tree->size = count;
+    }
+    free(nodes);
+    free(lows);
+    return !failed;
+}
+
+bool btree_first(const BTree *tree, BTreeIterator *iterator) {
+    iterator->leaf = tree->first;
+    iterator->index = 0;
+    return iterator->leaf != NULL;
+}
+
+bool btree_seek(const BTree *tree, int64_t key, BTreeIterator *iterator) {
+    const BTreeLeaf *leaf;
+    int position;
+
+    if (tree->root == NULL) {
+        iterator->leaf = NULL;
+        iterator->index = 0;
+        return false;
+    }
+    leaf = btree_findLeaf(tree, key);
+    position = btree_rank(leaf->node.keys, leaf->node.count, key, false);
+    if (position == leaf->node.count) {
+        leaf = leaf->next;
+        position = 0;
+    }
+    iterator->leaf = leaf;
+    iterator->index = position;
+    return leaf != NULL;
+}
+
+bool btree_next(BTreeIterator *iterator) {
+    if (++iterator->index < iterator->leaf->node.count) return true;
+    iterator->leaf = iterator->leaf->next;
+    iterator->index = 0;
+    return iterator->leaf != NULL;
+}
+
+bool btree_range(const BTree *tree, int64_t low, int64_t high, bool (*visit)(int64_t key, void *value, void *data),
+                 void *data) {
+    BTreeIterator iterator;
+    bool valid;
+
+    for (valid = btree_seek(tree, low, &iterator); valid; valid = btree_next(&iterator)) {
+        if (btree_key(&iterator) > high) break;
+        if (!visit(btree_key(&iterator), btree_value(&iterator), data)) return false;
+    }
+    return true;
+}
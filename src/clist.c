@@ -4,6 +4,11 @@
 
 #include "collections_utils.h"
 
+/**
+ * @brief Number of pending runs of the list sort, the run i holds 2^i elements so they cover any int size
+ */
+#define CLIST_SORT_RUNS 32
+
 void clist_create(CLinkedList *list, void (*destroy)(void *value)) {
     list->size = 0;
     list->destroy = destroy;
@@ -97,6 +102,62 @@ bool clist_replace(CLinkedList *list, CLinkedElement *element, void **value) {
 }
 
 
+/**
+ * @brief Private method to merge two sorted chains of elements, ties take the left element first to keep the sort stable
+ * @return The first element of the merged chain, the last one links to NULL
+ */
+static CLinkedElement *clist_merge(CLinkedElement *left, CLinkedElement *right,
+                                   int (*compare)(const void *key1, const void *key2)) {
+    CLinkedElement merged;
+    CLinkedElement *last = &merged;
+
+    while (left != NULL && right != NULL) {
+        if (compare(right->value, left->value) < 0) {
+            last->next = right;
+            right = right->next;
+        } else {
+            last->next = left;
+            left = left->next;
+        }
+        last = last->next;
+    }
+    last->next = left != NULL ? left : right;
+    return merged.next;
+}
+
+void clist_sort(CLinkedList *list, int (*compare)(const void *key1, const void *key2)) {
+    CLinkedElement *runs[CLIST_SORT_RUNS] = {NULL};
+    CLinkedElement *element = list->head;
+    CLinkedElement *run;
+    int count;
+    int i;
+
+    if (clist_size(list) < 2) return;
+
+    // The circle is opened while the size elements from the head are carried through the pending runs
+    for (count = clist_size(list); count > 0; count--) {
+        run = element;
+        element = element->next;
+        run->next = NULL;
+        for (i = 0; runs[i] != NULL; i++) {
+            run = clist_merge(runs[i], run, compare);
+            runs[i] = NULL;
+        }
+        runs[i] = run;
+    }
+
+    // The longest pending runs hold the first elements of the list
+    run = NULL;
+    for (i = 0; i < CLIST_SORT_RUNS; i++) {
+        if (runs[i] != NULL) run = run == NULL ? runs[i] : clist_merge(runs[i], run, compare);
+    }
+
+    // The lowest value becomes the head and the last element closes the circle
+    list->head = run;
+    for (element = run; element->next != NULL; element = element->next);
+    element->next = run;
+}
+
 void **clist_toArray(CLinkedList *list) {
     if (list == NULL || list->size == 0) return NULL;
     void **result;
@@ -4,6 +4,11 @@
 
 #include "collections_utils.h"
 
+/**
+ * @brief Number of pending runs of the list sort, the run i holds 2^i elements so they cover any int size
+ */
+#define DLIST_SORT_RUNS 32
+
 void dlist_create(DLinkedList *list, void( *destroy)(void *value)) {
     // Default values
     list->size = 0;
@@ -159,6 +164,62 @@ bool dlist_replace(DLinkedList *list, DLinkedElement *element, void **value) {
 }
 
 
+/**
+ * @brief Private method to merge two sorted chains of elements, ties take the left element first to keep the sort stable
+ * @return The first element of the merged chain, the last one links to NULL
+ */
+static DLinkedElement *dlist_merge(DLinkedElement *left, DLinkedElement *right,
+                                   int (*compare)(const void *key1, const void *key2)) {
+    DLinkedElement merged;
+    DLinkedElement *last = &merged;
+
+    while (left != NULL && right != NULL) {
+        if (compare(right->value, left->value) < 0) {
+            last->next = right;
+            right = right->next;
+        } else {
+            last->next = left;
+            left = left->next;
+        }
+        last = last->next;
+    }
+    last->next = left != NULL ? left : right;
+    return merged.next;
+}
+
+void dlist_sort(DLinkedList *list, int (*compare)(const void *key1, const void *key2)) {
+    DLinkedElement *runs[DLIST_SORT_RUNS] = {NULL};
+    DLinkedElement *element = list->head;
+    DLinkedElement *run;
+    int i;
+
+    if (dlist_size(list) < 2) return;
+
+    // Runs are merged on the next links only, each element is carried through the pending runs like a binary counter
+    while (element != NULL) {
+        run = element;
+        element = element->next;
+        run->next = NULL;
+        for (i = 0; runs[i] != NULL; i++) {
+            run = dlist_merge(runs[i], run, compare);
+            runs[i] = NULL;
+        }
+        runs[i] = run;
+    }
+
+    // The longest pending runs hold the first elements of the list
+    run = NULL;
+    for (i = 0; i < DLIST_SORT_RUNS; i++) {
+        if (runs[i] != NULL) run = run == NULL ? runs[i] : dlist_merge(runs[i], run, compare);
+    }
+
+    // The previous links are rebuilt in a single final walk
+    list->head = run;
+    run->previous = NULL;
+    for (element = run; element->next != NULL; element = element->next) element->next->previous = element;
+    list->tail = element;
+}
+
 void **dlist_toArray(DLinkedList *list) {
     if (list == NULL || list->size == 0) return NULL;
     void **result;
@@ -0,0 +1,134 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#include "eytree.h"
+
+/**
+ * @brief Private method to prefetch the cache line of a key, a line holds the eight descendants of a node three
+ * levels below
+ */
+static void eytree_prefetch(const int64_t *address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#else
+    (void) address;
+#endif
+}
+
+/**
+ * @brief Private method to evaluate the first Eytzinger index of an in-order walk, the leftmost node
+ */
+static int eytree_leftmost(int index, int size) {
+    while (2 * index <= size) index = 2 * index;
+    return index;
+}
+
+/**
+ * @brief Private method to evaluate the in-order successor of an Eytzinger index, 0 after the last index
+ */
+static int eytree_successor(int index, int size) {
+    if (2 * index + 1 <= size) return eytree_leftmost(2 * index + 1, size);
+    // Climb while the index is a right child, its parent is then the successor
+    while (index & 1) index >>= 1;
+    return index >> 1;
+}
+
+/**
+ * @brief Private method to allocate the keys and the values of a tree in a single block
+ */
+static bool eytree_allocate(EytzingerTree *tree, int size, void (*destroy)(void *value)) {
+    if (size < 0) return false;
+    if ((tree->keys = (int64_t *) malloc((size + 1) * (sizeof(int64_t) + sizeof(void *)))) == NULL) return false;
+    tree->values = (void **) (tree->keys + size + 1);
+    tree->keys[0] = 0;
+    tree->values[0] = NULL;
+    tree->size = size;
+    tree->destroy = destroy;
+    return true;
+}
+
+bool eytree_create(EytzingerTree *tree, const int64_t *keys, void *const *values, int size,
+                   void (*destroy)(void *value)) {
+    int index;
+    int i;
+
+    for (i = 1; i < size; i++) {
+        if (keys[i - 1] > keys[i]) return false;
+    }
+    if (!eytree_allocate(tree, size, destroy)) return false;
+
+    // An in-order walk of the implicit tree meets the indexes in the order of the sorted keys
+    index = eytree_leftmost(1, size);
+    for (i = 0; i < size; i++) {
+        tree->keys[index] = keys[i];
+        tree->values[index] = values != NULL ? values[i] : NULL;
+        index = eytree_successor(index, size);
+    }
+    return true;
+}
+
+bool eytree_createFromArray(EytzingerTree *tree, void *const *values, int size, int64_t (*key)(const void *value),
+                            void (*destroy)(void *value)) {
+    int64_t previous = INT64_MIN;
+    int64_t current;
+    int index;
+    int i;
+
+    if (!eytree_allocate(tree, size, destroy)) return false;
+
+    index = eytree_leftmost(1, size);
+    for (i = 0; i < size; i++) {
+        if ((current = key(values[i])) < previous) {
+            free(tree->keys);
+            tree->keys = NULL;
+            tree->values = NULL;
+            tree->size = 0;
+            return false;
+        }
+        tree->keys[index] = previous = current;
+        tree->values[index] = values[i];
+        index = eytree_successor(index, size);
+    }
+    return true;
+}
+
+void eytree_destroy(EytzingerTree *tree) {
+    int i;
+
+    if (tree->destroy != NULL) {
+        for (i = 1; i <= tree->size; i++) tree->destroy(tree->values[i]);
+    }
+    free(tree->keys);
+    tree->keys = NULL;
+    tree->values = NULL;
+    tree->size = 0;
+}
+
+int eytree_lowerBound(const EytzingerTree *tree, int64_t key) {
+    const int64_t *keys = tree->keys;
+    unsigned int size = (unsigned int) tree->size;
+    unsigned int index = 1;
+
+    // The next index is computed from the comparison, compilers emit a conditional move instead of a branch
+    while (index <= size) {
+        if (8 * index <= size) eytree_prefetch(&keys[8 * index]);
+        index = 2 * index + (keys[index] < key);
+    }
+
+    // The trailing bits record the right turns over lower keys since the last left turn, that is dropped too
+#if defined(__GNUC__) || defined(__clang__)
+    return (int) (index >> __builtin_ffs((int) ~index));
+#else
+    while (index & 1) index >>= 1;
+    return (int) (index >> 1);
+#endif
+}
+
+bool eytree_find(const EytzingerTree *tree, int64_t key, void **value) {
+    int index = eytree_lowerBound(tree, key);
+
+    if (index == 0 || tree->keys[index] != key) return false;
+    if (value != NULL) *value = tree->values[index];
+    return true;
+}
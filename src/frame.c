@@ -33,4 +33,18 @@ bool frame_destroy(LinkedList *frames, int frame_id) {
     if (!list_add(frames, NULL, value)) return false;
 
     return true;
-}
\ No newline at end of file
+}
+
+int frame_allocBitSet(BitSet *frames) {
+    int frame_id;
+
+    // If no frame available
+    if ((frame_id = bitset_nextSet(frames, 0)) < 0) return -1;
+    bitset_clear(frames, frame_id);
+    return frame_id;
+}
+
+bool frame_destroyBitSet(BitSet *frames, int frame_id) {
+    // Replacing the current frame in the available pages
+    return bitset_set(frames, frame_id);
+}
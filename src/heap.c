@@ -0,0 +1,366 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#include <limits.h>
+#include "heap.h"
+
+/**
+ * @brief Minimal number of slots of a heap
+ */
+#define HEAP_MIN_CAPACITY 16
+
+/**
+ * @brief Position of a free handle, it encodes the next free handle since -1 marks the handles never used
+ */
+#define HEAP_FREE_LINK(next) (-2 - (next))
+
+/**
+ * @brief Private method to grow the slots of a heap to hold at least the given number of values
+ * @return true if the heap holds the values, false if the allocation failed
+ */
+static bool heap_grow(Heap *heap, int size) {
+    void **values;
+    int *handles;
+    int *positions;
+    int capacity = heap->capacity < HEAP_MIN_CAPACITY ? HEAP_MIN_CAPACITY : heap->capacity;
+    int i;
+
+    if (size <= heap->capacity) return true;
+    while (capacity < size) capacity = capacity > INT_MAX / 2 ? INT_MAX : 2 * capacity;
+
+    // The arrays already grown are kept on failure, the capacity only counts the slots of all of them
+    if ((values = (void **) realloc(heap->values, capacity * sizeof(void *))) == NULL) return false;
+    heap->values = values;
+    if ((handles = (int *) realloc(heap->handles, capacity * sizeof(int))) == NULL) return false;
+    heap->handles = handles;
+    if ((positions = (int *) realloc(heap->positions, capacity * sizeof(int))) == NULL) return false;
+    heap->positions = positions;
+    for (i = heap->capacity; i < capacity; i++) positions[i] = -1;
+    heap->capacity = capacity;
+    return true;
+}
+
+/**
+ * @brief Private method to store a value and its handle at a position
+ */
+static void heap_place(Heap *heap, int position, void *value, int handle) {
+    heap->values[position] = value;
+    heap->handles[position] = handle;
+    heap->positions[handle] = position;
+}
+
+/**
+ * @brief Private method to move the value of a position up while it goes before its parent
+ * @return The final position of the value
+ */
+static int heap_siftUp(Heap *heap, int position) {
+    void *value = heap->values[position];
+    int handle = heap->handles[position];
+    int parent;
+
+    // The value is written once, its ancestors are moved down on its path
+    while (position > 0) {
+        parent = (position - 1) / heap->arity;
+        if (heap->compare(value, heap->values[parent]) >= 0) break;
+        heap_place(heap, position, heap->values[parent], heap->handles[parent]);
+        position = parent;
+    }
+    heap_place(heap, position, value, handle);
+    return position;
+}
+
+/**
+ * @brief Private method to move the value of a position down while a child goes before it
+ */
+static void heap_siftDown(Heap *heap, int position) {
+    void *value = heap->values[position];
+    int handle = heap->handles[position];
+    size_t first;
+    size_t last;
+    size_t child;
+    size_t best;
+
+    for (;;) {
+        first = (size_t) position * heap->arity + 1;
+        if (first >= (size_t) heap->size) break;
+        last = first + heap->arity < (size_t) heap->size ? first + heap->arity : (size_t) heap->size;
+        best = first;
+        for (child = first + 1; child < last; child++) {
+            if (heap->compare(heap->values[child], heap->values[best]) < 0) best = child;
+        }
+        if (heap->compare(heap->values[best], value) >= 0) break;
+        heap_place(heap, position, heap->values[best], heap->handles[best]);
+        position = (int) best;
+    }
+    heap_place(heap, position, value, handle);
+}
+
+/**
+ * @brief Private method to release the handle of the value at a position and fill the position with the last value
+ */
+static void heap_take(Heap *heap, int position) {
+    int handle = heap->handles[position];
+
+    heap->positions[handle] = HEAP_FREE_LINK(heap->freeHandles);
+    heap->freeHandles = handle;
+    if (position == --heap->size) return;
+    heap_place(heap, position, heap->values[heap->size], heap->handles[heap->size]);
+    if (heap_siftUp(heap, position) == position) heap_siftDown(heap, position);
+}
+
+/**
+ * @brief Private method to determine if a handle holds a value of the heap
+ */
+static bool heap_isHandle(const Heap *heap, int handle) {
+    return handle >= 0 && handle < heap->capacity && heap->positions[handle] >= 0;
+}
+
+void heap_create(Heap *heap, int arity, int (*compare)(const void *key1, const void *key2),
+                 void (*destroy)(void *value)) {
+    heap->size = 0;
+    heap->capacity = 0;
+    heap->arity = arity < 2 ? HEAP_DEFAULT_ARITY : arity;
+    heap->freeHandles = -1;
+    heap->compare = compare;
+    heap->destroy = destroy;
+    heap->values = NULL;
+    heap->handles = NULL;
+    heap->positions = NULL;
+}
+
+void heap_destroy(Heap *heap) {
+    int i;
+
+    if (heap->destroy != NULL) {
+        for (i = 0; i < heap->size; i++) heap->destroy(heap->values[i]);
+    }
+    free(heap->values);
+    free(heap->handles);
+    free(heap->positions);
+    heap_create(heap, heap->arity, heap->compare, heap->destroy);
+}
+
+bool heap_reserve(Heap *heap, int size) {
+    if (size < 0) return false;
+    return heap_grow(heap, size);
+}
+
+bool heap_heapify(Heap *heap, void *const *values, int size) {
+    int i;
+
+    if (heap->size > 0 || size < 0 || !heap_grow(heap, size)) return false;
+
+    // Handles of the previous values are dropped, the new ones are the array indexes
+    heap->freeHandles = -1;
+    for (i = 0; i < heap->capacity; i++) heap->positions[i] = -1;
+    for (i = 0; i < size; i++) heap_place(heap, i, values[i], i);
+    heap->size = size;
+
+    // Bottom-up construction, the parents of the last level are sifted down first
+    for (i = (size - 2) / heap->arity; size > 1 && i >= 0; i--) heap_siftDown(heap, i);
+    return true;
+}
+
+int heap_push(Heap *heap, const void *value) {
+    int handle;
+
+    if (heap->size == INT_MAX || !heap_grow(heap, heap->size + 1)) return -1;
+
+    // Without free handle, the handles in use are exactly 0 to size - 1
+    if (heap->freeHandles >= 0) {
+        handle = heap->freeHandles;
+        heap->freeHandles = HEAP_FREE_LINK(heap->positions[handle]);
+    } else {
+        handle = heap->size;
+    }
+    heap_place(heap, heap->size++, (void *) value, handle);
+    heap_siftUp(heap, heap->size - 1);
+    return handle;
+}
+
+bool heap_pop(Heap *heap, void **value) {
+    if (heap->size == 0) return false;
+    *value = heap->values[0];
+    heap_take(heap, 0);
+    return true;
+}
+
+bool heap_update(Heap *heap, int handle, const void *value) {
+    int position;
+
+    if (!heap_isHandle(heap, handle)) return false;
+    position = heap->positions[handle];
+    heap->values[position] = (void *) value;
+    if (heap_siftUp(heap, position) == position) heap_siftDown(heap, position);
+    return true;
+}
+
+bool heap_remove(Heap *heap, int handle, void **value) {
+    if (!heap_isHandle(heap, handle)) return false;
+    *value = heap->values[heap->positions[handle]];
+    heap_take(heap, heap->positions[handle]);
+    return true;
+}
+
+/**
+ * @brief Private method to link two trees, the root going after the other becomes its first child
+ * @return The root of the linked tree, its sibling and previous links are left to the caller
+ */
+static PairingHeapNode *pheap_link(const PairingHeap *heap, PairingHeapNode *first, PairingHeapNode *second) {
+    PairingHeapNode *temp;
+
+    if (heap->compare(second->value, first->value) < 0) {
+        temp = first;
+        first = second;
+        second = temp;
+    }
+    second->previous = first;
+    second->sibling = first->child;
+    if (first->child != NULL) first->child->previous = second;
+    first->child = second;
+    return first;
+}
+
+/**
+ * @brief Private method to link a list of sibling trees with the two-pass pairing, without recursion
+ * @return The root of the resulting tree, NULL for an empty list
+ */
+static PairingHeapNode *pheap_combine(const PairingHeap *heap, PairingHeapNode *first) {
+    PairingHeapNode *pairs = NULL;
+    PairingHeapNode *result;
+    PairingHeapNode *next;
+
+    // Pairs are linked from left to right and stacked on their sibling link
+    while (first != NULL) {
+        if (first->sibling == NULL) {
+            next = NULL;
+        } else {
+            next = first->sibling->sibling;
+            first = pheap_link(heap, first, first->sibling);
+        }
+        first->sibling = pairs;
+        pairs = first;
+        first = next;
+    }
+
+    // The stack pops the pairs from right to left, each one is linked to the accumulated tree
+    if ((result = pairs) == NULL) return NULL;
+    pairs = pairs->sibling;
+    while (pairs != NULL) {
+        next = pairs->sibling;
+        result = pheap_link(heap, result, pairs);
+        pairs = next;
+    }
+    result->sibling = NULL;
+    result->previous = NULL;
+    return result;
+}
+
+/**
+ * @brief Private method to unlink a node that isn't the root from its parent and its siblings
+ */
+static void pheap_detach(PairingHeapNode *node) {
+    if (node->previous->child == node)
+        node->previous->child = node->sibling;
+    else
+        node->previous->sibling = node->sibling;
+    if (node->sibling != NULL) node->sibling->previous = node->previous;
+    node->sibling = NULL;
+    node->previous = NULL;
+}
+
+/**
+ * @brief Private method to link a detached tree to the root of the heap
+ */
+static void pheap_insert(PairingHeap *heap, PairingHeapNode *node) {
+    if (node == NULL) return;
+    if (heap->root == NULL) {
+        heap->root = node;
+        return;
+    }
+    heap->root = pheap_link(heap, heap->root, node);
+    heap->root->sibling = NULL;
+    heap->root->previous = NULL;
+}
+
+void pheap_create(PairingHeap *heap, int (*compare)(const void *key1, const void *key2),
+                  void (*destroy)(void *value)) {
+    heap->size = 0;
+    heap->compare = compare;
+    heap->destroy = destroy;
+    heap->root = NULL;
+}
+
+void pheap_destroy(PairingHeap *heap) {
+    PairingHeapNode *node = heap->root;
+    PairingHeapNode *next;
+
+    // Children are rotated up until the tree is a sibling chain, as for a left-child right-sibling binary tree
+    while (node != NULL) {
+        if (node->child != NULL) {
+            next = node->child;
+            node->child = next->sibling;
+            next->sibling = node;
+        } else {
+            next = node->sibling;
+            if (heap->destroy != NULL) heap->destroy(node->value);
+            free(node);
+        }
+        node = next;
+    }
+    heap->root = NULL;
+    heap->size = 0;
+}
+
+PairingHeapNode *pheap_push(PairingHeap *heap, const void *value) {
+    PairingHeapNode *node;
+
+    if ((node = (PairingHeapNode *) malloc(sizeof(PairingHeapNode))) == NULL) return NULL;
+    node->value = (void *) value;
+    node->child = NULL;
+    node->sibling = NULL;
+    node->previous = NULL;
+    pheap_insert(heap, node);
+    heap->size++;
+    return node;
+}
+
+bool pheap_pop(PairingHeap *heap, void **value) {
+    PairingHeapNode *root = heap->root;
+
+    if (root == NULL) return false;
+    *value = root->value;
+    heap->root = pheap_combine(heap, root->child);
+    heap->size--;
+    free(root);
+    return true;
+}
+
+bool pheap_decreaseKey(PairingHeap *heap, PairingHeapNode *node, const void *value) {
+    if (value != node->value && heap->compare(value, node->value) > 0) return false;
+    node->value = (void *) value;
+    if (node == heap->root) return true;
+    pheap_detach(node);
+    pheap_insert(heap, node);
+    return true;
+}
+
+void pheap_remove(PairingHeap *heap, PairingHeapNode *node, void **value) {
+    if (node == heap->root) {
+        pheap_pop(heap, value);
+        return;
+    }
+    *value = node->value;
+    pheap_detach(node);
+    pheap_insert(heap, pheap_combine(heap, node->child));
+    heap->size--;
+    free(node);
+}
+
+void pheap_merge(PairingHeap *heap, PairingHeap *other) {
+    pheap_insert(heap, other->root);
+    heap->size += other->size;
+    other->root = NULL;
+    other->size = 0;
+}
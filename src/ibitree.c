@@ -0,0 +1,256 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#include <string.h>
+#include "ibitree.h"
+
+/**
+ * @brief Right link of the free slots, it can't be the index of a used slot
+ */
+#define IBITREE_FREE UINT32_MAX
+
+/**
+ * @brief Minimal number of slots of a node array
+ */
+#define IBITREE_MIN_CAPACITY 16u
+
+/**
+ * @brief Private method to grow the node array to hold at least the given number of slots
+ * @return true if the array holds the slots, false if the allocation failed
+ */
+static bool ibitree_grow(IndexedBinaryTree *tree, uint32_t slots) {
+    IndexedBinaryTreeNode *nodes;
+    uint32_t capacity = tree->capacity < IBITREE_MIN_CAPACITY ? IBITREE_MIN_CAPACITY : tree->capacity;
+
+    if (slots <= tree->capacity) return true;
+    if (slots >= IBITREE_FREE) return false;
+    while (capacity < slots) capacity = capacity > IBITREE_FREE / 2 ? IBITREE_FREE - 1 : 2 * capacity;
+    if ((nodes = (IndexedBinaryTreeNode *) realloc(tree->nodes, capacity * sizeof(IndexedBinaryTreeNode))) == NULL)
+        return false;
+    tree->nodes = nodes;
+    tree->capacity = capacity;
+    return true;
+}
+
+/**
+ * @brief Private method to take a slot from the free list or from the end of the node array
+ * @return The index of the slot, IBITREE_NULL if the allocation failed
+ */
+static uint32_t ibitree_allocate(IndexedBinaryTree *tree, const void *value) {
+    uint32_t node = tree->freeSlots;
+
+    if (node != IBITREE_NULL) {
+        tree->freeSlots = tree->nodes[node].left;
+    } else {
+        if (!ibitree_grow(tree, tree->count + 1)) return IBITREE_NULL;
+        node = tree->count++;
+    }
+    tree->nodes[node].value = (void *) value;
+    tree->nodes[node].left = IBITREE_NULL;
+    tree->nodes[node].right = IBITREE_NULL;
+    return node;
+}
+
+/**
+ * @brief Private method to add a child, the link is written once the slot is allocated since the array can move
+ */
+static bool ibitree_add(IndexedBinaryTree *tree, uint32_t node, const void *value, bool left) {
+    uint32_t new_node;
+
+    if (node == IBITREE_NULL) {
+        // For empty trees, we insert as root
+        if (tree->size > 0) return false;
+    } else if ((left ? tree->nodes[node].left : tree->nodes[node].right) != IBITREE_NULL) {
+        return false;
+    }
+    if ((new_node = ibitree_allocate(tree, value)) == IBITREE_NULL) return false;
+
+    if (node == IBITREE_NULL)
+        tree->root = new_node;
+    else if (left)
+        tree->nodes[node].left = new_node;
+    else
+        tree->nodes[node].right = new_node;
+    tree->size++;
+    return true;
+}
+
+/**
+ * @brief Private method to destroy a branch without recursion, left children are rotated up until the branch is a
+ * right chain whose slots go back to the free list
+ */
+static void ibitree_removeBranch(IndexedBinaryTree *tree, uint32_t node) {
+    IndexedBinaryTreeNode *nodes = tree->nodes;
+    uint32_t next;
+
+    while (node != IBITREE_NULL) {
+        if (nodes[node].left != IBITREE_NULL) {
+            // Right rotation, the left child becomes the current node
+            next = nodes[node].left;
+            nodes[node].left = nodes[next].right;
+            nodes[next].right = node;
+        } else {
+            next = nodes[node].right;
+            if (tree->destroy != NULL) tree->destroy(nodes[node].value);
+            nodes[node].value = NULL;
+            nodes[node].right = IBITREE_FREE;
+            nodes[node].left = tree->freeSlots;
+            tree->freeSlots = node;
+            tree->size--;
+        }
+        node = next;
+    }
+}
+
+/**
+ * @brief Private method to copy the slots of a tree after the given offset, links are shifted and free slots are
+ * chained to the free list of the output tree
+ */
+static void ibitree_copySlots(IndexedBinaryTree *out, const IndexedBinaryTree *tree, uint32_t offset) {
+    IndexedBinaryTreeNode *node;
+    uint32_t i;
+
+    if (tree->count <= 1) return;
+    memcpy(out->nodes + offset + 1, tree->nodes + 1, (tree->count - 1) * sizeof(IndexedBinaryTreeNode));
+    for (i = offset + 1; i < offset + tree->count; i++) {
+        node = &out->nodes[i];
+        if (node->right == IBITREE_FREE) {
+            node->left = out->freeSlots;
+            out->freeSlots = i;
+            continue;
+        }
+        if (node->left != IBITREE_NULL) node->left += offset;
+        if (node->right != IBITREE_NULL) node->right += offset;
+    }
+}
+
+/**
+ * @brief Private method to release the node array of a tree and leave it empty
+ */
+static void ibitree_clear(IndexedBinaryTree *tree) {
+    free(tree->nodes);
+    tree->nodes = NULL;
+    tree->size = 0;
+    tree->count = 1;
+    tree->capacity = 0;
+    tree->root = IBITREE_NULL;
+    tree->freeSlots = IBITREE_NULL;
+}
+
+void ibitree_create(IndexedBinaryTree *tree, void (*destroy)(void *value)) {
+    tree->nodes = NULL;
+    tree->destroy = destroy;
+    ibitree_clear(tree);
+}
+
+void ibitree_destroy(IndexedBinaryTree *tree) {
+    uint32_t i;
+
+    // Values are destroyed in memory order, the links don't have to be followed
+    if (tree->destroy != NULL) {
+        for (i = 1; i < tree->count; i++) {
+            if (tree->nodes[i].right != IBITREE_FREE) tree->destroy(tree->nodes[i].value);
+        }
+    }
+    ibitree_clear(tree);
+}
+
+bool ibitree_reserve(IndexedBinaryTree *tree, int size) {
+    if (size < 0) return false;
+    return ibitree_grow(tree, (uint32_t) size + 1);
+}
+
+bool ibitree_addLeft(IndexedBinaryTree *tree, uint32_t node, const void *value) {
+    return ibitree_add(tree, node, value, true);
+}
+
+bool ibitree_addRight(IndexedBinaryTree *tree, uint32_t node, const void *value) {
+    return ibitree_add(tree, node, value, false);
+}
+
+void ibitree_removeLeft(IndexedBinaryTree *tree, uint32_t node) {
+    uint32_t branch;
+
+    if (tree->size == 0) return;
+    if (node == IBITREE_NULL) {
+        branch = tree->root;
+        tree->root = IBITREE_NULL;
+    } else {
+        branch = tree->nodes[node].left;
+        tree->nodes[node].left = IBITREE_NULL;
+    }
+    ibitree_removeBranch(tree, branch);
+}
+
+void ibitree_removeRight(IndexedBinaryTree *tree, uint32_t node) {
+    uint32_t branch;
+
+    if (tree->size == 0) return;
+    if (node == IBITREE_NULL) {
+        branch = tree->root;
+        tree->root = IBITREE_NULL;
+    } else {
+        branch = tree->nodes[node].right;
+        tree->nodes[node].right = IBITREE_NULL;
+    }
+    ibitree_removeBranch(tree, branch);
+}
+
+bool ibitree_merge(IndexedBinaryTree *out, IndexedBinaryTree *left, IndexedBinaryTree *right, const void *value) {
+    uint32_t root;
+
+    ibitree_create(out, left->destroy);
+    if ((uint64_t) left->count + right->count >= IBITREE_FREE) return false;
+    if (!ibitree_grow(out, left->count + right->count)) return false;
+
+    // The root takes the slot 1, the left slots follow it and the right slots come last
+    root = ibitree_allocate(out, value);
+    ibitree_copySlots(out, left, 1);
+    ibitree_copySlots(out, right, left->count);
+    out->count = left->count + right->count;
+    out->nodes[root].left = left->root != IBITREE_NULL ? left->root + 1 : IBITREE_NULL;
+    out->nodes[root].right = right->root != IBITREE_NULL ? right->root + left->count : IBITREE_NULL;
+    out->root = root;
+    out->size = 1 + left->size + right->size;
+
+    // Original trees MUST not access to fusion nodes
+    ibitree_clear(left);
+    ibitree_clear(right);
+    return true;
+}
+
+bool ibitree_fromBitree(IndexedBinaryTree *out, BinaryTree *tree) {
+    BinaryTreeNode *node;
+    uint32_t head;
+    uint32_t child;
+
+    if (out->size > 0) return false;
+    out->count = 1;
+    out->freeSlots = IBITREE_NULL;
+    if (tree->root == NULL) return true;
+    if (!ibitree_reserve(out, tree->size)) return false;
+
+    // The slots are the BFS queue, a slot holds its source node until its children are enqueued
+    out->root = ibitree_allocate(out, tree->root);
+    for (head = out->root; head < out->count; head++) {
+        node = (BinaryTreeNode *) out->nodes[head].value;
+        if (node->left != NULL) {
+            if ((child = ibitree_allocate(out, node->left)) == IBITREE_NULL) break;
+            out->nodes[head].left = child;
+        }
+        if (node->right != NULL) {
+            if ((child = ibitree_allocate(out, node->right)) == IBITREE_NULL) break;
+            out->nodes[head].right = child;
+        }
+        out->nodes[head].value = node->value;
+    }
+
+    if (head < out->count) {
+        // The slots after the failure still hold source nodes, they are dropped without destroying values
+        ibitree_clear(out);
+        return false;
+    }
+    out->size = (int) (out->count - 1);
+    return true;
+}
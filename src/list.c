@@ -5,10 +5,18 @@
 #include <memory.h>
 #include "collections_utils.h"
 
+/**
+ * @brief Number of pending runs of the list sort, the run i holds 2^i elements so they cover any int size
+ */
+#define LIST_SORT_RUNS 32
+
 void list_create(LinkedList *list, void( *destroy)(void *value)) {
     // Init the list
     list->size = 0;
     list->destroy = destroy;
+    list->equals = NULL;
+    list->hash = NULL;
+    list->index = NULL;
     list->head = NULL;
     list->tail = NULL;
 }
@@ -118,6 +126,58 @@ bool list_replace(LinkedList *list, LinkedElement *element, void **value) {
     return true;
 }
 
+/**
+ * @brief Private method to merge two sorted chains of elements, ties take the left element first to keep the sort stable
+ * @return The first element of the merged chain, the last one links to NULL
+ */
+static LinkedElement *list_merge(LinkedElement *left, LinkedElement *right,
+                                 int (*compare)(const void *key1, const void *key2)) {
+    LinkedElement merged;
+    LinkedElement *last = &merged;
+
+    while (left != NULL && right != NULL) {
+        if (compare(right->value, left->value) < 0) {
+            last->next = right;
+            right = right->next;
+        } else {
+            last->next = left;
+            left = left->next;
+        }
+        last = last->next;
+    }
+    last->next = left != NULL ? left : right;
+    return merged.next;
+}
+
+void list_sort(LinkedList *list, int (*compare)(const void *key1, const void *key2)) {
+    LinkedElement *runs[LIST_SORT_RUNS] = {NULL};
+    LinkedElement *element = list->head;
+    LinkedElement *run;
+    int i;
+
+    if (list_size(list) < 2) return;
+
+    // Each element is a run of one carried through the pending runs like a binary counter, the run i holds 2^i elements
+    while (element != NULL) {
+        run = element;
+        element = element->next;
+        run->next = NULL;
+        for (i = 0; runs[i] != NULL; i++) {
+            run = list_merge(runs[i], run, compare);
+            runs[i] = NULL;
+        }
+        runs[i] = run;
+    }
+
+    // The longest pending runs hold the first elements of the list
+    run = NULL;
+    for (i = 0; i < LIST_SORT_RUNS; i++) {
+        if (runs[i] != NULL) run = run == NULL ? runs[i] : list_merge(runs[i], run, compare);
+    }
+    list->head = run;
+    for (list->tail = run; list->tail->next != NULL; list->tail = list->tail->next);
+}
+
 void **list_toArray(LinkedList *list) {
     if (list == NULL || list->size == 0) return NULL;
     void **result;
@@ -0,0 +1,259 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#include <sched.h>
+#include <unistd.h>
+#include "parallel_utils.h"
+
+/**
+ * @brief Range of indexes of a parallel_for chunk
+ */
+typedef struct ParallelRange {
+    /**
+     * @brief First index of the range
+     */
+    int begin;
+    /**
+     * @brief Index after the last index of the range
+     */
+    int end;
+    /**
+     * @brief Maximum number of indexes given to the body
+     */
+    int grain;
+    /**
+     * @brief User function applied on each chunk
+     */
+    void (*body)(int begin, int end, void *data);
+    /**
+     * @brief User data given to the body
+     */
+    void *data;
+} ParallelRange;
+
+/**
+ * @brief Private method to read the completion flag of a task, the results of the task are visible afterward
+ */
+static bool parallel_isDone(ParallelWorker *worker, ParallelTask *task) {
+#if defined(__GNUC__) || defined(__clang__)
+    (void) worker;
+    return __atomic_load_n(&task->done, __ATOMIC_ACQUIRE) != 0;
+#else
+    int done;
+
+    pthread_mutex_lock(&worker->pool->lock);
+    done = task->done;
+    pthread_mutex_unlock(&worker->pool->lock);
+    return done != 0;
+#endif
+}
+
+/**
+ * @brief Private method to run a task and publish its completion
+ */
+static void parallel_execute(ParallelWorker *worker, ParallelTask *task) {
+    task->run(worker, task->data);
+#if defined(__GNUC__) || defined(__clang__)
+    __atomic_store_n(&task->done, 1, __ATOMIC_RELEASE);
+#else
+    pthread_mutex_lock(&worker->pool->lock);
+    task->done = 1;
+    pthread_mutex_unlock(&worker->pool->lock);
+#endif
+}
+
+/**
+ * @brief Private method to update the number of pending tasks, sleeping workers are woken up by a new task
+ */
+static void parallel_addPending(ParallelPool *pool, int count) {
+    pthread_mutex_lock(&pool->lock);
+    pool->pending += count;
+    if (count > 0) pthread_cond_signal(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief Private method to take a task from a deque, the owner takes the newest task and the thieves the oldest
+ * @return The taken task, NULL if the deque is empty
+ */
+static ParallelTask *parallel_takeFrom(ParallelWorker *worker, bool owner) {
+    ParallelTask *task = NULL;
+
+    pthread_mutex_lock(&worker->lock);
+    if (worker->bottom > worker->top) {
+        task = owner ? worker->tasks[--worker->bottom] : worker->tasks[worker->top++];
+        if (worker->top == worker->bottom) worker->top = worker->bottom = 0;
+    }
+    pthread_mutex_unlock(&worker->lock);
+    if (task != NULL) parallel_addPending(worker->pool, -1);
+    return task;
+}
+
+/**
+ * @brief Private method to take a task of the worker, or else to steal one from a random victim
+ * @return The taken task, NULL if every deque is empty
+ */
+static ParallelTask *parallel_take(ParallelWorker *worker) {
+    ParallelPool *pool = worker->pool;
+    ParallelTask *task;
+    int start;
+    int i;
+
+    if ((task = parallel_takeFrom(worker, true)) != NULL) return task;
+    worker->seed = worker->seed * 1103515245u + 12345u;
+    start = (int) ((worker->seed >> 16) % (unsigned int) pool->threads);
+    for (i = 0; i < pool->threads; i++) {
+        ParallelWorker *victim = &pool->workers[(start + i) % pool->threads];
+        if (victim != worker && (task = parallel_takeFrom(victim, false)) != NULL) return task;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Private method running the loop of a pool thread, it sleeps while no task is pending
+ */
+static void *parallel_main(void *argument) {
+    ParallelWorker *worker = (ParallelWorker *) argument;
+    ParallelPool *pool = worker->pool;
+    ParallelTask *task;
+    bool stop;
+
+    for (;;) {
+        if ((task = parallel_take(worker)) != NULL) {
+            parallel_execute(worker, task);
+            continue;
+        }
+        pthread_mutex_lock(&pool->lock);
+        while (pool->pending == 0 && !pool->stop) pthread_cond_wait(&pool->wake, &pool->lock);
+        stop = pool->stop && pool->pending == 0;
+        pthread_mutex_unlock(&pool->lock);
+        if (stop) return NULL;
+    }
+}
+
+/**
+ * @brief Private method to split a range in halves until the chunks are under the grain
+ */
+static void parallel_forRange(ParallelWorker *worker, void *data) {
+    ParallelRange *range = (ParallelRange *) data;
+    ParallelRange left = *range;
+    ParallelRange right = *range;
+    ParallelTask task;
+
+    if (range->end - range->begin <= range->grain) {
+        range->body(range->begin, range->end, range->data);
+        return;
+    }
+    left.end = right.begin = range->begin + (range->end - range->begin) / 2;
+    parallel_fork(worker, &task, parallel_forRange, &right);
+    parallel_forRange(worker, &left);
+    parallel_join(worker, &task);
+}
+
+bool parallel_create(ParallelPool *pool, int threads) {
+    int i;
+
+    if (threads <= 0) threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads <= 0) threads = 1;
+    pool->threads = threads;
+    pool->pending = 0;
+    pool->stop = false;
+    if ((pool->workers = (ParallelWorker *) malloc(threads * sizeof(ParallelWorker))) == NULL) return false;
+    if ((pool->handles = (pthread_t *) malloc(threads * sizeof(pthread_t))) == NULL) {
+        free(pool->workers);
+        return false;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_mutex_init(&pool->run, NULL);
+    for (i = 0; i < threads; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].seed = (unsigned int) i * 2654435761u + 1u;
+        pool->workers[i].top = 0;
+        pool->workers[i].bottom = 0;
+        pthread_mutex_init(&pool->workers[i].lock, NULL);
+    }
+
+    // The worker 0 is the thread calling parallel_run
+    for (i = 1; i < threads; i++) {
+        if (pthread_create(&pool->handles[i], NULL, parallel_main, &pool->workers[i]) != 0) {
+            pool->threads = i;
+            parallel_destroy(pool);
+            return false;
+        }
+    }
+    return true;
+}
+
+void parallel_destroy(ParallelPool *pool) {
+    int i;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    for (i = 1; i < pool->threads; i++) pthread_join(pool->handles[i], NULL);
+
+    for (i = 0; i < pool->threads; i++) pthread_mutex_destroy(&pool->workers[i].lock);
+    pthread_mutex_destroy(&pool->run);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->handles);
+    free(pool->workers);
+    pool->handles = NULL;
+    pool->workers = NULL;
+    pool->threads = 0;
+}
+
+void parallel_run(ParallelPool *pool, void (*run)(ParallelWorker *worker, void *data), void *data) {
+    pthread_mutex_lock(&pool->run);
+    run(&pool->workers[0], data);
+    pthread_mutex_unlock(&pool->run);
+}
+
+void parallel_fork(ParallelWorker *worker, ParallelTask *task, void (*run)(ParallelWorker *worker, void *data),
+                   void *data) {
+    bool pushed = false;
+
+    task->run = run;
+    task->data = data;
+    task->done = 0;
+    if (worker->pool->threads > 1) {
+        // Counted before the push so sleeping workers never miss a task
+        parallel_addPending(worker->pool, 1);
+        pthread_mutex_lock(&worker->lock);
+        if (worker->bottom < PARALLEL_DEQUE_CAPACITY) {
+            worker->tasks[worker->bottom++] = task;
+            pushed = true;
+        }
+        pthread_mutex_unlock(&worker->lock);
+        if (!pushed) parallel_addPending(worker->pool, -1);
+    }
+    if (!pushed) parallel_execute(worker, task);
+}
+
+void parallel_join(ParallelWorker *worker, ParallelTask *task) {
+    ParallelTask *other;
+
+    // The newest task of the worker is usually the joined one, other tasks are run while it is stolen
+    while (!parallel_isDone(worker, task)) {
+        if ((other = parallel_take(worker)) != NULL)
+            parallel_execute(worker, other);
+        else
+            sched_yield();
+    }
+}
+
+void parallel_for(ParallelWorker *worker, int begin, int end, int grain,
+                  void (*body)(int begin, int end, void *data), void *data) {
+    ParallelRange range;
+
+    if (begin >= end) return;
+    range.begin = begin;
+    range.end = end;
+    range.grain = grain < 1 ? 1 : grain;
+    range.body = body;
+    range.data = data;
+    parallel_forRange(worker, &range);
+}
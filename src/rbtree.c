@@ -0,0 +1,423 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#include "rbtree.h"
+
+/**
+ * @brief Number of nodes of the first pool block, next blocks double up to RBTREE_BLOCK_MAX
+ */
+#define RBTREE_BLOCK_MIN 16
+
+/**
+ * @brief Maximum number of nodes of a pool block
+ */
+#define RBTREE_BLOCK_MAX 4096
+
+/**
+ * @brief Pool block of Red-Black tree nodes
+ */
+typedef struct RedBlackBlock {
+    /**
+     * @brief Next allocated block
+     */
+    struct RedBlackBlock *next;
+    /**
+     * @brief Nodes of the block
+     */
+    RedBlackNode nodes[];
+} RedBlackBlock;
+
+/**
+ * @brief Private method to take a node from the pool, a new block is allocated when the pool is empty
+ * @return A node, NULL if the allocation failed
+ */
+static RedBlackNode *rbtree_allocNode(RedBlackTree *tree) {
+    RedBlackBlock *block;
+    RedBlackNode *node;
+    int i;
+
+    if (tree->freeNodes == NULL) {
+        if ((block = (RedBlackBlock *) malloc(sizeof(RedBlackBlock) + tree->blockNodes * sizeof(RedBlackNode))) ==
+            NULL)
+            return NULL;
+        block->next = tree->blocks;
+        tree->blocks = block;
+
+        // Chain the new nodes in the pool through their right child
+        for (i = 0; i < tree->blockNodes; i++) {
+            block->nodes[i].right = tree->freeNodes;
+            tree->freeNodes = &block->nodes[i];
+        }
+        if (tree->blockNodes < RBTREE_BLOCK_MAX) tree->blockNodes *= 2;
+    }
+
+    node = tree->freeNodes;
+    tree->freeNodes = node->right;
+    return node;
+}
+
+/**
+ * @brief Private method to give a node back to the pool
+ */
+static void rbtree_releaseNode(RedBlackTree *tree, RedBlackNode *node) {
+    node->right = tree->freeNodes;
+    tree->freeNodes = node;
+}
+
+/**
+ * @brief Private method to replace the subtree of a node by another subtree inside the parent of the node
+ */
+static void rbtree_transplant(RedBlackTree *tree, RedBlackNode *node, RedBlackNode *replacement) {
+    if (node->parent == NULL) tree->root = replacement;
+    else if (node == node->parent->left) node->parent->left = replacement;
+    else node->parent->right = replacement;
+    if (replacement != NULL) replacement->parent = node->parent;
+}
+
+/**
+ * @brief Private method to rotate a node with its right child
+ */
+static void rbtree_rotateLeft(RedBlackTree *tree, RedBlackNode *node) {
+    RedBlackNode *pivot = node->right;
+
+    node->right = pivot->left;
+    if (pivot->left != NULL) pivot->left->parent = node;
+    rbtree_transplant(tree, node, pivot);
+    pivot->left = node;
+    node->parent = pivot;
+}
+
+/**
+ * @brief Private method to rotate a node with its left child
+ */
+static void rbtree_rotateRight(RedBlackTree *tree, RedBlackNode *node) {
+    RedBlackNode *pivot = node->left;
+
+    node->left = pivot->right;
+    if (pivot->right != NULL) pivot->right->parent = node;
+    rbtree_transplant(tree, node, pivot);
+    pivot->right = node;
+    node->parent = pivot;
+}
+
+/**
+ * @brief Private method to test if a possibly NULL node is black, NULL leaves are black
+ */
+static bool rbtree_isBlack(const RedBlackNode *node) {
+    return node == NULL || node->color == RBTREE_BLACK;
+}
+
+/**
+ * @brief Private method to restore the Red-Black properties after the insertion of a red node
+ */
+static void rbtree_insertFixup(RedBlackTree *tree, RedBlackNode *node) {
+    RedBlackNode *parent;
+    RedBlackNode *grand;
+    RedBlackNode *uncle;
+
+    while ((parent = node->parent) != NULL && parent->color == RBTREE_RED) {
+        // A red parent is never the root, so the grand parent exists
+        grand = parent->parent;
+        if (parent == grand->left) {
+            uncle = grand->right;
+            if (!rbtree_isBlack(uncle)) {
+                parent->color = RBTREE_BLACK;
+                uncle->color = RBTREE_BLACK;
+                grand->color = RBTREE_RED;
+                node = grand;
+                continue;
+            }
+            if (node == parent->right) {
+                rbtree_rotateLeft(tree, parent);
+                node = parent;
+                parent = node->parent;
+            }
+            parent->color = RBTREE_BLACK;
+            grand->color = RBTREE_RED;
+            rbtree_rotateRight(tree, grand);
+        } else {
+            uncle = grand->left;
+            if (!rbtree_isBlack(uncle)) {
+                parent->color = RBTREE_BLACK;
+                uncle->color = RBTREE_BLACK;
+                grand->color = RBTREE_RED;
+                node = grand;
+                continue;
+            }
+            if (node == parent->left) {
+                rbtree_rotateRight(tree, parent);
+                node = parent;
+                parent = node->parent;
+            }
+            parent->color = RBTREE_BLACK;
+            grand->color = RBTREE_RED;
+            rbtree_rotateLeft(tree, grand);
+        }
+    }
+    tree->root->color = RBTREE_BLACK;
+}
+
+/**
+ * @brief Private method to restore the Red-Black properties after the removal of a black node
+ * @param tree Red-Black tree to fix
+ * @param node Possibly NULL node holding an extra black
+ * @param parent Parent of the node
+ */
+static void rbtree_removeFixup(RedBlackTree *tree, RedBlackNode *node, RedBlackNode *parent) {
+    RedBlackNode *sibling;
+
+    while (node != tree->root && rbtree_isBlack(node)) {
+        // The extra black guarantees a non NULL sibling
+        if (node == parent->left) {
+            sibling = parent->right;
+            if (sibling->color == RBTREE_RED) {
+                sibling->color = RBTREE_BLACK;
+                parent->color = RBTREE_RED;
+                rbtree_rotateLeft(tree, parent);
+                sibling = parent->right;
+            }
+            if (rbtree_isBlack(sibling->left) && rbtree_isBlack(sibling->right)) {
+                sibling->color = RBTREE_RED;
+                node = parent;
+                parent = node->parent;
+                continue;
+            }
+            if (rbtree_isBlack(sibling->right)) {
+                sibling->left->color = RBTREE_BLACK;
+                sibling->color = RBTREE_RED;
+                rbtree_rotateRight(tree, sibling);
+                sibling = parent->right;
+            }
+            sibling->color = parent->color;
+            parent->color = RBTREE_BLACK;
+            sibling->right->color = RBTREE_BLACK;
+            rbtree_rotateLeft(tree, parent);
+        } else {
+            sibling = parent->left;
+            if (sibling->color == RBTREE_RED) {
+                sibling->color = RBTREE_BLACK;
+                parent->color = RBTREE_RED;
+                rbtree_rotateRight(tree, parent);
+                sibling = parent->left;
+            }
+            if (rbtree_isBlack(sibling->left) && rbtree_isBlack(sibling->right)) {
+                sibling->color = RBTREE_RED;
+                node = parent;
+                parent = node->parent;
+                continue;
+            }
+            if (rbtree_isBlack(sibling->left)) {
+                sibling->right->color = RBTREE_BLACK;
+                sibling->color = RBTREE_RED;
+                rbtree_rotateLeft(tree, sibling);
+                sibling = parent->left;
+            }
+            sibling->color = parent->color;
+            parent->color = RBTREE_BLACK;
+            sibling->left->color = RBTREE_BLACK;
+            rbtree_rotateRight(tree, parent);
+        }
+        node = tree->root;
+    }
+    if (node != NULL) node->color = RBTREE_BLACK;
+}
+
+/**
+ * @brief Private method to evaluate the node of the lowest key of a subtree
+ */
+static RedBlackNode *rbtree_minimum(const RedBlackNode *node) {
+    while (node->left != NULL) node = node->left;
+    return (RedBlackNode *) node;
+}
+
+/**
+ * @brief Private method to evaluate the node of the greatest key of a subtree
+ */
+static RedBlackNode *rbtree_maximum(const RedBlackNode *node) {
+    while (node->right != NULL) node = node->right;
+    return (RedBlackNode *) node;
+}
+
+void rbtree_create(RedBlackTree *tree, int (*compare)(const void *key1, const void *key2),
+                   void (*destroy_key)(void *key), void (*destroy_value)(void *value)) {
+    tree->size = 0;
+    tree->compare = compare;
+    tree->destroyKey = destroy_key;
+    tree->destroyValue = destroy_value;
+    tree->root = NULL;
+    tree->freeNodes = NULL;
+    tree->blocks = NULL;
+    tree->blockNodes = RBTREE_BLOCK_MIN;
+}
+
+void rbtree_destroy(RedBlackTree *tree) {
+    RedBlackBlock *block;
+    RedBlackNode *node;
+
+    if (tree->destroyKey != NULL || tree->destroyValue != NULL) {
+        for (node = rbtree_first(tree); node != NULL; node = rbtree_next(node)) {
+            if (tree->destroyKey != NULL) tree->destroyKey(node->key);
+            if (tree->destroyValue != NULL) tree->destroyValue(node->value);
+        }
+    }
+
+    // Nodes are owned by the pool blocks
+    while ((block = tree->blocks) != NULL) {
+        tree->blocks = block->next;
+        free(block);
+    }
+    rbtree_create(tree, tree->compare, tree->destroyKey, tree->destroyValue);
+}
+
+bool rbtree_insert(RedBlackTree *tree, const void *key, const void *value) {
+    RedBlackNode *parent = NULL;
+    RedBlackNode *current = tree->root;
+    RedBlackNode *node;
+    int order = 0;
+
+    while (current != NULL) {
+        parent = current;
+        if ((order = tree->compare(key, current->key)) == 0) return false;
+        current = order < 0 ? current->left : current->right;
+    }
+
+    if ((node = rbtree_allocNode(tree)) == NULL) return false;
+    node->key = (void *) key;
+    node->value = (void *) value;
+    node->parent = parent;
+    node->left = NULL;
+    node->right = NULL;
+    node->color = RBTREE_RED;
+
+    if (parent == NULL) tree->root = node;
+    else if (order < 0) parent->left = node;
+    else parent->right = node;
+
+    rbtree_insertFixup(tree, node);
+    tree->size++;
+    return true;
+}
+
+void rbtree_removeNode(RedBlackTree *tree, RedBlackNode *node, void **stored_key, void **value) {
+    RedBlackNode *successor;
+    RedBlackNode *child;
+    RedBlackNode *parent;
+    RedBlackColor color;
+
+    if (node->left != NULL && node->right != NULL) {
+        // Relink the successor in place of the node, so the other nodes stay valid for iterators
+        successor = rbtree_minimum(node->right);
+        child = successor->right;
+        color = successor->color;
+        if (successor->parent == node) {
+            parent = successor;
+        } else {
+            parent = successor->parent;
+            parent->left = child;
+            if (child != NULL) child->parent = parent;
+            successor->right = node->right;
+            node->right->parent = successor;
+        }
+        rbtree_transplant(tree, node, successor);
+        successor->left = node->left;
+        node->left->parent = successor;
+        successor->color = node->color;
+    } else {
+        child = node->left != NULL ? node->left : node->right;
+        parent = node->parent;
+        color = node->color;
+        rbtree_transplant(tree, node, child);
+    }
+
+    if (color == RBTREE_BLACK) rbtree_removeFixup(tree, child, parent);
+
+    if (stored_key != NULL) *stored_key = node->key;
+    if (value != NULL) *value = node->value;
+    rbtree_releaseNode(tree, node);
+    tree->size--;
+}
+
+bool rbtree_remove(RedBlackTree *tree, const void *key, void **stored_key, void **value) {
+    RedBlackNode *node;
+
+    if ((node = rbtree_find(tree, key)) == NULL) return false;
+    rbtree_removeNode(tree, node, stored_key, value);
+    return true;
+}
+
+RedBlackNode *rbtree_find(const RedBlackTree *tree, const void *key) {
+    RedBlackNode *current = tree->root;
+    int order;
+
+    while (current != NULL) {
+        if ((order = tree->compare(key, current->key)) == 0) return current;
+        current = order < 0 ? current->left : current->right;
+    }
+    return NULL;
+}
+
+RedBlackNode *rbtree_lowerBound(const RedBlackTree *tree, const void *key) {
+    RedBlackNode *current = tree->root;
+    RedBlackNode *bound = NULL;
+
+    while (current != NULL) {
+        if (tree->compare(current->key, key) >= 0) {
+            bound = current;
+            current = current->left;
+        } else {
+            current = current->right;
+        }
+    }
+    return bound;
+}
+
+RedBlackNode *rbtree_upperBound(const RedBlackTree *tree, const void *key) {
+    RedBlackNode *current = tree->root;
+    RedBlackNode *bound = NULL;
+
+    while (current != NULL) {
+        if (tree->compare(current->key, key) > 0) {
+            bound = current;
+            current = current->left;
+        } else {
+            current = current->right;
+        }
+    }
+    return bound;
+}
+
+RedBlackNode *rbtree_first(const RedBlackTree *tree) {
+    return tree->root == NULL ? NULL : rbtree_minimum(tree->root);
+}
+
+RedBlackNode *rbtree_last(const RedBlackTree *tree) {
+    return tree->root == NULL ? NULL : rbtree_maximum(tree->root);
+}
+
+RedBlackNode *rbtree_next(const RedBlackNode *node) {
+    if (node->right != NULL) return rbtree_minimum(node->right);
+
+    // Climb until the node is inside a left subtree
+    while (node->parent != NULL && node == node->parent->right) node = node->parent;
+    return node->parent;
+}
+
+RedBlackNode *rbtree_previous(const RedBlackNode *node) {
+    if (node->left != NULL) return rbtree_maximum(node->left);
+
+    // Climb until the node is inside a right subtree
+    while (node->parent != NULL && node == node->parent->left) node = node->parent;
+    return node->parent;
+}
+
+bool rbtree_range(const RedBlackTree *tree, const void *low, const void *high,
+                  bool (*visit)(const void *key, void *value, void *data), void *data) {
+    RedBlackNode *node = low == NULL ? rbtree_first(tree) : rbtree_lowerBound(tree, low);
+
+    for (; node != NULL; node = rbtree_next(node)) {
+        if (high != NULL && tree->compare(node->key, high) >= 0) break;
+        if (!visit(node->key, node->value, data)) return false;
+    }
+    return true;
+}
@@ -0,0 +1,995 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#include <string.h>
+#include "roaring.h"
+#include "simd_utils.h"
+
+#if COLLECTIONS_SIMD_AVX2
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Maximum number of values of an array container, above it a bitmap container is smaller
+ */
+#define ROARING_ARRAY_MAX 4096
+
+/**
+ * @brief Number of 64 bits words of a bitmap container
+ */
+#define ROARING_BITMAP_WORDS 1024
+
+/**
+ * @brief Serialization cookie, "RBM1" in little endian
+ */
+#define ROARING_COOKIE 0x314D4252u
+
+/**
+ * @brief Bytes of a serialized container header : key, type and count
+ */
+#define ROARING_HEADER_BYTES 8
+
+/**
+ * @brief Private method to count the bits of a word
+ */
+static int roaring_popcount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return (int) ((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * @brief Private method to find the lowest bit set of a non-zero word
+ */
+static int roaring_lowestBit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int bit = 0;
+    while ((word & 1) == 0) {
+        word >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+/**
+ * @brief Private method to count the bits of bitmap container words
+ */
+static int roaring_wordsCount(const uint64_t *words) {
+    int count = 0;
+    int i;
+
+    for (i = 0; i < ROARING_BITMAP_WORDS; i++) count += roaring_popcount(words[i]);
+    return count;
+}
+
+/**
+ * @brief Private scalar kernel merging bitmap container words, intersection if intersect is true, union otherwise
+ */
+static void roaring_wordsCombineScalar(uint64_t *out, const uint64_t *left, const uint64_t *right, bool intersect) {
+    int i;
+
+    if (intersect) {
+        for (i = 0; i < ROARING_BITMAP_WORDS; i++) out[i] = left[i] & right[i];
+    } else {
+        for (i = 0; i < ROARING_BITMAP_WORDS; i++) out[i] = left[i] | right[i];
+    }
+}
+
+#if COLLECTIONS_SIMD_AVX2
+
+/**
+ * @brief Private AVX2 kernel merging bitmap container words, intersection if intersect is true, union otherwise
+ */
+COLLECTIONS_TARGET_AVX2
+static void roaring_wordsCombineAvx2(uint64_t *out, const uint64_t *left, const uint64_t *right, bool intersect) {
+    int i;
+
+    for (i = 0; i < ROARING_BITMAP_WORDS; i += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i *) &left[i]);
+        __m256i b = _mm256_loadu_si256((const __m256i *) &right[i]);
+        _mm256_storeu_si256((__m256i *) &out[i], intersect ? _mm256_and_si256(a, b) : _mm256_or_si256(a, b));
+    }
+}
+
+#endif
+
+/**
+ * @brief Private method merging bitmap container words with the best available kernel
+ */
+static void roaring_wordsCombine(uint64_t *out, const uint64_t *left, const uint64_t *right, bool intersect) {
+#if COLLECTIONS_SIMD_AVX2
+    if (simd_hasAvx2()) {
+        roaring_wordsCombineAvx2(out, left, right, intersect);
+        return;
+    }
+#endif
+    roaring_wordsCombineScalar(out, left, right, intersect);
+}
+
+/**
+ * @brief Private method to set the bits of the [start, end] range of bitmap container words
+ */
+static void roaring_wordsSetRange(uint64_t *words, int start, int end) {
+    int first = start >> 6;
+    int last = end >> 6;
+    uint64_t first_mask = ~0ULL << (start & 63);
+    uint64_t last_mask = ~0ULL >> (63 - (end & 63));
+    int i;
+
+    if (first == last) {
+        words[first] |= first_mask & last_mask;
+        return;
+    }
+    words[first] |= first_mask;
+    for (i = first + 1; i < last; i++) words[i] = ~0ULL;
+    words[last] |= last_mask;
+}
+
+/**
+ * @brief Private method to search a value inside sorted 16 bits values
+ * @return The index of the value if found, -(insertion index + 1) otherwise
+ */
+static int roaring_search16(const uint16_t *values, int size, uint16_t value) {
+    int low = 0;
+    int high = size - 1;
+
+    while (low <= high) {
+        int middle = (low + high) >> 1;
+        if (values[middle] < value) low = middle + 1;
+        else if (values[middle] > value) high = middle - 1;
+        else return middle;
+    }
+    return -(low + 1);
+}
+
+/**
+ * @brief Private method to test if a value is inside a run container
+ */
+static bool roaring_runContains(const RoaringContainer *container, uint16_t value) {
+    const uint16_t *runs = (const uint16_t *) container->data;
+    int low = 0;
+    int high = container->runs - 1;
+
+    // Find the last run starting at or before the value
+    while (low <= high) {
+        int middle = (low + high) >> 1;
+        if (runs[2 * middle] <= value) low = middle + 1;
+        else high = middle - 1;
+    }
+    if (high < 0) return false;
+    return value - runs[2 * high] <= runs[2 * high + 1];
+}
+
+/**
+ * @brief Private method to test if a value is inside a container
+ */
+static bool roaring_containerContains(const RoaringContainer *container, uint16_t value) {
+    switch (container->type) {
+        case ROARING_ARRAY:
+            return roaring_search16((const uint16_t *) container->data, container->cardinality, value) >= 0;
+        case ROARING_BITMAP:
+            return (((const uint64_t *) container->data)[value >> 6] >> (value & 63)) & 1;
+        default:
+            return roaring_runContains(container, value);
+    }
+}
+
+/**
+ * @brief Private method to set the bits of a container inside bitmap container words
+ */
+static void roaring_containerToWords(const RoaringContainer *container, uint64_t *words) {
+    const uint16_t *values = (const uint16_t *) container->data;
+    int i;
+
+    switch (container->type) {
+        case ROARING_ARRAY:
+            for (i = 0; i < container->cardinality; i++) words[values[i] >> 6] |= 1ULL << (values[i] & 63);
+            break;
+        case ROARING_BITMAP:
+            memcpy(words, container->data, ROARING_BITMAP_WORDS * sizeof(uint64_t));
+            break;
+        default:
+            for (i = 0; i < container->runs; i++) {
+                roaring_wordsSetRange(words, values[2 * i], values[2 * i] + values[2 * i + 1]);
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Private method to write the values of a container, at most ROARING_ARRAY_MAX, as sorted 16 bits values
+ */
+static void roaring_containerToValues(const RoaringContainer *container, uint16_t *values) {
+    const uint16_t *runs = (const uint16_t *) container->data;
+    const uint64_t *words = (const uint64_t *) container->data;
+    int size = 0;
+    int i;
+    int value;
+
+    switch (container->type) {
+        case ROARING_ARRAY:
+            memcpy(values, container->data, container->cardinality * sizeof(uint16_t));
+            break;
+        case ROARING_BITMAP:
+            for (i = 0; i < ROARING_BITMAP_WORDS; i++) {
+                uint64_t word = words[i];
+                while (word != 0) {
+                    values[size++] = (uint16_t) ((i << 6) + roaring_lowestBit(word));
+                    word &= word - 1;
+                }
+            }
+            break;
+        default:
+            for (i = 0; i < container->runs; i++) {
+                for (value = runs[2 * i]; value <= runs[2 * i] + runs[2 * i + 1]; value++) {
+                    values[size++] = (uint16_t) value;
+                }
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Private method to convert a container into a bitmap container
+ * @return true if the container was converted, false otherwise
+ */
+static bool roaring_toBitmap(RoaringContainer *container) {
+    uint64_t *words;
+
+    if ((words = (uint64_t *) calloc(ROARING_BITMAP_WORDS, sizeof(uint64_t))) == NULL) return false;
+    roaring_containerToWords(container, words);
+    free(container->data);
+    container->data = words;
+    container->type = ROARING_BITMAP;
+    container->capacity = 0;
+    container->runs = 0;
+    return true;
+}
+
+/**
+ * @brief Private method to convert a container of at most ROARING_ARRAY_MAX values into an array container
+ * @return true if the container was converted, false otherwise
+ */
+static bool roaring_toArray(RoaringContainer *container) {
+    int capacity = container->cardinality > 0 ? container->cardinality : 1;
+    uint16_t *values;
+
+    if ((values = (uint16_t *) malloc(capacity * sizeof(uint16_t))) == NULL) return false;
+    roaring_containerToValues(container, values);
+    free(container->data);
+    container->data = values;
+    container->type = ROARING_ARRAY;
+    container->capacity = capacity;
+    container->runs = 0;
+    return true;
+}
+
+/**
+ * @brief Private method to convert a run container back into the cheapest mutable container
+ */
+static bool roaring_unrun(RoaringContainer *container) {
+    if (container->type != ROARING_RUN) return true;
+    if (container->cardinality > ROARING_ARRAY_MAX) return roaring_toBitmap(container);
+    return roaring_toArray(container);
+}
+
+/**
+ * @brief Private method to shrink a bitmap container into an array container when it holds few values
+ */
+static void roaring_shrink(RoaringContainer *container) {
+    // On allocation failure the container remains a valid bitmap container
+    if (container->type == ROARING_BITMAP && container->cardinality <= ROARING_ARRAY_MAX) roaring_toArray(container);
+}
+
+/**
+ * @brief Private method to count the runs of consecutive values of a container
+ */
+static int roaring_countRuns(const RoaringContainer *container) {
+    const uint16_t *values = (const uint16_t *) container->data;
+    const uint64_t *words = (const uint64_t *) container->data;
+    uint64_t carry = 0;
+    int runs = 0;
+    int i;
+
+    switch (container->type) {
+        case ROARING_ARRAY:
+            for (i = 0; i < container->cardinality; i++) {
+                if (i == 0 || values[i] != values[i - 1] + 1) runs++;
+            }
+            return runs;
+        case ROARING_BITMAP:
+            // A run starts on every set bit whose predecessor is clear
+            for (i = 0; i < ROARING_BITMAP_WORDS; i++) {
+                runs += roaring_popcount(words[i] & ~((words[i] << 1) | carry));
+                carry = words[i] >> 63;
+            }
+            return runs;
+        default:
+            return container->runs;
+    }
+}
+
+/**
+ * @brief Private method to convert a container into a run container of the given number of runs
+ * @return true if the container was converted, false otherwise
+ */
+static bool roaring_toRun(RoaringContainer *container, int count) {
+    const uint16_t *values = (const uint16_t *) container->data;
+    const uint64_t *words = (const uint64_t *) container->data;
+    uint16_t *runs;
+    int run = -1;
+    int previous = -2;
+    int i;
+
+    if ((runs = (uint16_t *) malloc(2 * count * sizeof(uint16_t))) == NULL) return false;
+
+    if (container->type == ROARING_ARRAY) {
+        for (i = 0; i < container->cardinality; i++) {
+            if (values[i] != previous + 1) {
+                runs[2 * ++run] = values[i];
+                runs[2 * run + 1] = 0;
+            } else {
+                runs[2 * run + 1]++;
+            }
+            previous = values[i];
+        }
+    } else {
+        for (i = 0; i < ROARING_BITMAP_WORDS; i++) {
+            uint64_t word = words[i];
+            while (word != 0) {
+                int value = (i << 6) + roaring_lowestBit(word);
+                if (value != previous + 1) {
+                    runs[2 * ++run] = (uint16_t) value;
+                    runs[2 * run + 1] = 0;
+                } else {
+                    runs[2 * run + 1]++;
+                }
+                previous = value;
+                word &= word - 1;
+            }
+        }
+    }
+
+    free(container->data);
+    container->data = runs;
+    container->type = ROARING_RUN;
+    container->runs = count;
+    container->capacity = 2 * count;
+    return true;
+}
+
+/**
+ * @brief Private method to compute the number of bytes of the storage of a container
+ */
+static size_t roaring_containerBytes(const RoaringContainer *container) {
+    switch (container->type) {
+        case ROARING_ARRAY:
+            return container->cardinality * sizeof(uint16_t);
+        case ROARING_BITMAP:
+            return ROARING_BITMAP_WORDS * sizeof(uint64_t);
+        default:
+            return 2 * container->runs * sizeof(uint16_t);
+    }
+}
+
+/**
+ * @brief Private method to add a value inside an array or a bitmap container
+ * @return true if the value was added, false otherwise
+ */
+static bool roaring_containerAdd(RoaringContainer *container, uint16_t value) {
+    uint16_t *values;
+    uint64_t *word;
+    int position;
+    int capacity;
+
+    if (container->type == ROARING_BITMAP) {
+        word = &((uint64_t *) container->data)[value >> 6];
+        if ((*word >> (value & 63)) & 1) return false;
+        *word |= 1ULL << (value & 63);
+        container->cardinality++;
+        return true;
+    }
+
+    if ((position = roaring_search16((const uint16_t *) container->data, container->cardinality, value)) >= 0) {
+        return false;
+    }
+    position = -(position + 1);
+
+    if (container->cardinality == ROARING_ARRAY_MAX) {
+        if (!roaring_toBitmap(container)) return false;
+        return roaring_containerAdd(container, value);
+    }
+
+    if (container->cardinality == container->capacity) {
+        capacity = container->capacity < 4 ? 4 : container->capacity * 2;
+        if (capacity > ROARING_ARRAY_MAX) capacity = ROARING_ARRAY_MAX;
+        if ((values = (uint16_t *) realloc(container->data, capacity * sizeof(uint16_t))) == NULL) return false;
+        container->data = values;
+        container->capacity = capacity;
+    }
+
+    values = (uint16_t *) container->data;
+    memmove(&values[position + 1], &values[position], (container->cardinality - position) * sizeof(uint16_t));
+    values[position] = value;
+    container->cardinality++;
+    return true;
+}
+
+/**
+ * @brief Private method to remove a value from an array or a bitmap container
+ * @return true if the value was removed, false otherwise
+ */
+static bool roaring_containerRemove(RoaringContainer *container, uint16_t value) {
+    uint16_t *values;
+    uint64_t *word;
+    int position;
+
+    if (container->type == ROARING_BITMAP) {
+        word = &((uint64_t *) container->data)[value >> 6];
+        if (((*word >> (value & 63)) & 1) == 0) return false;
+        *word &= ~(1ULL << (value & 63));
+        container->cardinality--;
+        roaring_shrink(container);
+        return true;
+    }
+
+    values = (uint16_t *) container->data;
+    if ((position = roaring_search16(values, container->cardinality, value)) < 0) return false;
+    memmove(&values[position], &values[position + 1], (container->cardinality - position - 1) * sizeof(uint16_t));
+    container->cardinality--;
+    return true;
+}
+
+/**
+ * @brief Private method to search the container of the given key
+ * @return The index of the container if found, -(insertion index + 1) otherwise
+ */
+static int roaring_findContainer(const RoaringBitmap *bitmap, uint16_t key) {
+    int low = 0;
+    int high = bitmap->size - 1;
+
+    while (low <= high) {
+        int middle = (low + high) >> 1;
+        if (bitmap->containers[middle].key < key) low = middle + 1;
+        else if (bitmap->containers[middle].key > key) high = middle - 1;
+        else return middle;
+    }
+    return -(low + 1);
+}
+
+/**
+ * @brief Private method to insert an empty array container at the given index
+ * @return The inserted container, NULL if the allocation failed
+ */
+static RoaringContainer *roaring_insertContainer(RoaringBitmap *bitmap, int position, uint16_t key) {
+    RoaringContainer *containers;
+    RoaringContainer *container;
+    int capacity;
+
+    if (bitmap->size == bitmap->capacity) {
+        capacity = bitmap->capacity < 4 ? 4 : bitmap->capacity * 2;
+        if ((containers = (RoaringContainer *) realloc(bitmap->containers, capacity * sizeof(RoaringContainer))) ==
+            NULL)
+            return NULL;
+        bitmap->containers = containers;
+        bitmap->capacity = capacity;
+    }
+
+    memmove(&bitmap->containers[position + 1], &bitmap->containers[position],
+            (bitmap->size - position) * sizeof(RoaringContainer));
+    bitmap->size++;
+
+    container = &bitmap->containers[position];
+    container->key = key;
+    container->type = ROARING_ARRAY;
+    container->cardinality = 0;
+    container->runs = 0;
+    container->capacity = 0;
+    container->data = NULL;
+    return container;
+}
+
+/**
+ * @brief Private method to remove the container at the given index
+ */
+static void roaring_eraseContainer(RoaringBitmap *bitmap, int position) {
+    free(bitmap->containers[position].data);
+    memmove(&bitmap->containers[position], &bitmap->containers[position + 1],
+            (bitmap->size - position - 1) * sizeof(RoaringContainer));
+    bitmap->size--;
+}
+
+/**
+ * @brief Private method to append a copy of a container at the end of a bitmap
+ * @return true if the container was copied, false otherwise
+ */
+static bool roaring_appendCopy(RoaringBitmap *bitmap, const RoaringContainer *container) {
+    size_t bytes = roaring_containerBytes(container);
+    RoaringContainer *copy;
+    void *data;
+
+    if ((data = malloc(bytes > 0 ? bytes : 1)) == NULL) return false;
+    memcpy(data, container->data, bytes);
+    if ((copy = roaring_insertContainer(bitmap, bitmap->size, container->key)) == NULL) {
+        free(data);
+        return false;
+    }
+    *copy = *container;
+    copy->data = data;
+    if (copy->type == ROARING_ARRAY) copy->capacity = copy->cardinality;
+    return true;
+}
+
+/**
+ * @brief Private method to append the union of two containers of the same key at the end of a bitmap
+ * @return true if the union was appended, false otherwise
+ */
+static bool roaring_appendUnion(RoaringBitmap *bitmap, const RoaringContainer *left, const RoaringContainer *right) {
+    const uint16_t *a = (const uint16_t *) left->data;
+    const uint16_t *b = (const uint16_t *) right->data;
+    RoaringContainer *container;
+    uint16_t *values;
+    uint64_t *words;
+    uint64_t *other;
+    int i = 0;
+    int j = 0;
+    int size = 0;
+
+    if (left->type == ROARING_ARRAY && right->type == ROARING_ARRAY &&
+        left->cardinality + right->cardinality <= ROARING_ARRAY_MAX) {
+        if ((values = (uint16_t *) malloc((left->cardinality + right->cardinality) * sizeof(uint16_t))) == NULL)
+            return false;
+        while (i < left->cardinality && j < right->cardinality) {
+            if (a[i] < b[j]) values[size++] = a[i++];
+            else if (a[i] > b[j]) values[size++] = b[j++];
+            else {
+                values[size++] = a[i++];
+                j++;
+            }
+        }
+        while (i < left->cardinality) values[size++] = a[i++];
+        while (j < right->cardinality) values[size++] = b[j++];
+
+        if ((container = roaring_insertContainer(bitmap, bitmap->size, left->key)) == NULL) {
+            free(values);
+            return false;
+        }
+        container->data = values;
+        container->cardinality = size;
+        container->capacity = left->cardinality + right->cardinality;
+        return true;
+    }
+
+    if ((words = (uint64_t *) calloc(ROARING_BITMAP_WORDS, sizeof(uint64_t))) == NULL) return false;
+    roaring_containerToWords(left, words);
+    if (right->type == ROARING_BITMAP) {
+        roaring_wordsCombine(words, words, (const uint64_t *) right->data, false);
+    } else if (right->type == ROARING_ARRAY) {
+        roaring_containerToWords(right, words);
+    } else {
+        if ((other = (uint64_t *) calloc(ROARING_BITMAP_WORDS, sizeof(uint64_t))) == NULL) {
+            free(words);
+            return false;
+        }
+        roaring_containerToWords(right, other);
+        roaring_wordsCombine(words, words, other, false);
+        free(other);
+    }
+
+    if ((container = roaring_insertContainer(bitmap, bitmap->size, left->key)) == NULL) {
+        free(words);
+        return false;
+    }
+    container->type = ROARING_BITMAP;
+    container->data = words;
+    container->cardinality = roaring_wordsCount(words);
+    roaring_shrink(container);
+    return true;
+}
+
+/**
+ * @brief Private method to append the intersection of two containers of the same key at the end of a bitmap, empty
+ * intersections are not appended
+ * @return true if the intersection was computed, false otherwise
+ */
+static bool roaring_appendIntersection(RoaringBitmap *bitmap, const RoaringContainer *left,
+                                       const RoaringContainer *right) {
+    const RoaringContainer *small = left;
+    const RoaringContainer *large = right;
+    RoaringContainer *container;
+    const uint16_t *a;
+    const uint16_t *b;
+    uint16_t *values;
+    uint64_t *words;
+    uint64_t *other = NULL;
+    int i = 0;
+    int j = 0;
+    int size = 0;
+    int cardinality;
+
+    if (right->type == ROARING_ARRAY && (left->type != ROARING_ARRAY || right->cardinality < left->cardinality)) {
+        small = right;
+        large = left;
+    }
+
+    if (small->type == ROARING_ARRAY) {
+        a = (const uint16_t *) small->data;
+        b = (const uint16_t *) large->data;
+        if ((values = (uint16_t *) malloc(small->cardinality * sizeof(uint16_t))) == NULL) return false;
+        if (large->type == ROARING_ARRAY && large->cardinality < 32 * small->cardinality) {
+            while (i < small->cardinality && j < large->cardinality) {
+                if (a[i] < b[j]) i++;
+                else if (a[i] > b[j]) j++;
+                else {
+                    values[size++] = a[i++];
+                    j++;
+                }
+            }
+        } else {
+            // Skewed sizes or non array container, probe each value of the small container
+            for (i = 0; i < small->cardinality; i++) {
+                if (roaring_containerContains(large, a[i])) values[size++] = a[i];
+            }
+        }
+
+        if (size == 0) {
+            free(values);
+            return true;
+        }
+        if ((container = roaring_insertContainer(bitmap, bitmap->size, left->key)) == NULL) {
+            free(values);
+            return false;
+        }
+        container->data = values;
+        container->cardinality = size;
+        container->capacity = small->cardinality;
+        return true;
+    }
+
+    if ((words = (uint64_t *) calloc(ROARING_BITMAP_WORDS, sizeof(uint64_t))) == NULL) return false;
+    roaring_containerToWords(left, words);
+    if (right->type == ROARING_BITMAP) {
+        roaring_wordsCombine(words, words, (const uint64_t *) right->data, true);
+    } else {
+        if ((other = (uint64_t *) calloc(ROARING_BITMAP_WORDS, sizeof(uint64_t))) == NULL) {
+            free(words);
+            return false;
+        }
+        roaring_containerToWords(right, other);
+        roaring_wordsCombine(words, words, other, true);
+        free(other);
+    }
+
+    if ((cardinality = roaring_wordsCount(words)) == 0) {
+        free(words);
+        return true;
+    }
+    if ((container = roaring_insertContainer(bitmap, bitmap->size, left->key)) == NULL) {
+        free(words);
+        return false;
+    }
+    container->type = ROARING_BITMAP;
+    container->data = words;
+    container->cardinality = cardinality;
+    roaring_shrink(container);
+    return true;
+}
+
+/**
+ * @brief Private method to write a little endian integer of the given number of bytes
+ */
+static void roaring_write(uint8_t **cursor, uint64_t value, int bytes) {
+    int i;
+
+    for (i = 0; i < bytes; i++) (*cursor)[i] = (uint8_t) (value >> (8 * i));
+    *cursor += bytes;
+}
+
+/**
+ * @brief Private method to read a little endian integer of the given number of bytes
+ */
+static uint64_t roaring_read(const uint8_t **cursor, int bytes) {
+    uint64_t value = 0;
+    int i;
+
+    for (i = 0; i < bytes; i++) value |= (uint64_t) (*cursor)[i] << (8 * i);
+    *cursor += bytes;
+    return value;
+}
+
+/**
+ * @brief Private method to read the payload of a serialized container and check it is well-formed
+ * @return true if the payload is valid, false otherwise
+ */
+static bool roaring_readContainer(RoaringContainer *container, const uint8_t **cursor, int count) {
+    uint16_t *values = (uint16_t *) container->data;
+    uint64_t *words = (uint64_t *) container->data;
+    int previous = -1;
+    int i;
+
+    switch (container->type) {
+        case ROARING_ARRAY:
+            for (i = 0; i < count; i++) {
+                values[i] = (uint16_t) roaring_read(cursor, 2);
+                if (values[i] <= previous) return false;
+                previous = values[i];
+            }
+            container->cardinality = count;
+            container->capacity = count;
+            return true;
+        case ROARING_BITMAP:
+            for (i = 0; i < ROARING_BITMAP_WORDS; i++) words[i] = roaring_read(cursor, 8);
+            container->cardinality = roaring_wordsCount(words);
+            return container->cardinality == count;
+        default:
+            container->cardinality = 0;
+            for (i = 0; i < count; i++) {
+                values[2 * i] = (uint16_t) roaring_read(cursor, 2);
+                values[2 * i + 1] = (uint16_t) roaring_read(cursor, 2);
+                if (values[2 * i] <= previous || values[2 * i] + values[2 * i + 1] > UINT16_MAX) return false;
+                previous = values[2 * i] + values[2 * i + 1];
+                container->cardinality += values[2 * i + 1] + 1;
+            }
+            container->runs = count;
+            container->capacity = 2 * count;
+            return true;
+    }
+}
+
+void roaring_create(RoaringBitmap *bitmap) {
+    bitmap->size = 0;
+    bitmap->capacity = 0;
+    bitmap->containers = NULL;
+}
+
+void roaring_destroy(RoaringBitmap *bitmap) {
+    int i;
+
+    for (i = 0; i < bitmap->size; i++) free(bitmap->containers[i].data);
+    free(bitmap->containers);
+    roaring_create(bitmap);
+}
+
+bool roaring_add(RoaringBitmap *bitmap, uint32_t value) {
+    uint16_t key = (uint16_t) (value >> 16);
+    RoaringContainer *container;
+    int position;
+    bool added;
+
+    if ((position = roaring_findContainer(bitmap, key)) < 0) {
+        position = -(position + 1);
+        if ((container = roaring_insertContainer(bitmap, position, key)) == NULL) return false;
+    } else {
+        container = &bitmap->containers[position];
+        if (container->type == ROARING_RUN) {
+            if (roaring_runContains(container, (uint16_t) value)) return false;
+            if (!roaring_unrun(container)) return false;
+        }
+    }
+
+    added = roaring_containerAdd(container, (uint16_t) value);
+    if (container->cardinality == 0) roaring_eraseContainer(bitmap, position);
+    return added;
+}
+
+bool roaring_remove(RoaringBitmap *bitmap, uint32_t value) {
+    RoaringContainer *container;
+    int position;
+
+    if ((position = roaring_findContainer(bitmap, (uint16_t) (value >> 16))) < 0) return false;
+    container = &bitmap->containers[position];
+    if (container->type == ROARING_RUN) {
+        if (!roaring_runContains(container, (uint16_t) value)) return false;
+        if (!roaring_unrun(container)) return false;
+    }
+
+    if (!roaring_containerRemove(container, (uint16_t) value)) return false;
+    if (container->cardinality == 0) roaring_eraseContainer(bitmap, position);
+    return true;
+}
+
+bool roaring_contains(const RoaringBitmap *bitmap, uint32_t value) {
+    int position;
+
+    if ((position = roaring_findContainer(bitmap, (uint16_t) (value >> 16))) < 0) return false;
+    return roaring_containerContains(&bitmap->containers[position], (uint16_t) value);
+}
+
+uint64_t roaring_cardinality(const RoaringBitmap *bitmap) {
+    uint64_t cardinality = 0;
+    int i;
+
+    for (i = 0; i < bitmap->size; i++) cardinality += bitmap->containers[i].cardinality;
+    return cardinality;
+}
+
+bool roaring_union(RoaringBitmap *union_result, const RoaringBitmap *left, const RoaringBitmap *right) {
+    int i = 0;
+    int j = 0;
+    bool done = true;
+
+    roaring_create(union_result);
+    while (done && (i < left->size || j < right->size)) {
+        if (j == right->size || (i < left->size && left->containers[i].key < right->containers[j].key)) {
+            done = roaring_appendCopy(union_result, &left->containers[i++]);
+        } else if (i == left->size || left->containers[i].key > right->containers[j].key) {
+            done = roaring_appendCopy(union_result, &right->containers[j++]);
+        } else {
+            done = roaring_appendUnion(union_result, &left->containers[i++], &right->containers[j++]);
+        }
+    }
+
+    if (!done) roaring_destroy(union_result);
+    return done;
+}
+
+bool roaring_intersection(RoaringBitmap *intersection_result, const RoaringBitmap *left, const RoaringBitmap *right) {
+    int i = 0;
+    int j = 0;
+    bool done = true;
+
+    roaring_create(intersection_result);
+    while (done && i < left->size && j < right->size) {
+        if (left->containers[i].key < right->containers[j].key) i++;
+        else if (left->containers[i].key > right->containers[j].key) j++;
+        else done = roaring_appendIntersection(intersection_result, &left->containers[i++], &right->containers[j++]);
+    }
+
+    if (!done) roaring_destroy(intersection_result);
+    return done;
+}
+
+bool roaring_runOptimize(RoaringBitmap *bitmap) {
+    bool converted = false;
+    int runs;
+    int i;
+
+    for (i = 0; i < bitmap->size; i++) {
+        RoaringContainer *container = &bitmap->containers[i];
+        if (container->type == ROARING_RUN) continue;
+        runs = roaring_countRuns(container);
+        if (2 * runs * sizeof(uint16_t) < roaring_containerBytes(container) && roaring_toRun(container, runs)) {
+            converted = true;
+        }
+    }
+    return converted;
+}
+
+bool roaring_forEach(const RoaringBitmap *bitmap, bool (*visit)(uint32_t value, void *data), void *data) {
+    const RoaringContainer *container;
+    const uint16_t *values;
+    const uint64_t *words;
+    uint32_t high;
+    int value;
+    int i;
+    int j;
+
+    for (i = 0; i < bitmap->size; i++) {
+        container = &bitmap->containers[i];
+        values = (const uint16_t *) container->data;
+        words = (const uint64_t *) container->data;
+        high = (uint32_t) container->key << 16;
+
+        switch (container->type) {
+            case ROARING_ARRAY:
+                for (j = 0; j < container->cardinality; j++) {
+                    if (!visit(high | values[j], data)) return false;
+                }
+                break;
+            case ROARING_BITMAP:
+                for (j = 0; j < ROARING_BITMAP_WORDS; j++) {
+                    uint64_t word = words[j];
+                    while (word != 0) {
+                        if (!visit(high | (uint32_t) ((j << 6) + roaring_lowestBit(word)), data)) return false;
+                        word &= word - 1;
+                    }
+                }
+                break;
+            default:
+                for (j = 0; j < container->runs; j++) {
+                    for (value = values[2 * j]; value <= values[2 * j] + values[2 * j + 1]; value++) {
+                        if (!visit(high | (uint32_t) value, data)) return false;
+                    }
+                }
+                break;
+        }
+    }
+    return true;
+}
+
+size_t roaring_serializedSize(const RoaringBitmap *bitmap) {
+    size_t size = 2 * sizeof(uint32_t);
+    int i;
+
+    for (i = 0; i < bitmap->size; i++) size += ROARING_HEADER_BYTES + roaring_containerBytes(&bitmap->containers[i]);
+    return size;
+}
+
+size_t roaring_serialize(const RoaringBitmap *bitmap, void *buffer) {
+    uint8_t *cursor = (uint8_t *) buffer;
+    const RoaringContainer *container;
+    const uint16_t *values;
+    const uint64_t *words;
+    int i;
+    int j;
+
+    roaring_write(&cursor, ROARING_COOKIE, 4);
+    roaring_write(&cursor, bitmap->size, 4);
+    for (i = 0; i < bitmap->size; i++) {
+        container = &bitmap->containers[i];
+        values = (const uint16_t *) container->data;
+        words = (const uint64_t *) container->data;
+
+        roaring_write(&cursor, container->key, 2);
+        roaring_write(&cursor, container->type, 2);
+        roaring_write(&cursor, container->type == ROARING_RUN ? container->runs : container->cardinality, 4);
+        switch (container->type) {
+            case ROARING_ARRAY:
+                for (j = 0; j < container->cardinality; j++) roaring_write(&cursor, values[j], 2);
+                break;
+            case ROARING_BITMAP:
+                for (j = 0; j < ROARING_BITMAP_WORDS; j++) roaring_write(&cursor, words[j], 8);
+                break;
+            default:
+                for (j = 0; j < 2 * container->runs; j++) roaring_write(&cursor, values[j], 2);
+                break;
+        }
+    }
+    return cursor - (uint8_t *) buffer;
+}
+
+bool roaring_deserialize(RoaringBitmap *bitmap, const void *buffer, size_t size) {
+    const uint8_t *cursor = (const uint8_t *) buffer;
+    const uint8_t *end = cursor + size;
+    RoaringContainer *container;
+    size_t bytes;
+    uint32_t count;
+    uint32_t containers;
+    uint16_t key;
+    int type;
+    int previous = -1;
+    uint32_t i;
+
+    roaring_create(bitmap);
+    if (size < 2 * sizeof(uint32_t) || roaring_read(&cursor, 4) != ROARING_COOKIE) return false;
+    containers = (uint32_t) roaring_read(&cursor, 4);
+    if (containers > 65536) return false;
+
+    for (i = 0; i < containers; i++) {
+        if ((size_t) (end - cursor) < ROARING_HEADER_BYTES) break;
+        key = (uint16_t) roaring_read(&cursor, 2);
+        type = (int) roaring_read(&cursor, 2);
+        count = (uint32_t) roaring_read(&cursor, 4);
+
+        if (key <= previous || count == 0) break;
+        if (type == ROARING_ARRAY && count <= ROARING_ARRAY_MAX) bytes = count * sizeof(uint16_t);
+        else if (type == ROARING_BITMAP && count <= 65536) bytes = ROARING_BITMAP_WORDS * sizeof(uint64_t);
+        else if (type == ROARING_RUN && count <= 32768) bytes = 2 * count * sizeof(uint16_t);
+        else break;
+        if ((size_t) (end - cursor) < bytes) break;
+
+        if ((container = roaring_insertContainer(bitmap, bitmap->size, key)) == NULL) break;
+        container->type = (RoaringContainerType) type;
+        if ((container->data = malloc(bytes)) == NULL) {
+            bitmap->size--;
+            break;
+        }
+        if (!roaring_readContainer(container, &cursor, (int) count)) break;
+        previous = key;
+    }
+
+    if (i < containers || cursor != end) {
+        roaring_destroy(bitmap);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,203 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#include "search.h"
+#include "simd_utils.h"
+
+#if COLLECTIONS_SIMD_AVX2
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Private branchless binary search of a generic array, the probe moves the range when it is strictly lower
+ * than the key, or lower or equal if inclusive is true
+ * @return The index of the first element going after the key, or not before it if inclusive is false
+ */
+static int search_bound(const void *base, int count, size_t size, const void *key,
+                        int (*compare)(const void *key1, const void *key2), bool inclusive) {
+    const char *first = (const char *) base;
+    size_t length = (size_t) count;
+    size_t half;
+    int order;
+
+    if (base == NULL || count <= 0) return 0;
+
+    // Every element before first goes before the key, the bound stays inside [first, first + length]
+    while (length > 1) {
+        half = length / 2;
+        order = compare(first + half * size, key);
+        first += (inclusive ? order <= 0 : order < 0) ? half * size : 0;
+        length -= half;
+    }
+    order = compare(first, key);
+    return (int) ((size_t) (first - (const char *) base) / size) + (inclusive ? order <= 0 : order < 0);
+}
+
+int array_lowerBound(const void *base, int count, size_t size, const void *key,
+                     int (*compare)(const void *key1, const void *key2)) {
+    return search_bound(base, count, size, key, compare, false);
+}
+
+int array_upperBound(const void *base, int count, size_t size, const void *key,
+                     int (*compare)(const void *key1, const void *key2)) {
+    return search_bound(base, count, size, key, compare, true);
+}
+
+int array_equalRange(const void *base, int count, size_t size, const void *key,
+                     int (*compare)(const void *key1, const void *key2), int *first) {
+    *first = search_bound(base, count, size, key, compare, false);
+
+    // The upper bound is searched after the lower one only
+    return search_bound((const char *) base + (size_t) *first * size, count - *first, size, key, compare, true);
+}
+
+int array_search(const void *base, int count, size_t size, const void *key,
+                 int (*compare)(const void *key1, const void *key2)) {
+    int index = search_bound(base, count, size, key, compare, false);
+
+    if (index == count || compare((const char *) base + (size_t) index * size, key) != 0) return -1;
+    return index;
+}
+
+/**
+ * @brief Private scalar kernel counting the integers lower than the given key, or lower or equal if inclusive is true
+ */
+static int search_rankScalar(const int64_t *values, int count, int64_t key, bool inclusive) {
+    int rank = 0;
+    int i;
+
+    // Branchless count, the integers being sorted it is the insertion index of the key
+    if (inclusive) {
+        for (i = 0; i < count; i++) rank += values[i] <= key;
+    } else {
+        for (i = 0; i < count; i++) rank += values[i] < key;
+    }
+    return rank;
+}
+
+#if COLLECTIONS_SIMD_AVX2
+
+/**
+ * @brief Private AVX2 kernel counting the integers lower than the given key, or lower or equal if inclusive is true
+ */
+COLLECTIONS_TARGET_AVX2
+static int search_rankAvx2(const int64_t *values, int count, int64_t key, bool inclusive) {
+    const __m256i target = _mm256_set1_epi64x(key);
+    int rank = 0;
+    int i;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        __m256i block = _mm256_loadu_si256((const __m256i *) &values[i]);
+        if (inclusive) {
+            __m256i greater = _mm256_cmpgt_epi64(block, target);
+            rank += 4 - __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(greater)));
+        } else {
+            __m256i lower = _mm256_cmpgt_epi64(target, block);
+            rank += __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(lower)));
+        }
+    }
+    return rank + search_rankScalar(&values[i], count - i, key, inclusive);
+}
+
+#endif
+
+/**
+ * @brief Private method counting the integers lower than the given key with the best available kernel
+ */
+static int search_rank(const int64_t *values, int count, int64_t key, bool inclusive) {
+#if COLLECTIONS_SIMD_AVX2
+    if (simd_hasAvx2()) return search_rankAvx2(values, count, key, inclusive);
+#endif
+    return search_rankScalar(values, count, key, inclusive);
+}
+
+/**
+ * @brief Private branchless binary search of a sorted integer array, the last range is counted by search_rank
+ */
+static int search_boundInt64(const int64_t *values, int count, int64_t key, bool inclusive) {
+    const int64_t *first = values;
+    size_t length = count < 0 ? 0 : (size_t) count;
+    size_t half;
+
+    // Every integer before first is lower than the key, the bound stays inside [first, first + length]
+    while (length > SEARCH_LINEAR_THRESHOLD) {
+        half = length / 2;
+#if defined(__GNUC__) || defined(__clang__)
+        // Both possible next probes are loaded while the current one is compared
+        __builtin_prefetch(first + half / 2);
+        __builtin_prefetch(first + half + half / 2);
+#endif
+        first = (inclusive ? first[half] <= key : first[half] < key) ? first + half : first;
+        length -= half;
+    }
+    return (int) (first - values) + search_rank(first, (int) length, key, inclusive);
+}
+
+int array_lowerBoundInt64(const int64_t *values, int count, int64_t key) {
+    return search_boundInt64(values, count, key, false);
+}
+
+int array_upperBoundInt64(const int64_t *values, int count, int64_t key) {
+    return search_boundInt64(values, count, key, true);
+}
+
+/**
+ * @brief Private method to approximate the square root of a range length by a power of two
+ */
+static size_t search_sqrtStep(size_t length) {
+    int bits = 0;
+
+#if defined(__GNUC__) || defined(__clang__)
+    bits = 63 - __builtin_clzll((unsigned long long) length);
+#else
+    while (length >> (bits + 1) != 0) bits++;
+#endif
+    return (size_t) 1 << (bits / 2);
+}
+
+int array_interpolationSearch(const int64_t *values, int count, int64_t key) {
+    size_t low = 0;
+    size_t high = count < 0 ? 0 : (size_t) count;
+    size_t length;
+    size_t probe;
+    size_t step;
+    double ratio;
+
+    // The integers before low are lower than the key and the ones from high aren't
+    while (high - low > SEARCH_LINEAR_THRESHOLD) {
+        if (key <= values[low]) return (int) low;
+        if (key > values[high - 1]) return (int) high;
+
+        // The key lies between the range ends, ends rounded to the same double give a bisection
+        ratio = ((double) key - (double) values[low]) / ((double) values[high - 1] - (double) values[low]);
+        if (!(ratio >= 0.0 && ratio <= 1.0)) ratio = 0.5;
+        length = high - low;
+        probe = low + (size_t) (ratio * (double) (length - 1));
+        if (probe >= high) probe = high - 1;
+
+        // Uniform integers put the key within about sqrt(length) of the probe, a second probe brackets it there
+        step = search_sqrtStep(length);
+        if (values[probe] < key) {
+            low = probe + 1;
+            if (high - low > step) {
+                if (values[low + step] >= key) high = low + step;
+                else low += step + 1;
+            }
+        } else {
+            high = probe;
+            if (high - low > step) {
+                if (values[high - step - 1] < key) low = high - step;
+                else high -= step + 1;
+            }
+        }
+
+        // Skewed integers are bisected so the range at least halves at each step
+        if (high - low > length / 2 && high - low > SEARCH_LINEAR_THRESHOLD) {
+            probe = low + (high - low) / 2;
+            if (values[probe] < key) low = probe + 1;
+            else high = probe;
+        }
+    }
+    return (int) low + search_rank(values + low, (int) (high - low), key, false);
+}
@@ -3,66 +3,352 @@
 //
 
 #include <stdint.h>
-
+#include <string.h>
 
 #include "set.h"
+#include "simd_utils.h"
+
+#if COLLECTIONS_SIMD_AVX2
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Size ratio between two sorted set operands above which the smallest one is galloped into the largest one
+ */
+#define SORTEDSET_GALLOP_RATIO 32
+
+/**
+ * @brief Private hash index of a hashed Set, open addressing table of the set elements using linear probing
+ */
+typedef struct ListIndex {
+    /**
+     * @brief Number of slots inside the index, always a power of two
+     */
+    int capacity;
+    /**
+     * @brief Number of used slots, including vacant ones
+     */
+    int used;
+    /**
+     * @brief Index slots, each one is NULL, vacant or a set element
+     */
+    LinkedElement **slots;
+} ListIndex;
+
+/**
+ * @brief Private memory address for vacant index slots
+ */
+static LinkedElement vacant;
+
+/**
+ * @brief Private method to hash a value of a hashed set
+ * @param set Hashed set
+ * @param value Value to hash
+ * @return The user hash of the value with its bits spread, low bits are used as slot index
+ */
+static uint32_t set_hashValue(const Set *set, const void *value) {
+    uint32_t hash = (uint32_t) set->hash(value);
+
+    hash = ((hash >> 16) ^ hash) * 0x45d9f3bu;
+    return (hash >> 16) ^ hash;
+}
 
+/**
+ * @brief Private method to compute the first probed slot of a value
+ * @param set Hashed set
+ * @param value Value to hash
+ * @return The first slot index to probe for the value
+ */
+static int set_indexSlot(const Set *set, const void *value) {
+    return (int) (set_hashValue(set, value) & (uint32_t) (set->index->capacity - 1));
+}
 
-bool set_match_entries(Set *elements, Set *elements_to_match, Set *matched_elements) {
-    Set intersection;
-    KeySetEntry *hashSet;
-    LinkedElement *current_element, *element_max;
-    void *value;
-    uint32_t max_size;
+/**
+ * @brief Private method to allocate a set index
+ * @param capacity Minimal number of elements to be stored without resizing
+ * @return The new index, NULL if the allocation failed
+ */
+static ListIndex *set_indexCreate(int capacity) {
+    ListIndex *index;
+    int slots = 16;
+
+    // Keep the load factor under 3/4
+    while (slots < capacity + capacity / 3 + 1) slots <<= 1;
+
+    if ((index = (ListIndex *) malloc(sizeof(ListIndex))) == NULL) return NULL;
+    if ((index->slots = (LinkedElement **) calloc(slots, sizeof(LinkedElement *))) == NULL) {
+        free(index);
+        return NULL;
+    }
+    index->capacity = slots;
+    index->used = 0;
+    return index;
+}
 
-    // Initialize the set cover
-    set_create(matched_elements, elements_to_match->equals, NULL);
+/**
+ * @brief Private method to find the index slot of a value
+ * @param set Hashed set to search in
+ * @param value Value to search
+ * @return The slot holding the element of the value, NULL if the value isn't in the set
+ */
+static LinkedElement **set_indexFind(const Set *set, const void *value) {
+    int mask = set->index->capacity - 1;
+    int slot = set_indexSlot(set, value);
+    LinkedElement *current;
+
+    while ((current = set->index->slots[slot]) != NULL) {
+        if (current != &vacant && set->equals(value, list_value(current))) return &set->index->slots[slot];
+        slot = (slot + 1) & mask;
+    }
+    return NULL;
+}
 
-    // Continue until there are non-covering elements and candidates
+/**
+ * @brief Private method to insert an element inside the index, the index MUST have a free slot
+ * @param set Hashed set to index the element in
+ * @param element Set element to index
+ */
+static void set_indexInsert(Set *set, LinkedElement *element) {
+    int mask = set->index->capacity - 1;
+    int slot = set_indexSlot(set, list_value(element));
+
+    while (set->index->slots[slot] != NULL && set->index->slots[slot] != &vacant) slot = (slot + 1) & mask;
+    if (set->index->slots[slot] == NULL) set->index->used++;
+    set->index->slots[slot] = element;
+}
 
-    while (set_size(elements) > 0 && set_size(elements_to_match) > 0) {
-        // Search of the candidate covering the most elements as possible
-        max_size = 0;
+/**
+ * @brief Private method to ensure the index can hold one more element, rebuilding it if needed
+ * @param set Hashed set to reserve a slot in
+ * @return true if the index can hold one more element, false if the allocation failed
+ */
+static bool set_indexReserve(Set *set) {
+    ListIndex *index;
+    LinkedElement *current_element;
 
-        for (current_element = list_first(elements_to_match);
-             current_element != NULL; current_element = list_next(current_element)) {
-            if (!set_intersection(&intersection, &((KeySetEntry *) list_value(current_element))->set, elements))
-                return false;
+    if ((set->index->used + 1) * 4 <= set->index->capacity * 3) return true;
 
-            if (set_size(&intersection) > max_size) {
-                element_max = current_element;
-                max_size = set_size(&intersection);
-            }
+    // Rebuild the index from the set elements, it drops the vacant slots
+    if ((index = set_indexCreate(2 * (set_size(set) + 1))) == NULL) return false;
+    free(set->index->slots);
+    free(set->index);
+    set->index = index;
+
+    for (current_element = list_first(set); current_element != NULL; current_element = list_next(current_element))
+        set_indexInsert(set, current_element);
+    return true;
+}
 
-            set_destroy(&intersection);
+/**
+ * @brief Private method to append a value which is known to be absent from the set
+ * @param set Set to append the value in
+ * @param value Value to append
+ * @return true if the value was appended, false otherwise
+ */
+static bool set_append(Set *set, const void *value) {
+    if (set->index != NULL && !set_indexReserve(set)) return false;
+    if (!list_add(set, list_last(set), value)) return false;
+    if (set->index != NULL) set_indexInsert(set, list_last(set));
+    return true;
+}
+
+/**
+ * @brief Private method to create an operation result with the same backend as the given operand
+ * @param result Set to create
+ * @param model Operand to copy the backend from
+ * @param containers Expected number of elements for hashed results
+ * @return true if the result set was created, false otherwise
+ */
+static bool set_createFrom(Set *result, const Set *model, int containers) {
+    if (model->index != NULL) return set_createHashed(result, containers, model->hash, model->equals, NULL);
+    set_create(result, model->equals, NULL);
+    return true;
+}
+
+
+/**
+ * @brief Private method to find the id of an element to cover
+ * @param elements Elements to cover
+ * @param values Element values by id
+ * @param slots Open addressing table of ids + 1 when elements is hashed, NULL otherwise
+ * @param mask Number of slots - 1
+ * @param value Value to find
+ * @return The id of the value, -1 if the value isn't an element to cover
+ */
+static int set_coverFind(const Set *elements, void **values, const int *slots, int mask, const void *value) {
+    int slot, id;
+
+    if (slots == NULL) {
+        for (id = 0; id < set_size(elements); id++) {
+            if (elements->equals(value, values[id])) return id;
         }
+        return -1;
     }
 
-    // A covering isn't possible if there's no intersection
+    for (slot = (int) (set_hashValue(elements, value) & (uint32_t) mask); slots[slot] != 0; slot = (slot + 1) & mask) {
+        if (elements->equals(value, values[slots[slot] - 1])) return slots[slot] - 1;
+    }
+    return -1;
+}
 
-    if (max_size == 0) return false;
+/**
+ * @brief Private method to determine if the candidate a has priority over the candidate b
+ */
+static bool set_coverBefore(const int *gains, int a, int b) {
+    return gains[a] > gains[b] || (gains[a] == gains[b] && a < b);
+}
 
-    // Insert inside the covering the selected hashset
-    hashSet = (KeySetEntry *) list_value(element_max);
+/**
+ * @brief Private method to restore the candidates heap order from the given position down to the leaves
+ */
+static void set_coverSiftDown(int *heap, int size, const int *gains, int position) {
+    int candidate = heap[position], child;
+
+    while ((child = 2 * position + 1) < size) {
+        if (child + 1 < size && set_coverBefore(gains, heap[child + 1], heap[child])) child++;
+        if (!set_coverBefore(gains, heap[child], candidate)) break;
+        heap[position] = heap[child];
+        position = child;
+    }
+    heap[position] = candidate;
+}
+
+/**
+ * @brief Private method to remove from a set the values flagged by their rank, destroying them if needed
+ * @param set Set to remove the values from
+ * @param values Set values by rank
+ * @param flags Flag of each value rank, true to remove the value
+ * @return true if all the flagged values were removed, false otherwise
+ */
+static bool set_removeFlagged(Set *set, void **values, const bool *flags) {
+    LinkedElement *current_element, *next_element, *previous_element = NULL;
+    void *value;
+    int rank, size = set_size(set);
+
+    for (rank = 0; rank < size && set->index != NULL; rank++) {
+        // Hashed sets MUST keep their index synchronized
+        value = values[rank];
+        if (flags[rank] && !set_remove(set, &value)) return false;
+        if (flags[rank] && set->destroy != NULL) set->destroy(value);
+    }
+    if (set->index != NULL) return true;
+
+    // List sets unlink each flagged element from its previous one in a single pass
+    rank = 0;
+    for (current_element = list_first(set); current_element != NULL; current_element = next_element, rank++) {
+        next_element = list_next(current_element);
+        if (!flags[rank]) {
+            previous_element = current_element;
+            continue;
+        }
+        if (!list_remove(set, previous_element, &value)) return false;
+        if (set->destroy != NULL) set->destroy(value);
+    }
+    return true;
+}
+
+bool set_match_entries(Set *elements, Set *elements_to_match, Set *matched_elements) {
+    LinkedElement *current_element, *value_element;
+    KeySetEntry **entries;
+    void **values;
+    char *block;
+    int *slots, *offsets, *ids, *gains, *heap;
+    bool *covered, *selected, result;
+    int element_count = set_size(elements), candidate_count = set_size(elements_to_match);
+    int total = 0, uncovered = element_count, heap_size, id, mask = 0, i;
+
+    // Initialize the set cover
+    set_create(matched_elements, elements_to_match->equals, NULL);
+    if (element_count == 0) return true;
+
+    for (current_element = list_first(elements_to_match);
+         current_element != NULL; current_element = list_next(current_element))
+        total += set_size(&((KeySetEntry *) list_value(current_element))->set);
+    if (elements->index != NULL) {
+        mask = 16;
+        while (mask < 2 * element_count) mask <<= 1;
+    }
 
-    if (!set_add(matched_elements, hashSet)) return false;
+    // All the working arrays live in a single block
+    if ((block = (char *) calloc(1, (element_count + candidate_count) * sizeof(void *) +
+                                    (mask + total + 3 * (candidate_count + 1)) * sizeof(int) +
+                                    (element_count + candidate_count) * sizeof(bool))) == NULL)
+        return false;
+    values = (void **) block;
+    entries = (KeySetEntry **) (values + element_count);
+    slots = (int *) (entries + candidate_count);
+    offsets = slots + mask;
+    gains = offsets + candidate_count + 1;
+    heap = gains + candidate_count + 1;
+    ids = heap + candidate_count + 1;
+    covered = (bool *) (ids + total);
+    selected = covered + element_count;
+
+    // Elements to cover are identified by their rank in the elements set
+    id = 0;
+    for (current_element = list_first(elements); current_element != NULL; current_element = list_next(current_element))
+        values[id++] = list_value(current_element);
+    if (elements->index != NULL) {
+        for (id = 0, mask--; id < element_count; id++) {
+            int slot = (int) (set_hashValue(elements, values[id]) & (uint32_t) mask);
+            while (slots[slot] != 0) slot = (slot + 1) & mask;
+            slots[slot] = id + 1;
+        }
+    } else slots = NULL;
+
+    // Each candidate keeps the ids of the elements it covers, its initial gain is their count
+    offsets[0] = 0;
+    i = 0;
+    for (current_element = list_first(elements_to_match);
+         current_element != NULL; current_element = list_next(current_element), i++) {
+        entries[i] = (KeySetEntry *) list_value(current_element);
+        offsets[i + 1] = offsets[i];
+        for (value_element = list_first(&entries[i]->set);
+             value_element != NULL; value_element = list_next(value_element)) {
+            if ((id = set_coverFind(elements, values, slots, mask, list_value(value_element))) >= 0)
+                ids[offsets[i + 1]++] = id;
+        }
+        gains[i] = offsets[i + 1] - offsets[i];
+        heap[i] = i;
+    }
+    heap_size = candidate_count;
+    for (i = heap_size / 2 - 1; i >= 0; i--) set_coverSiftDown(heap, heap_size, gains, i);
+
+    // Lazy greedy: stored gains can only overestimate the real ones, so the top candidate is selected once its
+    // refreshed gain still beats every other stored gain
+    result = true;
+    while (uncovered > 0 && heap_size > 0 && result) {
+        int candidate = heap[0], gain = 0;
+
+        for (i = offsets[candidate]; i < offsets[candidate + 1]; i++) gain += !covered[ids[i]];
+        if (gain < gains[candidate]) {
+            gains[candidate] = gain;
+            set_coverSiftDown(heap, heap_size, gains, 0);
+            if (heap[0] != candidate) continue;
+        }
 
-    // Remove each current_element covered from the uncovered-elements set
-    for (current_element = list_first(&((KeySetEntry *) list_value(element_max))->set);
-         current_element != NULL; current_element = list_next(current_element)) {
-        value = list_value(current_element);
+        // A covering isn't possible if the best candidate has no intersection
+        if (gain == 0) break;
 
-        if (set_remove(elements, (void **) &value) && elements->destroy != NULL) elements->destroy(value);
+        // Insert inside the covering the selected candidate, then update the uncovered elements count
+        result = list_add(matched_elements, list_last(matched_elements), entries[candidate]);
+        selected[candidate] = true;
+        for (i = offsets[candidate]; i < offsets[candidate + 1]; i++) {
+            uncovered -= !covered[ids[i]];
+            covered[ids[i]] = true;
+        }
+        heap[0] = heap[--heap_size];
+        set_coverSiftDown(heap, heap_size, gains, 0);
     }
 
-    // Remove the hashset from the hashset candidates
+    // Remove the covered elements and the selected candidates
+    result = result && set_removeFlagged(elements, values, covered) &&
+             set_removeFlagged(elements_to_match, (void **) entries, selected);
 
-    if (!set_remove(elements_to_match, (void **) &hashSet)) return false;
+    free(block);
 
     // No covering if there's still non-covered elements
-    if (set_size(elements) > 0) return false;
-
-    return true;
+    return result && uncovered == 0;
 }
 
 void set_create(Set *set, bool (*equals)(const void *left, const void *right), void (*destroy)(void *value)) {
@@ -70,45 +356,83 @@ void set_create(Set *set, bool (*equals)(const void *left, const void *right), v
     set->equals = equals;
 }
 
+bool set_createHashed(Set *set,
+                      int containers,
+                      int (*hash)(const void *value),
+                      bool (*equals)(const void *left, const void *right),
+                      void (*destroy)(void *value)) {
+    set_create(set, equals, destroy);
+    if ((set->index = set_indexCreate(containers)) == NULL) return false;
+    set->hash = hash;
+    return true;
+}
+
+void set_destroy(Set *set) {
+    ListIndex *index = set->index;
+
+    // Values are destroyed by the list, the index only references list elements
+    list_destroy(set);
+    if (index != NULL) {
+        free(index->slots);
+        free(index);
+    }
+}
+
 bool set_add(Set *set, const void *value) {
     // No duplicated values
     if (set_isMember(set, value)) return false;
     // Add the value at the end
-    return list_add(set, list_last(set), value);
+    return set_append(set, value);
 }
 
 bool set_remove(Set *set, void **value) {
-    LinkedElement *current_element, *element_to_remove;
+    LinkedElement *current_element, *previous_element, *neighbour, **slot;
+    void *removed_value;
 
-    // Search for a value to remove
-
-    for (current_element = list_first(set); current_element != NULL; current_element = list_next(current_element)) {
-        if (set->equals(*value, list_value(current_element))) {
-            element_to_remove = current_element;
-            break;
+    if (set->index == NULL) {
+        // Search for a value to remove, list removal needs the previous element
+        previous_element = NULL;
+        for (current_element = list_first(set);
+             current_element != NULL; current_element = list_next(current_element)) {
+            if (set->equals(*value, list_value(current_element))) break;
+            previous_element = current_element;
         }
-    }
 
-    // Element not found case
+        // Element not found case
+        if (current_element == NULL) return false;
 
-    if (current_element == NULL) return false;
+        return list_remove(set, previous_element, value);
+    }
 
-    if (list_size(set) == 1) return list_remove(set, NULL, value);
-    else return list_remove(set, element_to_remove, value);
+    if ((slot = set_indexFind(set, *value)) == NULL) return false;
+    current_element = *slot;
+    *slot = &vacant;
+    removed_value = list_value(current_element);
+
+    if (current_element == list_first(set)) previous_element = NULL;
+    else {
+        // The previous element is unknown, so the value of a neighbour (the next element, or the head for the tail)
+        // is moved into the current element and the neighbour is removed instead
+        neighbour = list_next(current_element) != NULL ? list_next(current_element) : list_first(set);
+        previous_element = neighbour == list_first(set) ? NULL : current_element;
+        *set_indexFind(set, list_value(neighbour)) = current_element;
+        current_element->value = list_value(neighbour);
+    }
+
+    if (!list_remove(set, previous_element, value)) return false;
+    *value = removed_value;
+    return true;
 }
 
 bool set_union(Set *union_result, const Set *left, const Set *right) {
     LinkedElement *current_element;
-    void *value;
 
     // Create the union set
-    set_create(union_result, left->equals, NULL);
+    if (!set_createFrom(union_result, left, set_size(left) + set_size(right))) return false;
 
     // Insertion of left set elements
     for (current_element = list_first(left); current_element != NULL; current_element = list_next(current_element)) {
-        value = list_value(current_element);
-
-        if (!list_add(union_result, list_last(union_result), value)) {
+        if (!set_append(union_result, list_value(current_element))) {
             set_destroy(union_result);
             return false;
         }
@@ -117,12 +441,9 @@ bool set_union(Set *union_result, const Set *left, const Set *right) {
     // Insertion of right set elements
     for (current_element = list_first(right); current_element != NULL; current_element = list_next(current_element)) {
         if (set_isMember(left, list_value(current_element))) continue;
-        else {
-            value = list_value(current_element);
-            if (!list_add(union_result, list_last(union_result), value)) {
-                set_destroy(union_result);
-                return false;
-            }
+        if (!set_append(union_result, list_value(current_element))) {
+            set_destroy(union_result);
+            return false;
         }
     }
     return true;
@@ -130,22 +451,19 @@ bool set_union(Set *union_result, const Set *left, const Set *right) {
 
 bool set_intersection(Set *intersection_result, const Set *left, const Set *right) {
     LinkedElement *current_element;
-    void *value;
 
     // Create the intersection Set
-
-    set_create(intersection_result, left->equals, NULL);
+    if (!set_createFrom(intersection_result, left,
+                        set_size(left) < set_size(right) ? set_size(left) : set_size(right)))
+        return false;
 
     // intersection of elements in left and right set
-
     for (current_element = list_first(left); current_element != NULL; current_element = list_next(current_element)) {
         // If the current left element is in the right Set
-        if (set_isMember(right, list_value(current_element))) {
-            value = list_value(current_element);
-            if (!list_add(intersection_result, list_last(intersection_result), value)) {
-                set_destroy(intersection_result);
-                return false;
-            }
+        if (!set_isMember(right, list_value(current_element))) continue;
+        if (!set_append(intersection_result, list_value(current_element))) {
+            set_destroy(intersection_result);
+            return false;
         }
     }
     return true;
@@ -153,20 +471,17 @@ bool set_intersection(Set *intersection_result, const Set *left, const Set *righ
 
 bool set_difference(Set *difference_result, const Set *left, const Set *right) {
     LinkedElement *current_element;
-    void *value;
 
     // Creation of the difference Set
-    set_create(difference_result, left->equals, NULL);
+    if (!set_createFrom(difference_result, left, set_size(left))) return false;
 
     // Insert elements of left non present in right
     for (current_element = list_first(left); current_element != NULL; current_element = list_next(current_element)) {
         // If the current left value is not in the right set
-        if (!set_isMember(right, list_value(current_element))) {
-            value = list_value(current_element);
-            if (!list_add(difference_result, list_last(difference_result), value)) {
-                set_destroy(difference_result);
-                return false;
-            }
+        if (set_isMember(right, list_value(current_element))) continue;
+        if (!set_append(difference_result, list_value(current_element))) {
+            set_destroy(difference_result);
+            return false;
         }
     }
     return true;
@@ -175,8 +490,10 @@ bool set_difference(Set *difference_result, const Set *left, const Set *right) {
 bool set_isMember(const Set *set, const void *value) {
     LinkedElement *current_element;
 
-    // Determine if the value is in set
+    // Hashed sets only probe the value's slots
+    if (set->index != NULL) return set_indexFind(set, value) != NULL;
 
+    // Determine if the value is in set
     for (current_element = list_first(set); current_element != NULL; current_element = list_next(current_element)) {
         // If any equals occur, then return true
         if (set->equals(value, list_value(current_element))) {
@@ -212,4 +529,361 @@ bool set_equals(const Set *left, const Set *right) {
     }
 
     return true;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Private method to find the rank of the first value not lower than key using an exponential search
+ * @param values Sorted values to search in
+ * @param begin Rank to start the search from
+ * @param size Number of values
+ * @param key Value to search
+ * @param compare User compare function
+ * @return The rank of the first value greater or equal to key, size if there is none
+ */
+static int sortedset_gallop(void *const *values, int begin, int size, const void *key,
+                            int (*compare)(const void *key1, const void *key2)) {
+    int low = begin, high, step = 1;
+
+    // Double the step until a value not lower than key is passed
+    while (begin + step < size && compare(values[begin + step], key) < 0) {
+        low = begin + step;
+        step <<= 1;
+    }
+    high = begin + step < size ? begin + step + 1 : size;
+
+    // Binary search inside the last step
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (compare(values[middle], key) < 0) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+/**
+ * @brief Private method to ensure a sorted set can hold the given number of values
+ * @param set Sorted set to grow
+ * @param capacity Number of values the set must hold
+ * @return true if the set can hold the given number of values, false otherwise
+ */
+static bool sortedset_reserve(SortedSet *set, int capacity) {
+    void **values;
+
+    if (capacity <= set->capacity) return true;
+    if ((values = (void **) realloc(set->values, capacity * sizeof(void *))) == NULL) return false;
+    set->values = values;
+    set->capacity = capacity;
+    return true;
+}
+
+/**
+ * @brief Private method to sort an array of values with a bottom-up merge sort
+ * @param values Values to sort
+ * @param scratch Buffer of the same size as values
+ * @param count Number of values
+ * @param compare User compare function
+ * @return The buffer holding the sorted values, either values or scratch
+ */
+static void **sortedset_sort(void **values, void **scratch, int count,
+                             int (*compare)(const void *key1, const void *key2)) {
+    int width, i;
+
+    for (width = 1; width < count; width *= 2) {
+        for (i = 0; i < count; i += 2 * width) {
+            int left = i, middle = i + width < count ? i + width : count;
+            int right = middle, end = i + 2 * width < count ? i + 2 * width : count, k = i;
+
+            while (left < middle && right < end)
+                scratch[k++] = compare(values[right], values[left]) < 0 ? values[right++] : values[left++];
+            while (left < middle) scratch[k++] = values[left++];
+            while (right < end) scratch[k++] = values[right++];
+        }
+        void **temp = values;
+        values = scratch;
+        scratch = temp;
+    }
+    return values;
+}
+
+bool sortedset_create(SortedSet *set, int capacity, int (*compare)(const void *key1, const void *key2),
+                      void (*destroy)(void *value)) {
+    set->size = 0;
+    set->capacity = 0;
+    set->values = NULL;
+    set->compare = compare;
+    set->destroy = destroy;
+    return capacity <= 0 || sortedset_reserve(set, capacity);
+}
+
+bool sortedset_fromArray(SortedSet *set, void **values, int count, int (*compare)(const void *key1, const void *key2),
+                         void (*destroy)(void *value)) {
+    void **scratch, **sorted;
+    int i;
+
+    if (!sortedset_create(set, count, compare, destroy)) return false;
+    if (count <= 0) return true;
+    if ((scratch = (void **) malloc(count * sizeof(void *))) == NULL) {
+        sortedset_destroy(set);
+        return false;
+    }
+
+    memcpy(set->values, values, count * sizeof(void *));
+    sorted = sortedset_sort(set->values, scratch, count, compare);
+
+    // Keep the first value of each run of equal values
+    for (i = 0; i < count; i++) {
+        if (set->size == 0 || compare(set->values[set->size - 1], sorted[i]) != 0)
+            set->values[set->size++] = sorted[i];
+    }
+    free(scratch);
+    return true;
+}
+
+void sortedset_destroy(SortedSet *set) {
+    int i;
+
+    if (set->destroy != NULL) {
+        for (i = 0; i < set->size; i++) set->destroy(set->values[i]);
+    }
+    free(set->values);
+    memset(set, 0, sizeof(SortedSet));
+}
+
+void sortedset_clear(SortedSet *set) {
+    set->size = 0;
+}
+
+bool sortedset_add(SortedSet *set, const void *value) {
+    int rank = sortedset_gallop(set->values, 0, set->size, value, set->compare);
+
+    // No duplicated values
+    if (rank < set->size && set->compare(set->values[rank], value) == 0) return false;
+    if (set->size == set->capacity && !sortedset_reserve(set, set->capacity < 8 ? 8 : 2 * set->capacity))
+        return false;
+
+    memmove(&set->values[rank + 1], &set->values[rank], (set->size - rank) * sizeof(void *));
+    set->values[rank] = (void *) value;
+    set->size++;
+    return true;
+}
+
+bool sortedset_remove(SortedSet *set, void **value) {
+    int rank = sortedset_gallop(set->values, 0, set->size, *value, set->compare);
+
+    if (rank == set->size || set->compare(set->values[rank], *value) != 0) return false;
+
+    *value = set->values[rank];
+    memmove(&set->values[rank], &set->values[rank + 1], (set->size - rank - 1) * sizeof(void *));
+    set->size--;
+    return true;
+}
+
+bool sortedset_isMember(const SortedSet *set, const void *value) {
+    int low = 0, high = set->size;
+
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        int order = set->compare(set->values[middle], value);
+        if (order == 0) return true;
+        if (order < 0) low = middle + 1;
+        else high = middle;
+    }
+    return false;
+}
+
+bool sortedset_union(SortedSet *union_result, const SortedSet *left, const SortedSet *right) {
+    int i = 0, j = 0, k = 0;
+    void **out;
+
+    sortedset_clear(union_result);
+    if (!sortedset_reserve(union_result, left->size + right->size)) return false;
+    out = union_result->values;
+
+    if (left->size > SORTEDSET_GALLOP_RATIO * right->size) {
+        // Copy the left runs between right values
+        for (j = 0; j < right->size; j++) {
+            int rank = sortedset_gallop(left->values, i, left->size, right->values[j], left->compare);
+            memcpy(&out[k], &left->values[i], (rank - i) * sizeof(void *));
+            k += rank - i;
+            i = rank;
+            if (i < left->size && left->compare(left->values[i], right->values[j]) == 0) out[k++] = left->values[i++];
+            else out[k++] = right->values[j];
+        }
+    } else if (right->size > SORTEDSET_GALLOP_RATIO * left->size) {
+        // Copy the right runs between left values
+        for (i = 0; i < left->size; i++) {
+            int rank = sortedset_gallop(right->values, j, right->size, left->values[i], left->compare);
+            memcpy(&out[k], &right->values[j], (rank - j) * sizeof(void *));
+            k += rank - j;
+            j = rank;
+            if (j < right->size && left->compare(left->values[i], right->values[j]) == 0) j++;
+            out[k++] = left->values[i];
+        }
+    } else {
+        while (i < left->size && j < right->size) {
+            int order = left->compare(left->values[i], right->values[j]);
+            if (order <= 0) {
+                out[k++] = left->values[i++];
+                if (order == 0) j++;
+            } else out[k++] = right->values[j++];
+        }
+    }
+
+    // Remaining values of one of the operands
+    memcpy(&out[k], &left->values[i], (left->size - i) * sizeof(void *));
+    k += left->size - i;
+    memcpy(&out[k], &right->values[j], (right->size - j) * sizeof(void *));
+    union_result->size = k + right->size - j;
+    return true;
+}
+
+bool sortedset_intersection(SortedSet *intersection_result, const SortedSet *left, const SortedSet *right) {
+    int i = 0, j = 0, k = 0;
+    void **out;
+
+    sortedset_clear(intersection_result);
+    if (!sortedset_reserve(intersection_result, left->size < right->size ? left->size : right->size)) return false;
+    out = intersection_result->values;
+
+    if (left->size > SORTEDSET_GALLOP_RATIO * right->size) {
+        for (j = 0; j < right->size && i < left->size; j++) {
+            i = sortedset_gallop(left->values, i, left->size, right->values[j], left->compare);
+            if (i < left->size && left->compare(left->values[i], right->values[j]) == 0) out[k++] = left->values[i++];
+        }
+    } else if (right->size > SORTEDSET_GALLOP_RATIO * left->size) {
+        for (i = 0; i < left->size && j < right->size; i++) {
+            j = sortedset_gallop(right->values, j, right->size, left->values[i], left->compare);
+            if (j < right->size && left->compare(left->values[i], right->values[j]) == 0) out[k++] = left->values[i];
+        }
+    } else {
+        while (i < left->size && j < right->size) {
+            int order = left->compare(left->values[i], right->values[j]);
+            if (order == 0) out[k++] = left->values[i];
+            i += order <= 0;
+            j += order >= 0;
+        }
+    }
+    intersection_result->size = k;
+    return true;
+}
+
+bool sortedset_difference(SortedSet *difference_result, const SortedSet *left, const SortedSet *right) {
+    int i = 0, j = 0, k = 0;
+    void **out;
+
+    sortedset_clear(difference_result);
+    if (!sortedset_reserve(difference_result, left->size)) return false;
+    out = difference_result->values;
+
+    if (left->size > SORTEDSET_GALLOP_RATIO * right->size) {
+        // Copy the left runs between right values, skipping the common values
+        for (j = 0; j < right->size && i < left->size; j++) {
+            int rank = sortedset_gallop(left->values, i, left->size, right->values[j], left->compare);
+            memcpy(&out[k], &left->values[i], (rank - i) * sizeof(void *));
+            k += rank - i;
+            i = rank;
+            if (i < left->size && left->compare(left->values[i], right->values[j]) == 0) i++;
+        }
+    } else if (right->size > SORTEDSET_GALLOP_RATIO * left->size) {
+        for (; i < left->size && j < right->size; i++) {
+            j = sortedset_gallop(right->values, j, right->size, left->values[i], left->compare);
+            if (j == right->size || left->compare(left->values[i], right->values[j]) != 0) out[k++] = left->values[i];
+        }
+    } else {
+        while (i < left->size && j < right->size) {
+            int order = left->compare(left->values[i], right->values[j]);
+            if (order < 0) out[k++] = left->values[i];
+            i += order <= 0;
+            j += order >= 0;
+        }
+    }
+
+    // Remaining left values are not in right
+    memcpy(&out[k], &left->values[i], (left->size - i) * sizeof(void *));
+    difference_result->size = k + left->size - i;
+    return true;
+}
+
+bool sortedset_isSubset(const SortedSet *left, const SortedSet *right) {
+    int i, j = 0;
+
+    // Quick test to eliminate some usual cases
+    if (left->size > right->size) return false;
+
+    for (i = 0; i < left->size; i++) {
+        if (right->size > SORTEDSET_GALLOP_RATIO * left->size)
+            j = sortedset_gallop(right->values, j, right->size, left->values[i], left->compare);
+        else while (j < right->size && left->compare(right->values[j], left->values[i]) < 0) j++;
+
+        if (j == right->size || left->compare(left->values[i], right->values[j]) != 0) return false;
+        j++;
+    }
+    return true;
+}
+
+bool sortedset_equals(const SortedSet *left, const SortedSet *right) {
+    int i;
+
+    if (left->size != right->size) return false;
+    for (i = 0; i < left->size; i++) {
+        if (left->compare(left->values[i], right->values[i]) != 0) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Private scalar kernel intersecting two sorted integer arrays with a branchless merge
+ */
+static int sortedset_intersectIntScalar(const int *left, int left_size, const int *right, int right_size, int *out) {
+    int i = 0, j = 0, k = 0;
+
+    while (i < left_size && j < right_size) {
+        int a = left[i], b = right[j];
+        out[k] = a;
+        k += a == b;
+        i += a <= b;
+        j += a >= b;
+    }
+    return k;
+}
+
+#if COLLECTIONS_SIMD_AVX2
+
+/**
+ * @brief Private AVX2 kernel intersecting a small sorted integer array with a much larger one
+ * @details Blocks of 8 large values are skipped with a single comparison, then each small value is
+ * compared against a whole block at once
+ */
+COLLECTIONS_TARGET_AVX2
+static int sortedset_intersectIntAvx2(const int *small, int small_size, const int *large, int large_size, int *out) {
+    int i, j = 0, k = 0;
+
+    for (i = 0; i < small_size; i++) {
+        int key = small[i];
+
+        while (j + 8 <= large_size && large[j + 7] < key) j += 8;
+        if (j + 8 <= large_size) {
+            __m256i block = _mm256_loadu_si256((const __m256i *) &large[j]);
+            __m256i match = _mm256_cmpeq_epi32(block, _mm256_set1_epi32(key));
+            if (_mm256_movemask_epi8(match) != 0) out[k++] = key;
+        } else {
+            while (j < large_size && large[j] < key) j++;
+            if (j == large_size) break;
+            if (large[j] == key) out[k++] = key;
+        }
+    }
+    return k;
+}
+
+#endif
+
+int sortedset_intersectInt(const int *left, int left_size, const int *right, int right_size, int *out) {
+#if COLLECTIONS_SIMD_AVX2
+    // Block comparisons only pay when one operand is much smaller
+    if (simd_hasAvx2()) {
+        if (right_size >= 8 * left_size) return sortedset_intersectIntAvx2(left, left_size, right, right_size, out);
+        if (left_size >= 8 * right_size) return sortedset_intersectIntAvx2(right, right_size, left, left_size, out);
+    }
+#endif
+    return sortedset_intersectIntScalar(left, left_size, right, right_size, out);
+}
@@ -0,0 +1,20 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#include "simd_utils.h"
+
+bool simd_hasAvx2(void) {
+#if COLLECTIONS_SIMD_AVX2
+    static int avx2 = -1;
+
+    // CPU features never change during the process lifetime
+    if (avx2 < 0) {
+        __builtin_cpu_init();
+        avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return avx2 == 1;
+#else
+    return false;
+#endif
+}
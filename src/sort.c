@@ -2,8 +2,256 @@
 // Created by maxim on 24/02/2024.
 //
 
+#include <stdint.h>
 #include "sort.h"
 #include "arrays_utils.h"
+#include "simd_utils.h"
+
+#if COLLECTIONS_SIMD_AVX2
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Number of elements under which a partition is sorted by insertion
+ */
+#define SORT_INSERTION_THRESHOLD 24
+
+/**
+ * @brief Number of elements above which the pivot is the median of three medians
+ */
+#define SORT_NINTHER_THRESHOLD 128
+
+/**
+ * @brief Number of element moves after which the insertion sort of an already partitioned range gives up
+ */
+#define SORT_PARTIAL_INSERTION_LIMIT 8
+
+/**
+ * @brief Number of bytes swapped at once for the elements without a dedicated swap
+ */
+#define SORT_SWAP_BLOCK 64
+
+/**
+ * @brief Initial number of consecutive wins of a run after which the stable merge switches to galloping
+ */
+#define SORT_MIN_GALLOP 7
+
+/**
+ * @brief Maximum number of pending runs of a stable sort, the run lengths grow at least like Fibonacci numbers
+ */
+#define SORT_MAX_RUNS 64
+
+/**
+ * @brief Number of elements under which a parallel sort is sequential
+ */
+#define SORT_PARALLEL_THRESHOLD 65536
+
+/**
+ * @brief Minimal number of elements sorted or merged by a task of a parallel sort
+ */
+#define SORT_PARALLEL_GRAIN 8192
+
+/**
+ * @brief int32 elements of the typed sorts, the float sort reads its elements through it
+ */
+#if defined(__GNUC__) || defined(__clang__)
+typedef int32_t __attribute__((may_alias)) SortInt32;
+#else
+typedef int32_t SortInt32;
+#endif
+
+/**
+ * @brief Parallel merge sort of a range, the range has the same offset in the array and in the scratch buffer
+ */
+typedef struct SortTask {
+    /**
+     * @brief First element of the range in the array
+     */
+    char *base;
+    /**
+     * @brief First element of the range in the scratch buffer
+     */
+    char *scratch;
+    /**
+     * @brief Number of elements of the range
+     */
+    size_t count;
+    /**
+     * @brief Size of an element in bytes
+     */
+    size_t size;
+    /**
+     * @brief Number of elements under which the range is sorted sequentially
+     */
+    size_t grain;
+    /**
+     * @brief true to leave the sorted range in the scratch buffer, false to leave it in the array
+     */
+    bool toScratch;
+    /**
+     * @brief User compare function
+     */
+    int (*compare)(const void *key1, const void *key2);
+} SortTask;
+
+/**
+ * @brief Parallel merge of two sorted ranges into an output range
+ */
+typedef struct SortMerge {
+    /**
+     * @brief First sorted range
+     */
+    const char *first;
+    /**
+     * @brief Number of elements of the first range
+     */
+    size_t count1;
+    /**
+     * @brief Second sorted range
+     */
+    const char *second;
+    /**
+     * @brief Number of elements of the second range
+     */
+    size_t count2;
+    /**
+     * @brief Output range of count1 + count2 elements
+     */
+    char *output;
+    /**
+     * @brief Size of an element in bytes
+     */
+    size_t size;
+    /**
+     * @brief User compare function
+     */
+    int (*compare)(const void *key1, const void *key2);
+} SortMerge;
+
+/**
+ * @brief Pending run of a stable sort
+ */
+typedef struct SortRun {
+    /**
+     * @brief First element of the run
+     */
+    char *base;
+    /**
+     * @brief Number of elements of the run
+     */
+    size_t length;
+} SortRun;
+
+/**
+ * @brief Cursor over a sorted view merged by array_mergeRuns
+ */
+typedef struct SortCursor {
+    /**
+     * @brief Merged view
+     */
+    const ArrayView *view;
+    /**
+     * @brief Index of the next element to pull
+     */
+    int position;
+} SortCursor;
+
+/**
+ * @brief State of a stable sort
+ */
+typedef struct StableSort {
+    /**
+     * @brief Size of an element in bytes
+     */
+    size_t size;
+    /**
+     * @brief User compare function
+     */
+    int (*compare)(const void *key1, const void *key2);
+    /**
+     * @brief true if the elements are pointers to the compared values
+     */
+    bool indirect;
+    /**
+     * @brief Buffer of half the elements holding the smallest run of a merge
+     */
+    char *scratch;
+    /**
+     * @brief Current number of consecutive wins to start galloping
+     */
+    size_t minGallop;
+    /**
+     * @brief Number of pending runs
+     */
+    int runCount;
+    /**
+     * @brief Pending runs, from the first to the last one of the array
+     */
+    SortRun runs[SORT_MAX_RUNS];
+} StableSort;
+
+/**
+ * @brief Number of buckets of a radix pass, one per byte value
+ */
+#define SORT_RADIX_BUCKETS 256
+
+/**
+ * @brief Maximum number of byte passes of an integer radix sort
+ */
+#define SORT_RADIX_PASSES 8
+
+/**
+ * @brief Number of strings under which a string bucket is sorted by insertion
+ */
+#define SORT_STRING_INSERTION 32
+
+/**
+ * @brief Byte counts of a chunk of a radix sort, for each pass
+ */
+typedef struct RadixHistogram {
+    /**
+     * @brief Number of elements of each byte value, for each pass
+     */
+    size_t counts[SORT_RADIX_PASSES][SORT_RADIX_BUCKETS];
+} RadixHistogram;
+
+/**
+ * @brief Histogram of the bytes of a radix sort, counted by chunks on the threads of a pool
+ */
+typedef struct RadixCount {
+    /**
+     * @brief First element to count
+     */
+    const char *base;
+    /**
+     * @brief Number of elements to count
+     */
+    size_t count;
+    /**
+     * @brief Size of an element in bytes
+     */
+    size_t size;
+    /**
+     * @brief User key function, NULL if the elements are the keys
+     */
+    uint64_t (*key)(const void *element);
+    /**
+     * @brief Number of byte passes, the bytes of the strings are counted at depth for a single pass
+     */
+    int passes;
+    /**
+     * @brief Offset of the counted byte in the strings, the elements are strings if not SIZE_MAX
+     */
+    size_t depth;
+    /**
+     * @brief Number of chunks
+     */
+    int chunks;
+    /**
+     * @brief Counts of each chunk
+     */
+    RadixHistogram *histograms;
+} RadixCount;
 
 bool
 array_is_sort(void *value, int element_count, size_t element_size, int (*compare)(const void *key1, const void *key2)) {
@@ -35,18 +283,1592 @@ array_is_sort(void *value, int element_count, size_t element_size, int (*compare
     return true;
 }
 
-void array_split(void ***out, int *out_size, void *in, int start_index, int stop_index) {
-    void **out_ptr = *out;
-    char *in_ptr = (char *) in;
+/**
+ * @brief Private method to swap two elements, the 4, 8 and 16 bytes elements are swapped through registers
+ */
+static void sort_swap(char *a, char *b, size_t size) {
+    unsigned char block[SORT_SWAP_BLOCK];
+    uint64_t wide[2];
+    uint32_t narrow;
+    size_t chunk;
+
+    switch (size) {
+        case 4:
+            memcpy(&narrow, a, 4);
+            memcpy(a, b, 4);
+            memcpy(b, &narrow, 4);
+            return;
+        case 8:
+            memcpy(wide, a, 8);
+            memcpy(a, b, 8);
+            memcpy(b, wide, 8);
+            return;
+        case 16:
+            memcpy(wide, a, 16);
+            memcpy(a, b, 16);
+            memcpy(b, wide, 16);
+            return;
+        default:
+            for (; size > 0; size -= chunk, a += chunk, b += chunk) {
+                chunk = size < SORT_SWAP_BLOCK ? size : SORT_SWAP_BLOCK;
+                memcpy(block, a, chunk);
+                memcpy(a, b, chunk);
+                memcpy(b, block, chunk);
+            }
+    }
+}
+
+/**
+ * @brief Private method to copy an element, the 4, 8 and 16 bytes elements are copied through registers
+ */
+static void sort_copy(char *destination, const char *source, size_t size) {
+    switch (size) {
+        case 4:
+            memcpy(destination, source, 4);
+            return;
+        case 8:
+            memcpy(destination, source, 8);
+            return;
+        case 16:
+            memcpy(destination, source, 16);
+            return;
+        default:
+            memcpy(destination, source, size);
+    }
+}
+
+/**
+ * @brief Private method to sort three elements in place
+ */
+static void sort_three(char *a, char *b, char *c, size_t size, int (*compare)(const void *key1, const void *key2)) {
+    if (compare(b, a) < 0) sort_swap(a, b, size);
+    if (compare(c, b) < 0) {
+        sort_swap(b, c, size);
+        if (compare(b, a) < 0) sort_swap(a, b, size);
+    }
+}
+
+/**
+ * @brief Private method to sort a small range by insertion
+ */
+static void sort_insertion(char *begin, char *end, size_t size, int (*compare)(const void *key1, const void *key2)) {
+    char *i, *j;
+
+    for (i = begin + size; i < end; i += size) {
+        for (j = i; j > begin && compare(j - size, j) > 0; j -= size) sort_swap(j - size, j, size);
+    }
+}
+
+/**
+ * @brief Private method to sort a range by insertion unless more than a few elements have to move
+ * @return true if the range is sorted, false if the insertion sort gave up
+ */
+static bool sort_partialInsertion(char *begin, char *end, size_t size,
+                                  int (*compare)(const void *key1, const void *key2)) {
+    size_t moves = 0;
+    char *i, *j;
+
+    for (i = begin + size; i < end; i += size) {
+        for (j = i; j > begin && compare(j - size, j) > 0; j -= size) sort_swap(j - size, j, size);
+        moves += (size_t) (i - j) / size;
+        if (moves > SORT_PARTIAL_INSERTION_LIMIT) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Private method to move down an element of a max heap while a child is greater
+ */
+static void sort_siftDown(char *base, size_t root, size_t count, size_t size,
+                          int (*compare)(const void *key1, const void *key2)) {
+    size_t child;
+
+    while ((child = 2 * root + 1) < count) {
+        if (child + 1 < count && compare(base + child * size, base + (child + 1) * size) < 0) child++;
+        if (compare(base + root * size, base + child * size) >= 0) return;
+        sort_swap(base + root * size, base + child * size, size);
+        root = child;
+    }
+}
+
+/**
+ * @brief Private method to heapsort a range, the fallback of the partitions that keep being unbalanced
+ */
+static void sort_heap(char *begin, char *end, size_t size, int (*compare)(const void *key1, const void *key2)) {
+    size_t count = (size_t) (end - begin) / size;
+    size_t i;
+
+    for (i = count / 2; i > 0; i--) sort_siftDown(begin, i - 1, count, size, compare);
+    for (i = count - 1; i > 0; i--) {
+        sort_swap(begin, begin + i * size, size);
+        sort_siftDown(begin, 0, i, size, compare);
+    }
+}
+
+/**
+ * @brief Private method to partition a range around its first element, the elements equal to the pivot go right
+ * @param partitioned Set to true if no element had to be swapped
+ * @return The final position of the pivot
+ */
+static char *sort_partitionRight(char *begin, char *end, size_t size,
+                                 int (*compare)(const void *key1, const void *key2), bool *partitioned) {
+    char *first = begin + size;
+    char *last = end - size;
+
+    while (first <= last && compare(first, begin) < 0) first += size;
+    while (first <= last && compare(last, begin) >= 0) last -= size;
+    *partitioned = first > last;
+
+    // Each swap leaves a stopper for both scans, they don't need bounds checks anymore
+    while (first < last) {
+        sort_swap(first, last, size);
+        do first += size; while (compare(first, begin) < 0);
+        do last -= size; while (compare(last, begin) >= 0);
+    }
+    sort_swap(begin, first - size, size);
+    return first - size;
+}
+
+/**
+ * @brief Private method to partition a range around its first element, the elements equal to the pivot go left
+ * @return The final position of the pivot, every element before it is equal to it
+ */
+static char *sort_partitionLeft(char *begin, char *end, size_t size,
+                                int (*compare)(const void *key1, const void *key2)) {
+    char *first = begin + size;
+    char *last = end - size;
+
+    while (first <= last && compare(begin, last) < 0) last -= size;
+    while (first <= last && compare(begin, first) >= 0) first += size;
+    while (first < last) {
+        sort_swap(first, last, size);
+        do last -= size; while (compare(begin, last) < 0);
+        do first += size; while (compare(begin, first) >= 0);
+    }
+    sort_swap(begin, last, size);
+    return last;
+}
+
+/**
+ * @brief Private method to move the pivot of a range to its first element, the median of three medians for large
+ * ranges. The last element doesn't go before the pivot so it stops the scans of the partitions
+ */
+static void sort_choosePivot(char *begin, char *end, size_t count, size_t size,
+                             int (*compare)(const void *key1, const void *key2)) {
+    char *middle = begin + count / 2 * size;
+
+    if (count > SORT_NINTHER_THRESHOLD) {
+        sort_three(begin, middle, end - size, size, compare);
+        sort_three(begin + size, middle - size, end - 2 * size, size, compare);
+        sort_three(begin + 2 * size, middle + size, end - 3 * size, size, compare);
+        sort_three(middle - size, middle, middle + size, size, compare);
+        sort_swap(begin, middle, size);
+    } else {
+        sort_three(middle, begin, end - size, size, compare);
+    }
+}
+
+/**
+ * @brief Private method to shuffle some elements of both sides of an unbalanced partition, to break the pattern that
+ * produced it
+ */
+static void sort_breakPatterns(char *begin, char *pivot, char *end, size_t size) {
+    size_t left = (size_t) (pivot - begin) / size;
+    size_t right = (size_t) (end - pivot) / size - 1;
+
+    if (left >= SORT_INSERTION_THRESHOLD) {
+        sort_swap(begin, begin + left / 4 * size, size);
+        sort_swap(pivot - size, pivot - left / 4 * size, size);
+    }
+    if (right >= SORT_INSERTION_THRESHOLD) {
+        sort_swap(pivot + size, pivot + (1 + right / 4) * size, size);
+        sort_swap(end - size, end - right / 4 * size, size);
+    }
+}
+
+/**
+ * @brief Private method to sort a range with the pattern-defeating quicksort, the smaller side is recursed on
+ * @param unbalanced Number of unbalanced partitions allowed before switching to heapsort
+ * @param leftmost true if no element lies before the range, false if the element before it is lower or equal to all
+ */
+static void sort_pdq(char *begin, char *end, size_t size, int (*compare)(const void *key1, const void *key2),
+                     int unbalanced, bool leftmost) {
+    size_t count, left, right;
+    char *pivot;
+    bool partitioned;
+
+    for (;;) {
+        count = (size_t) (end - begin) / size;
+        if (count < SORT_INSERTION_THRESHOLD) {
+            sort_insertion(begin, end, size, compare);
+            return;
+        }
+
+        sort_choosePivot(begin, end, count, size, compare);
+
+        // A pivot equal to the element before the range is its minimum, the equal elements are done at once
+        if (!leftmost && compare(begin - size, begin) >= 0) {
+            begin = sort_partitionLeft(begin, end, size, compare) + size;
+            continue;
+        }
+
+        pivot = sort_partitionRight(begin, end, size, compare, &partitioned);
+        left = (size_t) (pivot - begin) / size;
+        right = (size_t) (end - pivot) / size - 1;
+        if (left < count / 8 || right < count / 8) {
+            if (--unbalanced == 0) {
+                sort_heap(begin, end, size, compare);
+                return;
+            }
+            sort_breakPatterns(begin, pivot, end, size);
+        } else if (partitioned && sort_partialInsertion(begin, pivot, size, compare) &&
+                   sort_partialInsertion(pivot + size, end, size, compare)) {
+            // The range was already sorted or nearly
+            return;
+        }
+
+        if (left < right) {
+            sort_pdq(begin, pivot, size, compare, unbalanced, leftmost);
+            begin = pivot + size;
+            leftmost = false;
+        } else {
+            sort_pdq(pivot + size, end, size, compare, unbalanced, false);
+            end = pivot;
+        }
+    }
+}
+
+void array_sort(void *base, int count, size_t size, int (*compare)(const void *key1, const void *key2)) {
+    int unbalanced = 0;
+    int bits;
+
+    if (base == NULL || count < 2 || size == 0) return;
+    for (bits = count; bits > 1; bits >>= 1) unbalanced++;
+    sort_pdq((char *) base, (char *) base + (size_t) count * size, size, compare, unbalanced, true);
+}
+
+void array_nthElement(void *base, int count, size_t size, int nth,
+                      int (*compare)(const void *key1, const void *key2)) {
+    char *begin = (char *) base;
+    char *end, *target, *pivot;
+    size_t length, left, right;
+    int unbalanced = 0;
+    bool leftmost = true;
+    bool partitioned;
+    int bits;
+
+    if (base == NULL || size == 0 || nth < 0 || nth >= count) return;
+    for (bits = count; bits > 1; bits >>= 1) unbalanced++;
+    end = begin + (size_t) count * size;
+    target = begin + (size_t) nth * size;
+
+    // Only the side of each partition holding the target is kept
+    for (;;) {
+        length = (size_t) (end - begin) / size;
+        if (length < SORT_INSERTION_THRESHOLD) {
+            sort_insertion(begin, end, size, compare);
+            return;
+        }
+        sort_choosePivot(begin, end, length, size, compare);
+
+        // The elements equal to the minimum of the range are at their sorted position
+        if (!leftmost && compare(begin - size, begin) >= 0) {
+            begin = sort_partitionLeft(begin, end, size, compare) + size;
+            if (target < begin) return;
+            continue;
+        }
+
+        pivot = sort_partitionRight(begin, end, size, compare, &partitioned);
+        if (pivot == target) return;
+        left = (size_t) (pivot - begin) / size;
+        right = (size_t) (end - pivot) / size - 1;
+        if (left < length / 8 || right < length / 8) {
+            if (--unbalanced == 0) {
+                sort_heap(begin, end, size, compare);
+                return;
+            }
+            sort_breakPatterns(begin, pivot, end, size);
+        }
+
+        if (target < pivot) {
+            end = pivot;
+        } else {
+            begin = pivot + size;
+            leftmost = false;
+        }
+    }
+}
+
+void array_partialSort(void *base, int count, size_t size, int k, int (*compare)(const void *key1, const void *key2)) {
+    if (base == NULL || size == 0 || k <= 0 || count < 2) return;
+    if (k >= count) {
+        array_sort(base, count, size, compare);
+        return;
+    }
+
+    // The k - 1 elements before the selected one are the lowest ones, only they remain to be sorted
+    array_nthElement(base, count, size, k - 1, compare);
+    array_sort(base, k - 1, size, compare);
+}
+
+/**
+ * @brief Private method to move up the last element of a max heap while its parent is lower
+ */
+static void sort_siftUp(char *base, size_t child, size_t size, int (*compare)(const void *key1, const void *key2)) {
+    size_t parent;
+
+    while (child > 0) {
+        parent = (child - 1) / 2;
+        if (compare(base + parent * size, base + child * size) >= 0) return;
+        sort_swap(base + parent * size, base + child * size, size);
+        child = parent;
+    }
+}
+
+bool topk_create(TopK *topk, int k, size_t size, int (*compare)(const void *key1, const void *key2)) {
+    if (k < 1 || size == 0 || (size_t) k > SIZE_MAX / size) return false;
+    if ((topk->elements = (char *) malloc((size_t) k * size)) == NULL) return false;
+    topk->size = 0;
+    topk->k = k;
+    topk->elementSize = size;
+    topk->compare = compare;
+    return true;
+}
+
+void topk_destroy(TopK *topk) {
+    free(topk->elements);
+    topk->elements = NULL;
+    topk->size = 0;
+}
+
+bool topk_push(TopK *topk, const void *element) {
+    size_t size = topk->elementSize;
+
+    if (topk->size < topk->k) {
+        memcpy(topk->elements + (size_t) topk->size * size, element, size);
+        sort_siftUp(topk->elements, (size_t) topk->size++, size, topk->compare);
+        return true;
+    }
+
+    // Once full, only an element going before the greatest kept one replaces it
+    if (topk->compare(element, topk->elements) >= 0) return false;
+    memcpy(topk->elements, element, size);
+    sort_siftDown(topk->elements, 0, (size_t) topk->size, size, topk->compare);
+    return true;
+}
+
+void topk_pushArray(TopK *topk, const void *base, int count) {
+    const char *element = (const char *) base;
+    int i;
+
+    for (i = 0; i < count; i++, element += topk->elementSize) topk_push(topk, element);
+}
+
+int topk_result(const TopK *topk, void *out) {
+    if (topk->size == 0) return 0;
+    memcpy(out, topk->elements, (size_t) topk->size * topk->elementSize);
+    sort_heap((char *) out, (char *) out + (size_t) topk->size * topk->elementSize, topk->elementSize,
+              topk->compare);
+    return topk->size;
+}
+
+/**
+ * @brief Private method to determine if the current element of a run wins over the one of another run, an exhausted
+ * run always loses and equal elements are won by the lower run so the merge is stable
+ */
+static bool sort_wins(const LoserTree *tree, int run, int other) {
+    int order;
+
+    if (tree->heads[run] == NULL) return false;
+    if (tree->heads[other] == NULL) return true;
+    order = tree->compare(tree->heads[run], tree->heads[other]);
+    return order < 0 || (order == 0 && run < other);
+}
+
+bool losertree_create(LoserTree *tree, void **runs, int k, const void *(*next)(void *run),
+                      int (*compare)(const void *key1, const void *key2)) {
+    int *winners;
+    int node;
+    int left, right;
+    int i;
+
+    if (k < 1 || (size_t) k > SIZE_MAX / (2 * sizeof(void *) + 2 * sizeof(int))) return false;
+
+    // Runs, heads and nodes share one block, the second half of the nodes holds the winners while building
+    if ((tree->runs = (void **) malloc((size_t) k * (2 * sizeof(void *) + 2 * sizeof(int)))) == NULL) return false;
+    tree->heads = (const void **) (tree->runs + k);
+    tree->losers = (int *) (tree->heads + k);
+    winners = tree->losers + k;
+    tree->k = k;
+    tree->next = next;
+    tree->compare = compare;
+    for (i = 0; i < k; i++) {
+        tree->runs[i] = runs[i];
+        tree->heads[i] = next(runs[i]);
+    }
+
+    // Leaf i is node k + i, internal node n plays the winners of nodes 2n and 2n + 1
+    for (node = k - 1; node >= 1; node--) {
+        left = 2 * node >= k ? 2 * node - k : winners[2 * node];
+        right = 2 * node + 1 >= k ? 2 * node + 1 - k : winners[2 * node + 1];
+        if (sort_wins(tree, right, left)) {
+            winners[node] = right;
+            tree->losers[node] = left;
+        } else {
+            winners[node] = left;
+            tree->losers[node] = right;
+        }
+    }
+    tree->losers[0] = k == 1 ? 0 : winners[1];
+    return true;
+}
+
+void losertree_destroy(LoserTree *tree) {
+    free(tree->runs);
+    tree->runs = NULL;
+    tree->heads = NULL;
+    tree->losers = NULL;
+    tree->k = 0;
+}
+
+void losertree_advance(LoserTree *tree) {
+    int winner = tree->losers[0];
+    int node;
+    int swap;
+
+    if (tree->heads[winner] == NULL) return;
+    tree->heads[winner] = tree->next(tree->runs[winner]);
+
+    // Only the matches on the path of the advanced run are replayed, one compare per level
+    for (node = (winner + tree->k) / 2; node >= 1; node /= 2) {
+        if (sort_wins(tree, tree->losers[node], winner)) {
+            swap = tree->losers[node];
+            tree->losers[node] = winner;
+            winner = swap;
+        }
+    }
+    tree->losers[0] = winner;
+}
+
+bool losertree_merge(LoserTree *tree, bool (*output)(const void *element, void *data), void *data) {
+    const void *element;
+
+    while ((element = losertree_peek(tree)) != NULL) {
+        if (!output(element, data)) return false;
+        losertree_advance(tree);
+    }
+    return true;
+}
+
+/**
+ * @brief Private method to pull the next element of a sorted view cursor
+ */
+static const void *sort_nextCursor(void *run) {
+    SortCursor *cursor = (SortCursor *) run;
+
+    if (cursor->position >= cursor->view->count) return NULL;
+    return arrayview_at(cursor->view, cursor->position++);
+}
+
+bool array_mergeRuns(const ArrayView *runs, int k, int (*compare)(const void *key1, const void *key2),
+                     bool (*output)(const void *element, void *data), void *data) {
+    SortCursor *cursors;
+    void **handles;
+    LoserTree tree;
+    bool result;
+    int i;
+
+    if (k < 1) return true;
+    if ((size_t) k > SIZE_MAX / (sizeof(SortCursor) + sizeof(void *))) return false;
+    if ((cursors = (SortCursor *) malloc((size_t) k * (sizeof(SortCursor) + sizeof(void *)))) == NULL) return false;
+    handles = (void **) (cursors + k);
+    for (i = 0; i < k; i++) {
+        cursors[i].view = &runs[i];
+        cursors[i].position = 0;
+        handles[i] = &cursors[i];
+    }
+    if (!losertree_create(&tree, handles, k, sort_nextCursor, compare)) {
+        free(cursors);
+        return false;
+    }
+    result = losertree_merge(&tree, output, data);
+    losertree_destroy(&tree);
+    free(cursors);
+    return result;
+}
+
+/**
+ * @brief Private method to compare two int32 elements, used by the heapsort fallback of the typed sort
+ */
+static int sort_compareInt32(const void *key1, const void *key2) {
+    SortInt32 a = *(const SortInt32 *) key1;
+    SortInt32 b = *(const SortInt32 *) key2;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Private method to compare two int64 elements, used by the heapsort fallback of the typed sort
+ */
+static int sort_compareInt64(const void *key1, const void *key2) {
+    int64_t a = *(const int64_t *) key1;
+    int64_t b = *(const int64_t *) key2;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Private scalar fallback of the int32 sorting networks, an insertion sort
+ */
+static void sort_insertionInt32(SortInt32 *values, int count) {
+    SortInt32 value;
+    int i, j;
+
+    for (i = 1; i < count; i++) {
+        value = values[i];
+        for (j = i; j > 0 && values[j - 1] > value; j--) values[j] = values[j - 1];
+        values[j] = value;
+    }
+}
+
+/**
+ * @brief Private scalar fallback of the int64 sorting networks, an insertion sort
+ */
+static void sort_insertionInt64(int64_t *values, int count) {
+    int64_t value;
+    int i, j;
+
+    for (i = 1; i < count; i++) {
+        value = values[i];
+        for (j = i; j > 0 && values[j - 1] > value; j--) values[j] = values[j - 1];
+        values[j] = value;
+    }
+}
+
+#if COLLECTIONS_SIMD_AVX2
+
+/**
+ * @brief Compare-exchange of the lanes of an int32 vector with the lanes of its partner permutation, the lanes set in
+ * the blend mask keep the maximum. Immediate operands require a macro for unoptimized builds
+ */
+#define SORT_EXCHANGE_INT32(vector, partner, mask) \
+    _mm256_blend_epi32(_mm256_min_epi32(vector, partner), _mm256_max_epi32(vector, partner), mask)
+
+/**
+ * @brief Compare-exchange of the lanes of an int64 vector with the lanes of its partner permutation, the lanes set in
+ * the blend mask keep the maximum, the mask has two bits per lane
+ */
+#define SORT_EXCHANGE_INT64(vector, partner, mask) \
+    _mm256_blend_epi32(sort_minInt64(vector, partner), sort_maxInt64(vector, partner), mask)
+
+/**
+ * @brief Private AVX2 method computing the lane minimums of two int64 vectors, AVX2 has no int64 minimum
+ */
+COLLECTIONS_TARGET_AVX2
+static inline __m256i sort_minInt64(__m256i a, __m256i b) {
+    return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+}
+
+/**
+ * @brief Private AVX2 method computing the lane maximums of two int64 vectors
+ */
+COLLECTIONS_TARGET_AVX2
+static inline __m256i sort_maxInt64(__m256i a, __m256i b) {
+    return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+}
+
+/**
+ * @brief Private AVX2 method sorting the 8 lanes of a bitonic int32 vector, lanes exchange at distance 4, 2 then 1
+ */
+COLLECTIONS_TARGET_AVX2
+static __m256i sort_cleanInt32(__m256i vector) {
+    __m256i partner;
+
+    partner = _mm256_permute2x128_si256(vector, vector, 1);
+    vector = SORT_EXCHANGE_INT32(vector, partner, 0xF0);
+    partner = _mm256_shuffle_epi32(vector, _MM_SHUFFLE(1, 0, 3, 2));
+    vector = SORT_EXCHANGE_INT32(vector, partner, 0xCC);
+    partner = _mm256_shuffle_epi32(vector, _MM_SHUFFLE(2, 3, 0, 1));
+    return SORT_EXCHANGE_INT32(vector, partner, 0xAA);
+}
+
+/**
+ * @brief Private AVX2 method sorting the 8 lanes of an int32 vector, the first stages build alternating bitonic runs
+ */
+COLLECTIONS_TARGET_AVX2
+static __m256i sort_vectorInt32(__m256i vector) {
+    __m256i partner;
+
+    partner = _mm256_shuffle_epi32(vector, _MM_SHUFFLE(2, 3, 0, 1));
+    vector = SORT_EXCHANGE_INT32(vector, partner, 0x66);
+    partner = _mm256_shuffle_epi32(vector, _MM_SHUFFLE(1, 0, 3, 2));
+    vector = SORT_EXCHANGE_INT32(vector, partner, 0x3C);
+    partner = _mm256_shuffle_epi32(vector, _MM_SHUFFLE(2, 3, 0, 1));
+    vector = SORT_EXCHANGE_INT32(vector, partner, 0x5A);
+    return sort_cleanInt32(vector);
+}
+
+/**
+ * @brief Private AVX2 method sorting the 4 lanes of a bitonic int64 vector, lanes exchange at distance 2 then 1
+ */
+COLLECTIONS_TARGET_AVX2
+static __m256i sort_cleanInt64(__m256i vector) {
+    __m256i partner;
+
+    partner = _mm256_permute4x64_epi64(vector, _MM_SHUFFLE(1, 0, 3, 2));
+    vector = SORT_EXCHANGE_INT64(vector, partner, 0xF0);
+    partner = _mm256_permute4x64_epi64(vector, _MM_SHUFFLE(2, 3, 0, 1));
+    return SORT_EXCHANGE_INT64(vector, partner, 0xCC);
+}
+
+/**
+ * @brief Private AVX2 method sorting the 4 lanes of an int64 vector
+ */
+COLLECTIONS_TARGET_AVX2
+static __m256i sort_vectorInt64(__m256i vector) {
+    __m256i partner;
+
+    partner = _mm256_permute4x64_epi64(vector, _MM_SHUFFLE(2, 3, 0, 1));
+    vector = SORT_EXCHANGE_INT64(vector, partner, 0x3C);
+    return sort_cleanInt64(vector);
+}
+
+/**
+ * @brief Private AVX2 method merging sorted int32 vectors into a single sorted sequence with bitonic merges
+ * @param vectors Sorted vectors, each one a run of 8 lanes
+ * @param count Number of vectors, a power of two up to SORT_NETWORK_MAX / 8
+ */
+COLLECTIONS_TARGET_AVX2
+static void sort_mergeInt32(__m256i *vectors, int count) {
+    const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    __m256i reversed[SORT_NETWORK_MAX / 16];
+    __m256i low;
+    int run, stride, i, j;
+
+    for (run = 1; run < count; run *= 2) {
+        for (i = 0; i < count; i += 2 * run) {
+            // The second run is reversed so both runs form a bitonic sequence, split into two bitonic halves
+            for (j = 0; j < run; j++) reversed[j] = _mm256_permutevar8x32_epi32(vectors[i + 2 * run - 1 - j], reverse);
+            for (j = 0; j < run; j++) {
+                vectors[i + run + j] = _mm256_max_epi32(vectors[i + j], reversed[j]);
+                vectors[i + j] = _mm256_min_epi32(vectors[i + j], reversed[j]);
+            }
+
+            // Each half is cleaned across its vectors, then inside them
+            for (stride = run / 2; stride > 0; stride /= 2) {
+                for (j = i; j < i + 2 * run; j++) {
+                    if ((j & stride) != 0) continue;
+                    low = vectors[j];
+                    vectors[j] = _mm256_min_epi32(low, vectors[j + stride]);
+                    vectors[j + stride] = _mm256_max_epi32(low, vectors[j + stride]);
+                }
+            }
+            for (j = i; j < i + 2 * run; j++) vectors[j] = sort_cleanInt32(vectors[j]);
+        }
+    }
+}
+
+/**
+ * @brief Private AVX2 method merging sorted int64 vectors into a single sorted sequence with bitonic merges
+ * @param vectors Sorted vectors, each one a run of 4 lanes
+ * @param count Number of vectors, a power of two up to SORT_NETWORK_MAX / 4
+ */
+COLLECTIONS_TARGET_AVX2
+static void sort_mergeInt64(__m256i *vectors, int count) {
+    __m256i reversed[SORT_NETWORK_MAX / 8];
+    __m256i low;
+    int run, stride, i, j;
+
+    for (run = 1; run < count; run *= 2) {
+        for (i = 0; i < count; i += 2 * run) {
+            for (j = 0; j < run; j++) {
+                reversed[j] = _mm256_permute4x64_epi64(vectors[i + 2 * run - 1 - j], _MM_SHUFFLE(0, 1, 2, 3));
+            }
+            for (j = 0; j < run; j++) {
+                vectors[i + run + j] = sort_maxInt64(vectors[i + j], reversed[j]);
+                vectors[i + j] = sort_minInt64(vectors[i + j], reversed[j]);
+            }
+            for (stride = run / 2; stride > 0; stride /= 2) {
+                for (j = i; j < i + 2 * run; j++) {
+                    if ((j & stride) != 0) continue;
+                    low = vectors[j];
+                    vectors[j] = sort_minInt64(low, vectors[j + stride]);
+                    vectors[j + stride] = sort_maxInt64(low, vectors[j + stride]);
+                }
+            }
+            for (j = i; j < i + 2 * run; j++) vectors[j] = sort_cleanInt64(vectors[j]);
+        }
+    }
+}
+
+/**
+ * @brief Private AVX2 sorting network of up to SORT_NETWORK_MAX int32, padded with the maximum to a power of two
+ * number of vectors
+ */
+COLLECTIONS_TARGET_AVX2
+static void sort_networkInt32Avx2(SortInt32 *values, int count) {
+    __m256i vectors[SORT_NETWORK_MAX / 8];
+    int32_t padded[SORT_NETWORK_MAX];
+    int used = 1;
+    int i;
+
+    while (used * 8 < count) used *= 2;
+    memcpy(padded, values, (size_t) count * sizeof(int32_t));
+    for (i = count; i < used * 8; i++) padded[i] = INT32_MAX;
+    for (i = 0; i < used; i++) vectors[i] = sort_vectorInt32(_mm256_loadu_si256((const __m256i *) &padded[i * 8]));
+    sort_mergeInt32(vectors, used);
+    for (i = 0; i < used; i++) _mm256_storeu_si256((__m256i *) &padded[i * 8], vectors[i]);
+    memcpy(values, padded, (size_t) count * sizeof(int32_t));
+}
+
+/**
+ * @brief Private AVX2 sorting network of up to SORT_NETWORK_MAX int64, padded with the maximum to a power of two
+ * number of vectors
+ */
+COLLECTIONS_TARGET_AVX2
+static void sort_networkInt64Avx2(int64_t *values, int count) {
+    __m256i vectors[SORT_NETWORK_MAX / 4];
+    int64_t padded[SORT_NETWORK_MAX];
+    int used = 1;
+    int i;
+
+    while (used * 4 < count) used *= 2;
+    memcpy(padded, values, (size_t) count * sizeof(int64_t));
+    for (i = count; i < used * 4; i++) padded[i] = INT64_MAX;
+    for (i = 0; i < used; i++) vectors[i] = sort_vectorInt64(_mm256_loadu_si256((const __m256i *) &padded[i * 4]));
+    sort_mergeInt64(vectors, used);
+    for (i = 0; i < used; i++) _mm256_storeu_si256((__m256i *) &padded[i * 4], vectors[i]);
+    memcpy(values, padded, (size_t) count * sizeof(int64_t));
+}
+
+#endif
 
-    int size = stop_index - start_index;
-    for (int i = 0; i < size; i++) {
-        // Allocate space for a void* element
-        if ((out_ptr[*out_size] = malloc(sizeof(void *))) == NULL) {
-            free(in_ptr);
+/**
+ * @brief Private method sorting up to SORT_NETWORK_MAX int32 with the best available kernel
+ */
+static void sort_networkInt32(SortInt32 *values, int count) {
+#if COLLECTIONS_SIMD_AVX2
+    if (count > 1 && simd_hasAvx2()) {
+        sort_networkInt32Avx2(values, count);
+        return;
+    }
+#endif
+    sort_insertionInt32(values, count);
+}
+
+/**
+ * @brief Private method sorting up to SORT_NETWORK_MAX int64 with the best available kernel
+ */
+static void sort_networkInt64(int64_t *values, int count) {
+#if COLLECTIONS_SIMD_AVX2
+    if (count > 1 && simd_hasAvx2()) {
+        sort_networkInt64Avx2(values, count);
+        return;
+    }
+#endif
+    sort_insertionInt64(values, count);
+}
+
+/**
+ * @brief Private introsort of int32, the median of three samples is the pivot of a Hoare partition and the ranges
+ * up to SORT_NETWORK_MAX elements are left to the sorting networks
+ * @param depth Number of partitions allowed before switching to heapsort
+ */
+static void sort_quickInt32(SortInt32 *values, int count, int depth) {
+    SortInt32 pivot, temp;
+    int i, j;
+
+    while (count > SORT_NETWORK_MAX) {
+        if (depth-- == 0) {
+            sort_heap((char *) values, (char *) (values + count), sizeof(int32_t), sort_compareInt32);
             return;
-        };
-        (*out_size)++;
-        out_ptr[*out_size - 1] = in_ptr + start_index + i;
+        }
+
+        // Sorted samples keep the pivot away from the range ends, both sides of the partition are never empty
+        i = count / 2;
+        if (values[i] < values[0]) sort_swap((char *) &values[i], (char *) values, sizeof(*values));
+        if (values[count - 1] < values[i]) sort_swap((char *) &values[i], (char *) &values[count - 1], sizeof(*values));
+        if (values[i] < values[0]) sort_swap((char *) &values[i], (char *) values, sizeof(*values));
+        pivot = values[i];
+
+        i = -1;
+        j = count;
+        for (;;) {
+            do i++; while (values[i] < pivot);
+            do j--; while (values[j] > pivot);
+            if (i >= j) break;
+            temp = values[i];
+            values[i] = values[j];
+            values[j] = temp;
+        }
+
+        // The smaller side is recursed on
+        if (j + 1 < count - j - 1) {
+            sort_quickInt32(values, j + 1, depth);
+            values += j + 1;
+            count -= j + 1;
+        } else {
+            sort_quickInt32(values + j + 1, count - j - 1, depth);
+            count = j + 1;
+        }
+    }
+    sort_networkInt32(values, count);
+}
+
+/**
+ * @brief Private introsort of int64, the twin of sort_quickInt32
+ * @param depth Number of partitions allowed before switching to heapsort
+ */
+static void sort_quickInt64(int64_t *values, int count, int depth) {
+    int64_t pivot, temp;
+    int i, j;
+
+    while (count > SORT_NETWORK_MAX) {
+        if (depth-- == 0) {
+            sort_heap((char *) values, (char *) (values + count), sizeof(int64_t), sort_compareInt64);
+            return;
+        }
+
+        i = count / 2;
+        if (values[i] < values[0]) sort_swap((char *) &values[i], (char *) values, sizeof(*values));
+        if (values[count - 1] < values[i]) sort_swap((char *) &values[i], (char *) &values[count - 1], sizeof(*values));
+        if (values[i] < values[0]) sort_swap((char *) &values[i], (char *) values, sizeof(*values));
+        pivot = values[i];
+
+        i = -1;
+        j = count;
+        for (;;) {
+            do i++; while (values[i] < pivot);
+            do j--; while (values[j] > pivot);
+            if (i >= j) break;
+            temp = values[i];
+            values[i] = values[j];
+            values[j] = temp;
+        }
+
+        if (j + 1 < count - j - 1) {
+            sort_quickInt64(values, j + 1, depth);
+            values += j + 1;
+            count -= j + 1;
+        } else {
+            sort_quickInt64(values + j + 1, count - j - 1, depth);
+            count = j + 1;
+        }
+    }
+    sort_networkInt64(values, count);
+}
+
+/**
+ * @brief Private method computing the depth limit of the typed introsorts, twice the logarithm of the count
+ */
+static int sort_depthLimit(int count) {
+    int depth = 0;
+
+    for (; count > 1; count >>= 1) depth += 2;
+    return depth;
+}
+
+void array_sortInt32(int32_t *values, int count) {
+    if (values == NULL || count < 2) return;
+    sort_quickInt32(values, count, sort_depthLimit(count));
+}
+
+void array_sortInt64(int64_t *values, int count) {
+    if (values == NULL || count < 2) return;
+    sort_quickInt64(values, count, sort_depthLimit(count));
+}
+
+void array_sortFloat(float *values, int count) {
+    SortInt32 *keys = (SortInt32 *) values;
+    int i;
+
+    if (values == NULL || count < 2) return;
+
+    // Negative floats get their magnitude bits flipped so the bits compare as int32 in float order, the
+    // transformation is its own inverse
+    for (i = 0; i < count; i++) keys[i] ^= (SortInt32) ((uint32_t) (keys[i] >> 31) >> 1);
+    sort_quickInt32(keys, count, sort_depthLimit(count));
+    for (i = 0; i < count; i++) keys[i] ^= (SortInt32) ((uint32_t) (keys[i] >> 31) >> 1);
+}
+
+/**
+ * @brief Private method to compare two elements of a stable sort, pointers are dereferenced for indirect sorts
+ */
+static int sort_compareStable(const StableSort *sort, const char *a, const char *b) {
+    if (sort->indirect) return sort->compare(*(void *const *) a, *(void *const *) b);
+    return sort->compare(a, b);
+}
+
+/**
+ * @brief Private method to count the elements of a sorted range going before a key, with an exponential search
+ * @param upper true to count the elements lower or equal to the key, false to count the lower ones only
+ * @param fromEnd true to start the search from the end of the range
+ * @return The number of elements going before the key
+ */
+static size_t sort_gallop(const StableSort *sort, const char *key, const char *base, size_t length, bool upper,
+                          bool fromEnd) {
+    size_t size = sort->size;
+    size_t low = 0;
+    size_t high = length;
+    size_t step = 1;
+    size_t middle;
+
+#define SORT_BEFORE(element) (upper ? sort_compareStable(sort, element, key) <= 0 : \
+                                      sort_compareStable(sort, element, key) < 0)
+    if (fromEnd) {
+        while (high >= step && !SORT_BEFORE(base + (high - step) * size)) {
+            high -= step;
+            step *= 2;
+        }
+        low = high >= step ? high - step + 1 : 0;
+    } else {
+        while (low + step <= length && SORT_BEFORE(base + (low + step - 1) * size)) {
+            low += step;
+            step *= 2;
+        }
+        high = low + step - 1 < length ? low + step - 1 : length;
+    }
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        if (SORT_BEFORE(base + middle * size))
+            low = middle + 1;
+        else
+            high = middle;
+    }
+#undef SORT_BEFORE
+    return low;
+}
+
+/**
+ * @brief Private method to extend a sorted prefix to a whole range by binary insertion, equal elements stay in order
+ */
+static void sort_binaryInsertion(const StableSort *sort, char *base, size_t length, size_t sorted) {
+    size_t size = sort->size;
+    char *element;
+    size_t position;
+
+    for (; sorted < length; sorted++) {
+        element = base + sorted * size;
+        position = sort_gallop(sort, element, base, sorted, true, true);
+        if (position == sorted) continue;
+        memcpy(sort->scratch, element, size);
+        memmove(base + (position + 1) * size, base + position * size, (sorted - position) * size);
+        memcpy(base + position * size, sort->scratch, size);
+    }
+}
+
+/**
+ * @brief Private method to find the run starting at an element, a strictly descending run is reversed
+ * @return The number of elements of the run
+ */
+static size_t sort_countRun(const StableSort *sort, char *base, size_t remaining) {
+    size_t size = sort->size;
+    size_t length = 2;
+    size_t i;
+
+    if (remaining == 1) return 1;
+    if (sort_compareStable(sort, base + size, base) < 0) {
+        while (length < remaining && sort_compareStable(sort, base + length * size, base + (length - 1) * size) < 0)
+            length++;
+        for (i = 0; i < length / 2; i++) sort_swap(base + i * size, base + (length - 1 - i) * size, size);
+    } else {
+        while (length < remaining && sort_compareStable(sort, base + length * size, base + (length - 1) * size) >= 0)
+            length++;
+    }
+    return length;
+}
+
+/**
+ * @brief Private method to merge two adjacent runs when the first one is the smallest, it is moved to the scratch
+ * buffer and the merge goes forward
+ */
+static void sort_mergeLow(StableSort *sort, char *base, size_t length1, size_t length2) {
+    size_t size = sort->size;
+    char *scratch = sort->scratch;
+    char *end = base + (length1 + length2) * size;
+    size_t remaining1 = length1;
+    size_t remaining2 = length2;
+    size_t wins1, wins2;
+
+    // The next element of the first run is scratch + (length1 - remaining1), the one of the second run is
+    // end - remaining2 and the next written element is end - remaining2 - remaining1
+#define SORT_FIRST (scratch + (length1 - remaining1) * size)
+#define SORT_SECOND (end - remaining2 * size)
+#define SORT_DEST (end - (remaining1 + remaining2) * size)
+    memcpy(scratch, base, length1 * size);
+    for (;;) {
+        wins1 = wins2 = 0;
+        do {
+            if (sort_compareStable(sort, SORT_SECOND, SORT_FIRST) < 0) {
+                sort_copy(SORT_DEST, SORT_SECOND, size);
+                remaining2--;
+                wins2++;
+                wins1 = 0;
+                if (remaining2 == 0) goto done;
+            } else {
+                sort_copy(SORT_DEST, SORT_FIRST, size);
+                remaining1--;
+                wins1++;
+                wins2 = 0;
+                if (remaining1 == 0) goto done;
+            }
+        } while (wins1 < sort->minGallop && wins2 < sort->minGallop);
+
+        // One run keeps winning, whole blocks are found by galloping
+        do {
+            wins1 = sort_gallop(sort, SORT_SECOND, SORT_FIRST, remaining1, true, false);
+            if (wins1 > 0) {
+                memcpy(SORT_DEST, SORT_FIRST, wins1 * size);
+                remaining1 -= wins1;
+                if (remaining1 == 0) goto done;
+            }
+            sort_copy(SORT_DEST, SORT_SECOND, size);
+            if (--remaining2 == 0) goto done;
+
+            wins2 = sort_gallop(sort, SORT_FIRST, SORT_SECOND, remaining2, false, false);
+            if (wins2 > 0) {
+                memmove(SORT_DEST, SORT_SECOND, wins2 * size);
+                remaining2 -= wins2;
+                if (remaining2 == 0) goto done;
+            }
+            sort_copy(SORT_DEST, SORT_FIRST, size);
+            if (--remaining1 == 0) goto done;
+            if (sort->minGallop > 1) sort->minGallop--;
+        } while (wins1 >= SORT_MIN_GALLOP || wins2 >= SORT_MIN_GALLOP);
+        sort->minGallop += 2;
+    }
+
+    done:
+    // The rest of the second run is already in place
+    if (remaining1 > 0) memcpy(SORT_DEST, SORT_FIRST, remaining1 * size);
+#undef SORT_FIRST
+#undef SORT_SECOND
+#undef SORT_DEST
+}
+
+/**
+ * @brief Private method to merge two adjacent runs when the second one is the smallest, it is moved to the scratch
+ * buffer and the merge goes backward
+ */
+static void sort_mergeHigh(StableSort *sort, char *base, size_t length1, size_t length2) {
+    size_t size = sort->size;
+    char *scratch = sort->scratch;
+    size_t remaining1 = length1;
+    size_t remaining2 = length2;
+    size_t wins1, wins2;
+
+    // The last elements of the runs are base + remaining1 - 1 and scratch + remaining2 - 1, the last element to
+    // write is base + remaining1 + remaining2 - 1
+#define SORT_FIRST (base + (remaining1 - 1) * size)
+#define SORT_SECOND (scratch + (remaining2 - 1) * size)
+#define SORT_DEST (base + (remaining1 + remaining2 - 1) * size)
+    memcpy(scratch, base + length1 * size, length2 * size);
+    for (;;) {
+        wins1 = wins2 = 0;
+        do {
+            if (sort_compareStable(sort, SORT_SECOND, SORT_FIRST) < 0) {
+                sort_copy(SORT_DEST, SORT_FIRST, size);
+                remaining1--;
+                wins1++;
+                wins2 = 0;
+                if (remaining1 == 0) goto done;
+            } else {
+                sort_copy(SORT_DEST, SORT_SECOND, size);
+                remaining2--;
+                wins2++;
+                wins1 = 0;
+                if (remaining2 == 0) goto done;
+            }
+        } while (wins1 < sort->minGallop && wins2 < sort->minGallop);
+
+        do {
+            wins1 = remaining1 - sort_gallop(sort, SORT_SECOND, base, remaining1, true, true);
+            if (wins1 > 0) {
+                remaining1 -= wins1;
+                memmove(base + (remaining1 + remaining2) * size, base + remaining1 * size, wins1 * size);
+                if (remaining1 == 0) goto done;
+            }
+            sort_copy(SORT_DEST, SORT_SECOND, size);
+            if (--remaining2 == 0) goto done;
+
+            wins2 = remaining2 - sort_gallop(sort, SORT_FIRST, scratch, remaining2, false, true);
+            if (wins2 > 0) {
+                remaining2 -= wins2;
+                memcpy(base + (remaining1 + remaining2) * size, scratch + remaining2 * size, wins2 * size);
+                if (remaining2 == 0) goto done;
+            }
+            sort_copy(SORT_DEST, SORT_FIRST, size);
+            if (--remaining1 == 0) goto done;
+            if (sort->minGallop > 1) sort->minGallop--;
+        } while (wins1 >= SORT_MIN_GALLOP || wins2 >= SORT_MIN_GALLOP);
+        sort->minGallop += 2;
+    }
+
+    done:
+    // The rest of the first run is already in place
+    if (remaining2 > 0) memcpy(base, scratch, remaining2 * size);
+#undef SORT_FIRST
+#undef SORT_SECOND
+#undef SORT_DEST
+}
+
+/**
+ * @brief Private method to merge the pending runs at the given index and the next one
+ */
+static void sort_mergeAt(StableSort *sort, int index) {
+    size_t size = sort->size;
+    char *base1 = sort->runs[index].base;
+    size_t length1 = sort->runs[index].length;
+    char *base2 = sort->runs[index + 1].base;
+    size_t length2 = sort->runs[index + 1].length;
+    size_t skipped;
+
+    sort->runs[index].length = length1 + length2;
+    if (index == sort->runCount - 3) sort->runs[index + 1] = sort->runs[index + 2];
+    sort->runCount--;
+
+    // The first elements of the first run and the last ones of the second run are already in place
+    skipped = sort_gallop(sort, base2, base1, length1, true, false);
+    base1 += skipped * size;
+    if ((length1 -= skipped) == 0) return;
+    if ((length2 = sort_gallop(sort, base1 + (length1 - 1) * size, base2, length2, false, true)) == 0) return;
+
+    if (length1 <= length2)
+        sort_mergeLow(sort, base1, length1, length2);
+    else
+        sort_mergeHigh(sort, base1, length1, length2);
+}
+
+/**
+ * @brief Private method to merge the pending runs until their lengths decrease faster than Fibonacci numbers
+ */
+static void sort_mergeCollapse(StableSort *sort) {
+    SortRun *runs = sort->runs;
+    int n;
+
+    while (sort->runCount > 1) {
+        n = sort->runCount - 2;
+        if ((n > 0 && runs[n - 1].length <= runs[n].length + runs[n + 1].length) ||
+            (n > 1 && runs[n - 2].length <= runs[n - 1].length + runs[n].length)) {
+            if (runs[n - 1].length < runs[n + 1].length) n--;
+        } else if (runs[n].length > runs[n + 1].length) {
+            break;
+        }
+        sort_mergeAt(sort, n);
+    }
+}
+
+/**
+ * @brief Private method to sort a range with runs detection and galloping merges
+ * @return true if the range was sorted, false if the scratch buffer allocation failed
+ */
+static bool sort_stable(char *base, size_t count, size_t size, int (*compare)(const void *key1, const void *key2),
+                        bool indirect, void *scratch) {
+    StableSort sort;
+    size_t minRun = count;
+    size_t remaining = count;
+    size_t extra = 0;
+    size_t length;
+    size_t forced;
+
+    if (count < 2) return true;
+    sort.size = size;
+    sort.compare = compare;
+    sort.indirect = indirect;
+    sort.minGallop = SORT_MIN_GALLOP;
+    sort.runCount = 0;
+    if ((sort.scratch = (char *) scratch) == NULL && (sort.scratch = (char *) malloc(count / 2 * size)) == NULL)
+        return false;
+
+    // Runs shorter than the minimal length are extended by insertion, count / minRun is close to a power of 2
+    while (minRun >= 64) {
+        extra |= minRun & 1;
+        minRun >>= 1;
+    }
+    minRun += extra;
+
+    while (remaining > 0) {
+        length = sort_countRun(&sort, base, remaining);
+        if (length < minRun) {
+            forced = remaining < minRun ? remaining : minRun;
+            sort_binaryInsertion(&sort, base, forced, length);
+            length = forced;
+        }
+        sort.runs[sort.runCount].base = base;
+        sort.runs[sort.runCount].length = length;
+        sort.runCount++;
+        sort_mergeCollapse(&sort);
+        base += length * size;
+        remaining -= length;
+    }
+
+    while (sort.runCount > 1) {
+        int n = sort.runCount - 2;
+        if (n > 0 && sort.runs[n - 1].length < sort.runs[n + 1].length) n--;
+        sort_mergeAt(&sort, n);
+    }
+    if (scratch == NULL) free(sort.scratch);
+    return true;
+}
+
+bool array_stableSort(void *base, int count, size_t size, int (*compare)(const void *key1, const void *key2),
+                      void *scratch) {
+    if ((base == NULL && count > 0) || count < 0 || size == 0) return false;
+    return sort_stable((char *) base, (size_t) count, size, compare, false, scratch);
+}
+
+bool array_stableSortValues(void **values, int count, int (*compare)(const void *key1, const void *key2),
+                            void **scratch) {
+    if ((values == NULL && count > 0) || count < 0) return false;
+    return sort_stable((char *) values, (size_t) count, sizeof(void *), compare, true, scratch);
+}
+
+/**
+ * @brief Private method to merge two sorted ranges, the largest one is split at its median whose rank in the other
+ * range is found by binary search, both halves are merged in parallel
+ */
+static void sort_parallelMerge(ParallelWorker *worker, void *data) {
+    SortMerge *merge = (SortMerge *) data;
+    SortMerge left = *merge;
+    SortMerge right = *merge;
+    ParallelTask task;
+    size_t size = merge->size;
+    const char *pivot;
+    size_t low, high, middle;
+    size_t i = 0, j = 0, k = 0;
+
+    if (merge->count1 + merge->count2 <= SORT_PARALLEL_GRAIN) {
+        while (i < merge->count1 && j < merge->count2) {
+            if (merge->compare(merge->second + j * size, merge->first + i * size) < 0)
+                sort_copy(merge->output + k++ * size, merge->second + j++ * size, size);
+            else
+                sort_copy(merge->output + k++ * size, merge->first + i++ * size, size);
+        }
+        memcpy(merge->output + k * size, merge->first + i * size, (merge->count1 - i) * size);
+        k += merge->count1 - i;
+        memcpy(merge->output + k * size, merge->second + j * size, (merge->count2 - j) * size);
+        return;
+    }
+    if (merge->count1 < merge->count2) {
+        left.first = right.first = merge->second;
+        left.count1 = merge->count2;
+        left.second = right.second = merge->first;
+        left.count2 = merge->count1;
+        sort_parallelMerge(worker, &left);
+        return;
+    }
+
+    pivot = merge->first + merge->count1 / 2 * size;
+    low = 0;
+    high = merge->count2;
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        if (merge->compare(merge->second + middle * size, pivot) < 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    left.count1 = merge->count1 / 2;
+    left.count2 = low;
+    sort_copy(merge->output + (left.count1 + low) * size, pivot, size);
+    right.first = pivot + size;
+    right.count1 = merge->count1 - left.count1 - 1;
+    right.second = merge->second + low * size;
+    right.count2 = merge->count2 - low;
+    right.output = merge->output + (left.count1 + low + 1) * size;
+
+    parallel_fork(worker, &task, sort_parallelMerge, &right);
+    sort_parallelMerge(worker, &left);
+    parallel_join(worker, &task);
+}
+
+/**
+ * @brief Private method to sort a range, its halves are sorted in parallel into the other buffer and merged back
+ */
+static void sort_parallelRange(ParallelWorker *worker, void *data) {
+    SortTask *sort = (SortTask *) data;
+    SortTask left = *sort;
+    SortTask right = *sort;
+    SortMerge merge;
+    ParallelTask task;
+    size_t half = sort->count / 2;
+
+    if (sort->count <= sort->grain) {
+        array_sort(sort->base, (int) sort->count, sort->size, sort->compare);
+        if (sort->toScratch) memcpy(sort->scratch, sort->base, sort->count * sort->size);
+        return;
+    }
+
+    left.count = half;
+    left.toScratch = right.toScratch = !sort->toScratch;
+    right.base += half * sort->size;
+    right.scratch += half * sort->size;
+    right.count -= half;
+    parallel_fork(worker, &task, sort_parallelRange, &right);
+    sort_parallelRange(worker, &left);
+    parallel_join(worker, &task);
+
+    merge.first = sort->toScratch ? sort->base : sort->scratch;
+    merge.count1 = half;
+    merge.second = merge.first + half * sort->size;
+    merge.count2 = sort->count - half;
+    merge.output = sort->toScratch ? sort->scratch : sort->base;
+    merge.size = sort->size;
+    merge.compare = sort->compare;
+    sort_parallelMerge(worker, &merge);
+}
+
+void array_parallelSort(ParallelPool *pool, void *base, int count, size_t size,
+                        int (*compare)(const void *key1, const void *key2)) {
+    SortTask sort;
+    size_t grain;
+
+    if (base == NULL || count < 2 || size == 0) return;
+    if (pool == NULL || parallel_threads(pool) < 2 || count < SORT_PARALLEL_THRESHOLD ||
+        (sort.scratch = (char *) malloc((size_t) count * size)) == NULL) {
+        array_sort(base, count, size, compare);
+        return;
+    }
+
+    // About eight leaves per thread, so the stealing balances the uneven leaves
+    grain = (size_t) count / (8 * (size_t) parallel_threads(pool));
+    sort.base = (char *) base;
+    sort.count = (size_t) count;
+    sort.size = size;
+    sort.grain = grain < SORT_PARALLEL_GRAIN ? SORT_PARALLEL_GRAIN : grain;
+    sort.toScratch = false;
+    sort.compare = compare;
+    parallel_run(pool, sort_parallelRange, &sort);
+    free(sort.scratch);
+}
+
+/**
+ * @brief Private method to read the key of an element of an integer radix sort
+ */
+static uint64_t sort_radixKey(const char *element, size_t size, uint64_t (*key)(const void *element)) {
+    uint32_t narrow;
+    uint64_t wide;
+
+    if (key != NULL) return key(element);
+    if (size == 4) {
+        memcpy(&narrow, element, 4);
+        return narrow;
+    }
+    memcpy(&wide, element, 8);
+    return wide;
+}
+
+/**
+ * @brief Private method to count the bytes of the given chunks, every pass is counted while reading an element once
+ */
+static void sort_radixCountChunks(int begin, int end, void *data) {
+    RadixCount *radix = (RadixCount *) data;
+    size_t per = (radix->count + radix->chunks - 1) / radix->chunks;
+    size_t first, last, i;
+    uint64_t key;
+    int chunk, pass;
+
+    for (chunk = begin; chunk < end; chunk++) {
+        RadixHistogram *histogram = &radix->histograms[chunk];
+        memset(histogram->counts, 0, (size_t) radix->passes * sizeof(histogram->counts[0]));
+        first = (size_t) chunk * per;
+        last = first + per < radix->count ? first + per : radix->count;
+        for (i = first; i < last; i++) {
+            if (radix->depth != SIZE_MAX) {
+                histogram->counts[0][(unsigned char) ((char *const *) radix->base)[i][radix->depth]]++;
+                continue;
+            }
+            key = sort_radixKey(radix->base + i * radix->size, radix->size, radix->key);
+            for (pass = 0; pass < radix->passes; pass++) histogram->counts[pass][(key >> (8 * pass)) & 0xFF]++;
+        }
+    }
+}
+
+/**
+ * @brief Private method to count the chunks of a radix histogram on the pool threads
+ */
+static void sort_radixCountParallel(ParallelWorker *worker, void *data) {
+    parallel_for(worker, 0, ((RadixCount *) data)->chunks, 1, sort_radixCountChunks, data);
+}
+
+/**
+ * @brief Private method to count the bytes of a radix sort, by chunks in parallel when a pool is given for a large
+ * input
+ * @return true if the bytes were counted in counts, false if the chunk histograms allocation failed
+ */
+static bool sort_radixCount(RadixCount *radix, ParallelPool *pool, RadixHistogram *counts) {
+    RadixHistogram *histograms;
+    int chunk, pass, digit;
+
+    radix->chunks = 1;
+    radix->histograms = counts;
+    if (pool == NULL || parallel_threads(pool) < 2 || radix->count < SORT_PARALLEL_THRESHOLD) {
+        sort_radixCountChunks(0, 1, radix);
+        return true;
+    }
+
+    radix->chunks = parallel_threads(pool);
+    if ((histograms = (RadixHistogram *) malloc(radix->chunks * sizeof(RadixHistogram))) == NULL) return false;
+    radix->histograms = histograms;
+    parallel_run(pool, sort_radixCountParallel, radix);
+    memset(counts->counts, 0, (size_t) radix->passes * sizeof(counts->counts[0]));
+    for (chunk = 0; chunk < radix->chunks; chunk++) {
+        for (pass = 0; pass < radix->passes; pass++) {
+            for (digit = 0; digit < SORT_RADIX_BUCKETS; digit++)
+                counts->counts[pass][digit] += histograms[chunk].counts[pass][digit];
+        }
+    }
+    free(histograms);
+    return true;
+}
+
+bool array_radixSort(void *base, int count, size_t size, uint64_t (*key)(const void *element), int keyBits,
+                     void *scratch, ParallelPool *pool) {
+    RadixHistogram counts;
+    RadixCount radix;
+    size_t offsets[SORT_RADIX_BUCKETS];
+    char *source = (char *) base;
+    char *target;
+    char *temp;
+    size_t total, i;
+    int pass, digit;
+    bool skip;
+
+    if (count < 0 || size == 0 || keyBits < 1 || keyBits > 64 || (key == NULL && size != 4 && size != 8))
+        return false;
+    if (count < 2) return true;
+    if ((target = (char *) scratch) == NULL && (target = (char *) malloc((size_t) count * size)) == NULL)
+        return false;
+
+    radix.base = source;
+    radix.count = (size_t) count;
+    radix.size = size;
+    radix.key = key;
+    radix.passes = (keyBits + 7) / 8;
+    radix.depth = SIZE_MAX;
+    if (!sort_radixCount(&radix, pool, &counts)) {
+        if (scratch == NULL) free(target);
+        return false;
+    }
+
+    for (pass = 0; pass < radix.passes; pass++) {
+        // A pass where every key has the same byte would only copy the elements
+        skip = false;
+        for (digit = 0, total = 0; digit < SORT_RADIX_BUCKETS; digit++) {
+            if (counts.counts[pass][digit] == (size_t) count) skip = true;
+            offsets[digit] = total;
+            total += counts.counts[pass][digit];
+        }
+        if (skip) continue;
+
+        // Elements are scattered in order, each pass keeps the order of the previous one
+        for (i = 0; i < (size_t) count; i++) {
+            digit = (int) ((sort_radixKey(source + i * size, size, key) >> (8 * pass)) & 0xFF);
+            sort_copy(target + offsets[digit]++ * size, source + i * size, size);
+        }
+        temp = source;
+        source = target;
+        target = temp;
+    }
+
+    if (source != (char *) base) memcpy(base, source, (size_t) count * size);
+    if (scratch == NULL) free(source != (char *) base ? source : target);
+    return true;
+}
+
+/**
+ * @brief Private method to sort by insertion strings sharing their first bytes
+ */
+static void sort_stringInsertion(char **strings, size_t count, size_t depth) {
+    char *value;
+    size_t i, j;
+
+    for (i = 1; i < count; i++) {
+        value = strings[i];
+        for (j = i; j > 0 && strcmp(strings[j - 1] + depth, value + depth) > 0; j--) strings[j] = strings[j - 1];
+        strings[j] = value;
+    }
+}
+
+bool array_stringSort(char **strings, int count, ParallelPool *pool) {
+    RadixHistogram counts;
+    RadixCount radix;
+    size_t next[SORT_RADIX_BUCKETS];
+    size_t ends[SORT_RADIX_BUCKETS];
+    RadixCount *stack;
+    RadixCount *frames;
+    RadixCount bucket;
+    size_t capacity = 64;
+    size_t size = 0;
+    size_t total;
+    char *value;
+    char *temp;
+    int digit, other;
+    bool sorted = true;
+
+    if (count < 0 || (strings == NULL && count > 0)) return false;
+    if (count < 2) return true;
+    if ((stack = (RadixCount *) malloc(capacity * sizeof(RadixCount))) == NULL) return false;
+
+    // Buckets of strings sharing their first depth bytes are kept on an explicit stack
+    stack[size].base = (const char *) strings;
+    stack[size].count = (size_t) count;
+    stack[size].depth = 0;
+    size++;
+    while (size > 0) {
+        bucket = stack[--size];
+        strings = (char **) bucket.base;
+        if (bucket.count < SORT_STRING_INSERTION) {
+            sort_stringInsertion(strings, bucket.count, bucket.depth);
+            continue;
+        }
+
+        radix = bucket;
+        radix.size = sizeof(char *);
+        radix.key = NULL;
+        radix.passes = 1;
+        // Only the first bucket is large enough to be counted in parallel
+        if (!sort_radixCount(&radix, bucket.count == (size_t) count ? pool : NULL, &counts)) {
+            sorted = false;
+            break;
+        }
+        for (digit = 0, total = 0; digit < SORT_RADIX_BUCKETS; digit++) {
+            next[digit] = total;
+            total += counts.counts[0][digit];
+            ends[digit] = total;
+        }
+
+        // American flag permutation, each string is swapped into the next free slot of its bucket
+        for (digit = 0; digit < SORT_RADIX_BUCKETS; digit++) {
+            while (next[digit] < ends[digit]) {
+                value = strings[next[digit]];
+                other = (unsigned char) value[bucket.depth];
+                while (other != digit) {
+                    temp = strings[next[other]];
+                    strings[next[other]++] = value;
+                    value = temp;
+                    other = (unsigned char) value[bucket.depth];
+                }
+                strings[next[digit]++] = value;
+            }
+        }
+
+        // The strings of the bucket 0 ended and are equal, the other buckets go one byte deeper
+        for (digit = SORT_RADIX_BUCKETS - 1; digit > 0; digit--) {
+            if (counts.counts[0][digit] < 2) continue;
+            if (size == capacity) {
+                if ((frames = (RadixCount *) realloc(stack, 2 * capacity * sizeof(RadixCount))) == NULL) {
+                    sorted = false;
+                    break;
+                }
+                stack = frames;
+                capacity *= 2;
+            }
+            stack[size].base = (const char *) (strings + ends[digit] - counts.counts[0][digit]);
+            stack[size].count = counts.counts[0][digit];
+            stack[size].depth = bucket.depth + 1;
+            size++;
+        }
+        if (!sorted) break;
     }
+    free(stack);
+    return sorted;
 }
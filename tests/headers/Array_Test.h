@@ -5,35 +5,138 @@
 #ifndef COLLECTIONS_COMMONS_ARRAY_TEST_H
 #define COLLECTIONS_COMMONS_ARRAY_TEST_H
 #include "gtest/gtest.h"
-#include "sort.h"
+#include "arrays_utils.h"
 
-typedef struct {
-    int x;
-    int y;
-} Block;
+class ArrayTest : public testing::Test {
+protected:
+    struct Point {
+        int x;
+        int y;
+    };
 
-typedef struct {
-    Block **block;
-} Chunk;
+    static bool int_equals(const void *value1, const void *value2) {
+        return *(const int *) value1 == *(const int *) value2;
+    }
+};
 
+TEST_F(ArrayTest, SplitTest) {
+    Point points[5] = {{1, 2}, {3, 4}, {5, 6}, {7, 8}, {9, 10}};
+    void **split_points = nullptr;
+    int size = 0;
 
-TEST(ArraySplitTest, SimpleStructTest) {
-    Block blocks[5] = {{1, 2}, {3, 4}, {5, 6}, {7, 8}, {9, 10}};
-    Chunk chunk;
+    ASSERT_EQ(array_length(points), 5u);
+    ASSERT_TRUE(array_split(&split_points, &size, points, sizeof(Point), 1, 4));
+    ASSERT_TRUE(array_split(&split_points, &size, points, sizeof(Point), 0, 1));
+    ASSERT_FALSE(array_split(&split_points, &size, points, sizeof(Point), 3, 2));
 
-    void **split_blocks = (void** )malloc(5 * sizeof(void*));
-    int size = 0;
+    // The addresses point inside the input array, only the pointer array is freed
+    ASSERT_EQ(size, 4);
+    ASSERT_EQ(split_points[0], &points[1]);
+    ASSERT_EQ(((Point *) split_points[1])->y, 6);
+    ASSERT_EQ(((Point *) split_points[2])->x, 7);
+    ASSERT_EQ(split_points[3], &points[0]);
+    free(split_points);
+}
+
+TEST_F(ArrayTest, ViewTest) {
+    Point points[10];
+    ArrayView view;
+    ArrayView slice;
+    ArrayView steps;
+    ArrayView parts[4];
+
+    for (int i = 0; i < 10; i++) points[i] = {i, 100 + i};
+
+    // View over the y fields of the points
+    arrayview_create(&view, &points[0].y, 10, sizeof(Point));
+    ASSERT_EQ(arrayview_count(&view), 10);
+    ASSERT_EQ(*(int *) arrayview_at(&view, 3), 103);
+
+    ASSERT_TRUE(arrayview_slice(&view, 2, 7, &slice));
+    ASSERT_FALSE(arrayview_slice(&view, 2, 11, &slice));
+    ASSERT_EQ(arrayview_count(&slice), 5);
+    ASSERT_EQ(*(int *) arrayview_at(&slice, 0), 102);
+    *(int *) arrayview_at(&slice, 4) = -1;
+    ASSERT_EQ(points[6].y, -1);
 
-    array_split(&split_blocks, &size, blocks, 1, 4);
+    ASSERT_TRUE(arrayview_step(&view, 3, &steps));
+    ASSERT_EQ(arrayview_count(&steps), 4);
+    ASSERT_EQ(*(int *) arrayview_at(&steps, 3), 109);
+    ASSERT_TRUE(arrayview_step(&view, -4, &steps));
+    ASSERT_EQ(arrayview_count(&steps), 3);
+    ASSERT_EQ(*(int *) arrayview_at(&steps, 0), 109);
+    ASSERT_EQ(*(int *) arrayview_at(&steps, 2), 101);
+    ASSERT_FALSE(arrayview_step(&view, 0, &steps));
+    ASSERT_TRUE(arrayview_step(&view, INT32_MIN, &steps));
+    ASSERT_EQ(arrayview_count(&steps), 1);
+    ASSERT_EQ(*(int *) arrayview_at(&steps, 0), 109);
 
-    ASSERT_EQ(size, 3);
-    ASSERT_EQ(((Block *)split_blocks[0])->x, 3);
-    ASSERT_EQ(((Block *)split_blocks[1])->y, 6);
-    ASSERT_EQ(((Block *)split_blocks[2])->x, 7);
+    // 10 elements in 4 parts of 3, 3, 2 and 2 elements
+    ASSERT_EQ(arrayview_split(&view, 4, parts), 4);
+    ASSERT_EQ(arrayview_count(&parts[0]), 3);
+    ASSERT_EQ(arrayview_count(&parts[3]), 2);
+    ASSERT_EQ(*(int *) arrayview_at(&parts[2], 0), -1);
+    ASSERT_EQ(*(int *) arrayview_at(&parts[3], 1), 109);
 
-    for (int i = 0; i < size; i++) {
-        free(split_blocks[i]);
+    // No part is empty
+    ArrayView singles[8];
+    ASSERT_EQ(arrayview_split(&slice, 8, singles), 5);
+    ASSERT_EQ(arrayview_count(&singles[4]), 1);
+}
+
+TEST_F(ArrayTest, ConversionsTest) {
+    int values[6] = {4, 8, 15, 16, 23, 8};
+    void *array[6];
+    LinkedList *list;
+    DLinkedList *dlist;
+    CLinkedList *clist;
+    Set *set;
+    int i;
+
+    for (i = 0; i < 6; i++) array[i] = &values[i];
+    list = array_toList(array, 6);
+    dlist = array_toDList(array, 6);
+    clist = array_toCList(array, 6);
+    set = array_toSet(array, 6, int_equals);
+    ASSERT_NE(list, nullptr);
+    ASSERT_NE(dlist, nullptr);
+    ASSERT_NE(clist, nullptr);
+    ASSERT_NE(set, nullptr);
+
+    ASSERT_EQ(list_size(list), 6);
+    ASSERT_EQ(dlist_size(dlist), 6);
+    ASSERT_EQ(clist_size(clist), 6);
+    ASSERT_EQ(set->size, 5);
+
+    LinkedElement *element = list_first(list);
+    DLinkedElement *delement = dlist_first(dlist);
+    CLinkedElement *celement = clist_first(clist);
+    for (i = 0; i < 6; i++) {
+        ASSERT_EQ(list_value(element), array[i]);
+        ASSERT_EQ(dlist_value(delement), array[i]);
+        ASSERT_EQ(clist_value(celement), array[i]);
+        element = list_next(element);
+        delement = dlist_next(delement);
+        celement = clist_next(celement);
     }
-    free(split_blocks);
+    ASSERT_EQ(celement, clist_first(clist));
+    ASSERT_EQ(list_value(list_last(list)), array[5]);
+
+    // The values belong to the array, the structures are destroyed without them
+    list_destroy(list);
+    dlist_destroy(dlist);
+    clist_destroy(clist);
+    set_destroy(set);
+    free(list);
+    free(dlist);
+    free(clist);
+    free(set);
+
+    list = array_toList(nullptr, 0);
+    ASSERT_NE(list, nullptr);
+    ASSERT_EQ(list_size(list), 0);
+    free(list);
+    ASSERT_EQ(array_toList(nullptr, 3), nullptr);
 }
+
 #endif //COLLECTIONS_COMMONS_ARRAY_TEST_H
@@ -0,0 +1,143 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#ifndef COLLECTIONS_COMMONS_BTREE_TEST_H
+#define COLLECTIONS_COMMONS_BTREE_TEST_H
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "btree.h"
+
+static bool btree_collect(int64_t key, void *value, void *data) {
+    ((std::vector<int64_t> *) data)->push_back(key);
+    return true;
+}
+
+/**
+ * @brief Check the B+-tree node occupancy and key bounds of a subtree, returns its height, -1 if a property is broken
+ */
+static int btree_checkNode(const BTreeNode *node, bool root, int64_t low, int64_t high) {
+    int height = -1;
+
+    if (node->count > BTREE_NODE_KEYS || (!root && node->count < BTREE_NODE_KEYS / 2)) return -1;
+    for (int i = 0; i < node->count; i++) {
+        if (node->keys[i] < low || node->keys[i] > high) return -1;
+        if (i > 0 && node->keys[i] <= node->keys[i - 1]) return -1;
+    }
+    if (node->leaf) return 1;
+
+    for (int i = 0; i <= node->count; i++) {
+        int64_t child_low = i == 0 ? low : node->keys[i - 1];
+        int64_t child_high = i == node->count ? high : node->keys[i] - 1;
+        int child = btree_checkNode(((const BTreeInner *) node)->children[i], false, child_low, child_high);
+        if (child < 0 || (height >= 0 && child != height)) return -1;
+        height = child;
+    }
+    return height + 1;
+}
+
+class BTreeTest : public testing::Test {
+protected:
+    BTree *tree;
+    std::vector<int64_t> keys;
+
+    void SetUp() override {
+        tree = (BTree *) malloc(sizeof(BTree));
+        btree_create(tree, nullptr);
+        keys.resize(100000);
+        for (int i = 0; i < 100000; i++) keys[i] = (int64_t) i * 3 - 150000;
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(7));
+    }
+
+    void TearDown() override {
+        btree_destroy(tree);
+        free(tree);
+    }
+
+    void checkTree() {
+        ASSERT_EQ(btree_checkNode(tree->root, true, INT64_MIN, INT64_MAX), tree->height);
+    }
+};
+
+TEST_F(BTreeTest, InsertTest) {
+    BTreeIterator iterator;
+    void *value;
+    int64_t expected = -150000;
+
+    for (int64_t &key: keys) ASSERT_TRUE(btree_insert(tree, key, &key));
+    ASSERT_FALSE(btree_insert(tree, keys[0], nullptr));
+    ASSERT_EQ(btree_size(tree), 100000);
+    checkTree();
+
+    for (int i = 0; i < 1000; i++) {
+        ASSERT_TRUE(btree_find(tree, keys[i], &value));
+        ASSERT_EQ(value, &keys[i]);
+        ASSERT_FALSE(btree_find(tree, keys[i] + 1, nullptr));
+    }
+
+    for (bool valid = btree_first(tree, &iterator); valid; valid = btree_next(&iterator)) {
+        ASSERT_EQ(btree_key(&iterator), expected);
+        ASSERT_EQ(*(int64_t *) btree_value(&iterator), expected);
+        expected += 3;
+    }
+    ASSERT_EQ(expected, 150000);
+}
+
+TEST_F(BTreeTest, RemoveTest) {
+    void *value;
+
+    for (int64_t &key: keys) btree_insert(tree, key, &key);
+    ASSERT_FALSE(btree_remove(tree, 1, &value));
+    for (int i = 0; i < 90000; i++) {
+        ASSERT_TRUE(btree_remove(tree, keys[i], &value));
+        ASSERT_EQ(value, &keys[i]);
+        if (i % 10000 == 0) checkTree();
+    }
+    ASSERT_EQ(btree_size(tree), 10000);
+    checkTree();
+    for (int i = 0; i < 90000; i += 7) ASSERT_FALSE(btree_find(tree, keys[i], nullptr));
+    for (int i = 90000; i < 100000; i++) ASSERT_TRUE(btree_find(tree, keys[i], nullptr));
+
+    for (int i = 90000; i < 100000; i++) ASSERT_TRUE(btree_remove(tree, keys[i], nullptr));
+    ASSERT_EQ(tree->root, nullptr);
+    ASSERT_EQ(tree->first, nullptr);
+    ASSERT_TRUE(btree_insert(tree, 42, nullptr));
+    ASSERT_EQ(btree_size(tree), 1);
+}
+
+TEST_F(BTreeTest, BulkLoadTest) {
+    std::vector<int64_t> sorted(keys), visited;
+    BTreeIterator iterator;
+
+    std::sort(sorted.begin(), sorted.end());
+    ASSERT_FALSE(btree_bulkLoad(tree, keys.data(), nullptr, (int) keys.size()));
+    ASSERT_TRUE(btree_bulkLoad(tree, sorted.data(), nullptr, (int) sorted.size()));
+    ASSERT_FALSE(btree_bulkLoad(tree, sorted.data(), nullptr, (int) sorted.size()));
+    ASSERT_EQ(btree_size(tree), 100000);
+    checkTree();
+
+    ASSERT_TRUE(btree_seek(tree, 1, &iterator));
+    ASSERT_EQ(btree_key(&iterator), 3);
+    ASSERT_FALSE(btree_seek(tree, 150000, &iterator));
+    ASSERT_TRUE(btree_range(tree, -10, 10, btree_collect, &visited));
+    ASSERT_EQ(visited, std::vector<int64_t>({-9, -6, -3, 0, 3, 6, 9}));
+
+    // A bulk loaded tree keeps accepting updates
+    for (int i = 0; i < 50000; i++) ASSERT_TRUE(btree_remove(tree, keys[i], nullptr));
+    for (int i = 0; i < 50000; i++) ASSERT_TRUE(btree_insert(tree, keys[i] + 1, nullptr));
+    ASSERT_EQ(btree_size(tree), 100000);
+    checkTree();
+
+    for (int count: {1, BTREE_NODE_KEYS, BTREE_NODE_KEYS + 1, BTREE_NODE_KEYS * (BTREE_NODE_KEYS + 1) + 1}) {
+        BTree small;
+        btree_create(&small, nullptr);
+        ASSERT_TRUE(btree_bulkLoad(&small, sorted.data(), nullptr, count));
+        ASSERT_EQ(btree_checkNode(small.root, true, INT64_MIN, INT64_MAX), small.height);
+        btree_destroy(&small);
+    }
+}
+
+#endif //COLLECTIONS_COMMONS_BTREE_TEST_H
@@ -0,0 +1,118 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#ifndef COLLECTIONS_COMMONS_BINARYSEARCHTREE_TEST_H
+#define COLLECTIONS_COMMONS_BINARYSEARCHTREE_TEST_H
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "bistree.h"
+
+static int bistree_compareInt(const void *key1, const void *key2) {
+    int left = *(const int *) key1;
+    int right = *(const int *) key2;
+    return (left > right) - (left < right);
+}
+
+/**
+ * @brief Check the AVL balance, heights and sizes of a subtree, returns its height, -1 if a property is broken
+ */
+static int bistree_check(BinaryTreeNode *node) {
+    int left, right;
+
+    if (node == nullptr) return 0;
+    left = bistree_check(node->left);
+    right = bistree_check(node->right);
+    if (left < 0 || right < 0 || abs(left - right) > 1) return -1;
+    if (bistree_avl(node)->height != std::max(left, right) + 1) return -1;
+    if (bistree_avl(node)->size != bitree_branchNodeCount(node)) return -1;
+    return std::max(left, right) + 1;
+}
+
+class BinarySearchTreeTest : public testing::Test {
+protected:
+    BinarySearchTree *tree;
+    std::vector<int> values;
+
+    void SetUp() override {
+        tree = (BinarySearchTree *) malloc(sizeof(BinarySearchTree));
+        bistree_create(tree, bistree_compareInt, nullptr);
+        values.resize(5000);
+        for (int i = 0; i < 5000; i++) values[i] = i * 10;
+        std::shuffle(values.begin(), values.end(), std::mt19937(3));
+    }
+
+    void TearDown() override {
+        bistree_destroy(tree);
+        free(tree);
+    }
+};
+
+TEST_F(BinarySearchTreeTest, InsertTest) {
+    void *value;
+    int missing = 15;
+
+    for (int &v: values) ASSERT_TRUE(bistree_insert(tree, &v));
+    ASSERT_FALSE(bistree_insert(tree, &values[0]));
+    ASSERT_EQ(bitree_size(tree), 5000);
+    ASSERT_GT(bistree_check(tree->root), 0);
+    ASSERT_LE(bitree_maxDepth(tree), 17);
+
+    value = &values[10];
+    ASSERT_TRUE(bistree_lookup(tree, &value));
+    ASSERT_EQ(value, &values[10]);
+    value = &missing;
+    ASSERT_FALSE(bistree_lookup(tree, &value));
+}
+
+TEST_F(BinarySearchTreeTest, OrderStatisticTest) {
+    void *value;
+    int key;
+
+    for (int &v: values) bistree_insert(tree, &v);
+    for (int rank = 0; rank < 5000; rank += 37) {
+        ASSERT_TRUE(bistree_select(tree, rank, &value));
+        ASSERT_EQ(*(int *) value, rank * 10);
+        key = rank * 10;
+        ASSERT_EQ(bistree_rank(tree, &key), rank);
+        key = rank * 10 + 5;
+        ASSERT_EQ(bistree_rank(tree, &key), rank + 1);
+    }
+    ASSERT_FALSE(bistree_select(tree, 5000, &value));
+    ASSERT_FALSE(bistree_select(tree, -1, &value));
+
+    // 90th percentile
+    ASSERT_TRUE(bistree_select(tree, 5000 * 9 / 10, &value));
+    ASSERT_EQ(*(int *) value, 45000);
+}
+
+TEST_F(BinarySearchTreeTest, RemoveTest) {
+    void *value;
+    int key;
+
+    for (int &v: values) bistree_insert(tree, &v);
+    for (int i = 0; i < 2500; i++) {
+        value = &values[i];
+        ASSERT_TRUE(bistree_remove(tree, &value));
+        ASSERT_EQ(value, &values[i]);
+        value = &values[i];
+        ASSERT_FALSE(bistree_remove(tree, &value));
+        if (i % 250 == 0) ASSERT_GT(bistree_check(tree->root), 0);
+    }
+    ASSERT_EQ(bitree_size(tree), 2500);
+    ASSERT_GT(bistree_check(tree->root), 0);
+
+    std::vector<int> remaining(values.begin() + 2500, values.end());
+    std::sort(remaining.begin(), remaining.end());
+    for (int rank = 0; rank < 2500; rank++) {
+        ASSERT_TRUE(bistree_select(tree, rank, &value));
+        ASSERT_EQ(*(int *) value, remaining[rank]);
+    }
+    key = remaining[1000];
+    ASSERT_EQ(bistree_rank(tree, &key), 1000);
+}
+
+#endif //COLLECTIONS_COMMONS_BINARYSEARCHTREE_TEST_H
@@ -0,0 +1,269 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#ifndef COLLECTIONS_COMMONS_BINARYTREE_TEST_H
+#define COLLECTIONS_COMMONS_BINARYTREE_TEST_H
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "bitree.h"
+
+static bool bitree_collect(void *value, void *data) {
+    ((std::vector<int> *) data)->push_back(*(int *) value);
+    return true;
+}
+
+static bool bitree_collectThree(void *value, void *data) {
+    auto *values = (std::vector<int> *) data;
+    values->push_back(*(int *) value);
+    return values->size() < 3;
+}
+
+static bool bitree_equalsInt(const void *value1, const void *value2) {
+    return *(const int *) value1 == *(const int *) value2;
+}
+
+static int bitree_destroyed = 0;
+
+static void bitree_countDestroy(void *value) {
+    bitree_destroyed++;
+}
+
+class BinaryTreeTest : public testing::Test {
+protected:
+    BinaryTree *tree;
+    int values[7] = {1, 2, 3, 4, 5, 6, 7};
+
+    void SetUp() override {
+        tree = (BinaryTree *) malloc(sizeof(BinaryTree));
+        bitree_create(tree, nullptr);
+        tree->equals = bitree_equalsInt;
+
+        //        1
+        //      2   3
+        //     4 5 6 7
+        bitree_addLeft(tree, nullptr, &values[0]);
+        bitree_addLeft(tree, tree->root, &values[1]);
+        bitree_addRight(tree, tree->root, &values[2]);
+        bitree_addLeft(tree, tree->root->left, &values[3]);
+        bitree_addRight(tree, tree->root->left, &values[4]);
+        bitree_addLeft(tree, tree->root->right, &values[5]);
+        bitree_addRight(tree, tree->root->right, &values[6]);
+    }
+
+    void TearDown() override {
+        bitree_destroy(tree);
+        free(tree);
+    }
+};
+
+TEST_F(BinaryTreeTest, TraversalTest) {
+    std::vector<int> visited;
+
+    ASSERT_TRUE(bitree_preorder(tree, bitree_collect, &visited));
+    ASSERT_EQ(visited, std::vector<int>({1, 2, 4, 5, 3, 6, 7}));
+    visited.clear();
+    ASSERT_TRUE(bitree_inorder(tree, bitree_collect, &visited));
+    ASSERT_EQ(visited, std::vector<int>({4, 2, 5, 1, 6, 3, 7}));
+    visited.clear();
+    ASSERT_TRUE(bitree_postorder(tree, bitree_collect, &visited));
+    ASSERT_EQ(visited, std::vector<int>({4, 5, 2, 6, 7, 3, 1}));
+
+    // Stopped traversals restore the tree links
+    visited.clear();
+    ASSERT_FALSE(bitree_postorder(tree, bitree_collectThree, &visited));
+    ASSERT_EQ(visited, std::vector<int>({4, 5, 2}));
+    visited.clear();
+    ASSERT_FALSE(bitree_inorder(tree, bitree_collectThree, &visited));
+    ASSERT_EQ(visited, std::vector<int>({4, 2, 5}));
+    ASSERT_EQ(bitree_nodeCount(tree), 7);
+    ASSERT_EQ(tree->root->left->right->right, nullptr);
+    ASSERT_EQ(tree->root->right->left->right, nullptr);
+}
+
+TEST_F(BinaryTreeTest, ShapeTest) {
+    int diameter = 0;
+
+    ASSERT_EQ(bitree_maxDepth(tree), 3);
+    ASSERT_EQ(bitree_nodeCount(tree), 7);
+    ASSERT_EQ(bitree_height(tree->root, &diameter), 3);
+    ASSERT_EQ(diameter, 4);
+    ASSERT_TRUE(bitree_isSameTree(bitree_equalsInt, tree->root, tree->root));
+    ASSERT_FALSE(bitree_isSameTree(bitree_equalsInt, tree->root, tree->root->left));
+    ASSERT_FALSE(bitree_isMirror(bitree_equalsInt, tree->root, tree->root));
+
+    bitree_invertBranch(tree->root);
+    ASSERT_EQ(*(int *) tree->root->left->value, 3);
+    ASSERT_EQ(*(int *) tree->root->right->left->value, 5);
+
+    bitree_removeLeft(tree, tree->root);
+    ASSERT_EQ(bitree_size(tree), 4);
+    ASSERT_EQ(bitree_nodeCount(tree), 4);
+}
+
+TEST_F(BinaryTreeTest, LevelOrderTest) {
+    void **values;
+    void **levels;
+    int *offsets;
+    int *column_sizes;
+    int count;
+
+    values = bitree_levelOrderFlat(tree, &count, &offsets);
+    ASSERT_NE(values, nullptr);
+    ASSERT_EQ(count, 3);
+    ASSERT_EQ(std::vector<int>(offsets, offsets + 4), std::vector<int>({0, 1, 3, 7}));
+    for (int i = 0; i < 7; i++) ASSERT_EQ(*(int *) values[i], i + 1);
+    free(values);
+
+    levels = bitree_levelOrder(tree, &count, &column_sizes);
+    ASSERT_NE(levels, nullptr);
+    ASSERT_EQ(count, 3);
+    ASSERT_EQ(std::vector<int>(column_sizes, column_sizes + 3), std::vector<int>({1, 2, 4}));
+    ASSERT_EQ(*(int *) ((void **) levels[1])[1], 3);
+    ASSERT_EQ(*(int *) ((void **) levels[2])[0], 4);
+    free(levels);
+
+    bitree_removeLeft(tree, tree->root);
+    values = bitree_levelOrderFlat(tree, &count, &offsets);
+    ASSERT_EQ(count, 3);
+    ASSERT_EQ(offsets[count], 4);
+    ASSERT_EQ(*(int *) values[3], 7);
+    free(values);
+
+    bitree_removeLeft(tree, nullptr);
+    ASSERT_EQ(bitree_levelOrderFlat(tree, &count, &offsets), nullptr);
+    ASSERT_EQ(count, 0);
+}
+
+TEST_F(BinaryTreeTest, BuildTest) {
+    BinaryTree *built;
+    BinaryTree other;
+    BinaryTree merged;
+    std::vector<int> visited;
+    int root = 0;
+    int leaf = 8;
+    void *preorder[7] = {&values[0], &values[1], &values[3], &values[4], &values[2], &values[5], &values[6]};
+    void *inorder[7] = {&values[3], &values[1], &values[4], &values[0], &values[5], &values[2], &values[6]};
+    void *postorder[7] = {&values[3], &values[4], &values[1], &values[5], &values[6], &values[2], &values[0]};
+
+    built = bitree_build_from_preorder_inorder(preorder, 7, inorder, 7, nullptr, bitree_equalsInt);
+    ASSERT_NE(built, nullptr);
+    ASSERT_EQ(bitree_size(built), 7);
+    ASSERT_TRUE(bitree_isSameTree(bitree_equalsInt, built->root, tree->root));
+    bitree_removeLeft(built, built->root);
+    ASSERT_EQ(bitree_size(built), 4);
+    bitree_destroy(built);
+    free(built);
+
+    built = bitree_build_from_inorder_postorder(inorder, 7, (int **) postorder, 7, nullptr, bitree_equalsInt);
+    ASSERT_NE(built, nullptr);
+    ASSERT_TRUE(bitree_isSameTree(bitree_equalsInt, built->root, tree->root));
+    ASSERT_TRUE(bitree_postorder(built, bitree_collect, &visited));
+    ASSERT_EQ(visited, std::vector<int>({4, 5, 2, 6, 7, 3, 1}));
+
+    // Built nodes and allocated nodes live together in a merged tree
+    bitree_create(&other, nullptr);
+    bitree_addLeft(&other, nullptr, &leaf);
+    ASSERT_TRUE(bitree_merge(&merged, built, &other, &root));
+    ASSERT_EQ(bitree_size(&merged), 9);
+    ASSERT_EQ(built->blocks, nullptr);
+    bitree_destroy(&merged);
+    free(built);
+
+    ASSERT_EQ(bitree_build_from_preorder_inorder(preorder, 7, inorder, 6, nullptr, bitree_equalsInt), nullptr);
+}
+
+TEST(BinaryTreeDegenerateTest, DeepTreeTest) {
+    BinaryTree tree;
+    BinaryTreeNode *node;
+    std::vector<int> visited;
+    int diameter = 0;
+    int value = 0;
+
+    // A 300000 nodes zig-zag chain overflows recursive traversals
+    bitree_create(&tree, nullptr);
+    bitree_addLeft(&tree, nullptr, &value);
+    node = tree.root;
+    for (int i = 1; i < 300000; i++) {
+        if (i % 2 == 0) {
+            bitree_addLeft(&tree, node, &value);
+            node = node->left;
+        } else {
+            bitree_addRight(&tree, node, &value);
+            node = node->right;
+        }
+    }
+
+    ASSERT_EQ(bitree_maxDepth(&tree), 300000);
+    ASSERT_EQ(bitree_nodeCount(&tree), 300000);
+    ASSERT_EQ(bitree_height(tree.root, &diameter), 300000);
+    ASSERT_EQ(diameter, 299999);
+    ASSERT_TRUE(bitree_isSameTree(bitree_equalsInt, tree.root, tree.root));
+    ASSERT_TRUE(bitree_inorder(&tree, bitree_collect, &visited));
+    ASSERT_EQ(visited.size(), 300000);
+    visited.clear();
+    ASSERT_TRUE(bitree_postorder(&tree, bitree_collect, &visited));
+    ASSERT_EQ(visited.size(), 300000);
+    ASSERT_NE(bitree_invertBranch(tree.root), nullptr);
+    ASSERT_EQ(bitree_maxDepth(&tree), 300000);
+
+    bitree_destroy(&tree);
+    ASSERT_EQ(bitree_size(&tree), 0);
+
+    // A right chain is rebuilt from its traversals without recursion
+    std::vector<int> keys(300000);
+    std::vector<void *> order(300000);
+    BinaryTree *built;
+    for (int i = 0; i < 300000; i++) {
+        keys[i] = i;
+        order[i] = &keys[i];
+    }
+    built = bitree_build_from_preorder_inorder(order.data(), 300000, order.data(), 300000, nullptr,
+                                               bitree_equalsInt);
+    ASSERT_NE(built, nullptr);
+    ASSERT_EQ(bitree_maxDepth(built), 300000);
+    ASSERT_EQ(*(int *) built->root->right->value, 1);
+    bitree_destroy(built);
+    free(built);
+}
+
+TEST(BinaryTreeDegenerateTest, MergedBuildsTest) {
+    const int trees = 64;
+    const int size = 1000;
+    std::vector<int> keys(size);
+    std::vector<void *> order(size);
+    BinaryTree *built;
+    BinaryTree merged;
+    BinaryTree result;
+    int root = -1;
+    int leaf = -2;
+
+    for (int i = 0; i < size; i++) {
+        keys[i] = i;
+        order[i] = &keys[i];
+    }
+
+    // Each merge chains the node blocks of another built tree under an allocated root
+    bitree_create(&merged, bitree_countDestroy);
+    bitree_addLeft(&merged, nullptr, &leaf);
+    for (int i = 0; i < trees; i++) {
+        built = bitree_build_from_preorder_inorder(order.data(), size, order.data(), size, bitree_countDestroy,
+                                                   bitree_equalsInt);
+        ASSERT_NE(built, nullptr);
+        ASSERT_TRUE(bitree_merge(&result, &merged, built, &root));
+        free(built);
+        merged = result;
+    }
+    ASSERT_EQ(bitree_size(&merged), trees * size + trees + 1);
+
+    // Removing a branch mixing allocated roots and built nodes releases only the allocated ones
+    bitree_destroyed = 0;
+    bitree_removeRight(&merged, merged.root);
+    ASSERT_EQ(bitree_destroyed, size);
+    ASSERT_TRUE(bitree_addRight(&merged, merged.root, &leaf));
+    bitree_destroy(&merged);
+    ASSERT_EQ(bitree_destroyed, trees * size + trees + 2);
+}
+
+#endif //COLLECTIONS_COMMONS_BINARYTREE_TEST_H
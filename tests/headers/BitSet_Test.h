@@ -0,0 +1,145 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#ifndef COLLECTIONS_COMMONS_BITSET_TEST_H
+#define COLLECTIONS_COMMONS_BITSET_TEST_H
+
+#include "gtest/gtest.h"
+#include "bitset.h"
+#include "frame.h"
+#include "hash_utils.h"
+
+class BitSetTest : public testing::Test {
+protected:
+    BitSet *set;
+
+    void SetUp() override {
+        set = (BitSet *) malloc(sizeof(BitSet));
+        bitset_create(set, 100);
+    }
+
+    void TearDown() override {
+        bitset_destroy(set);
+        free(set);
+    }
+};
+
+TEST_F(BitSetTest, BasicTest) {
+    ASSERT_EQ(bitset_capacity(set), 256);
+    ASSERT_TRUE(bitset_set(set, 3));
+    ASSERT_TRUE(bitset_set(set, 64));
+    ASSERT_TRUE(bitset_set(set, 1000));
+    ASSERT_FALSE(bitset_set(set, -1));
+    ASSERT_GE(bitset_capacity(set), 1001);
+
+    ASSERT_TRUE(bitset_test(set, 64));
+    ASSERT_FALSE(bitset_test(set, 65));
+    ASSERT_FALSE(bitset_test(set, 5000));
+    ASSERT_EQ(bitset_count(set), 3);
+
+    ASSERT_EQ(bitset_nextSet(set, 0), 3);
+    ASSERT_EQ(bitset_nextSet(set, 4), 64);
+    ASSERT_EQ(bitset_nextSet(set, 65), 1000);
+    ASSERT_EQ(bitset_nextSet(set, 1001), -1);
+
+    ASSERT_TRUE(bitset_clear(set, 64));
+    ASSERT_FALSE(bitset_clear(set, 64));
+    ASSERT_EQ(bitset_count(set), 2);
+}
+
+TEST_F(BitSetTest, LimitTest) {
+    // Integers close to INT_MAX grow the bit set to its largest capacity without overflowing
+    ASSERT_TRUE(bitset_set(set, 200));
+    ASSERT_TRUE(bitset_set(set, INT_MAX - 100));
+    ASSERT_EQ(bitset_capacity(set), BITSET_MAX_CAPACITY);
+    ASSERT_TRUE(bitset_test(set, INT_MAX - 100));
+    ASSERT_TRUE(bitset_set(set, BITSET_MAX_CAPACITY - 1));
+    ASSERT_FALSE(bitset_set(set, BITSET_MAX_CAPACITY));
+    ASSERT_FALSE(bitset_test(set, INT_MAX));
+    ASSERT_EQ(bitset_count(set), 3);
+    ASSERT_EQ(bitset_nextSet(set, 201), INT_MAX - 100);
+    ASSERT_EQ(bitset_nextSet(set, INT_MAX - 99), BITSET_MAX_CAPACITY - 1);
+
+    BitSet intersection;
+    ASSERT_TRUE(bitset_intersection(&intersection, set, set));
+    ASSERT_EQ(bitset_capacity(&intersection), BITSET_MAX_CAPACITY);
+    ASSERT_EQ(bitset_count(&intersection), 3);
+    bitset_destroy(&intersection);
+}
+
+TEST_F(BitSetTest, AlgebraTest) {
+    BitSet right, union_result, intersection_result, difference_result;
+
+    // left = multiples of 2 under 2000, right = multiples of 3 under 3000
+    bitset_create(&right, 0);
+    for (int i = 0; i < 2000; i += 2) bitset_set(set, i);
+    for (int i = 0; i < 3000; i += 3) bitset_set(&right, i);
+
+    ASSERT_TRUE(bitset_union(&union_result, set, &right));
+    ASSERT_EQ(bitset_count(&union_result), 1000 + 1000 - 334);
+    ASSERT_TRUE(bitset_intersection(&intersection_result, set, &right));
+    ASSERT_EQ(bitset_count(&intersection_result), 334);
+    ASSERT_TRUE(bitset_difference(&difference_result, set, &right));
+    ASSERT_EQ(bitset_count(&difference_result), 1000 - 334);
+    ASSERT_TRUE(bitset_test(&difference_result, 1996));
+    ASSERT_FALSE(bitset_test(&difference_result, 1998));
+
+    ASSERT_TRUE(bitset_isSubset(&intersection_result, set));
+    ASSERT_TRUE(bitset_isSubset(&intersection_result, &right));
+    ASSERT_FALSE(bitset_isSubset(set, &right));
+    ASSERT_TRUE(bitset_isSubset(&right, &union_result));
+    ASSERT_FALSE(bitset_equals(set, &right));
+
+    // Equality ignores the capacities
+    bitset_set(&intersection_result, 5000);
+    bitset_clear(&intersection_result, 5000);
+    bitset_destroy(&union_result);
+    ASSERT_TRUE(bitset_union(&union_result, &intersection_result, &difference_result));
+    ASSERT_TRUE(bitset_equals(&union_result, set));
+
+    bitset_destroy(&right);
+    bitset_destroy(&union_result);
+    bitset_destroy(&intersection_result);
+    bitset_destroy(&difference_result);
+}
+
+TEST_F(BitSetTest, ConvertTest) {
+    int raw_values[] = {7, 300, 42, 7};
+    Set ids;
+    HashSet hashed_ids;
+    BitSet from_set, from_hashset;
+
+    set_create(&ids, cmp_int, nullptr);
+    hashset_create(&hashed_ids, 16, hashint, cmp_int, free);
+    for (int i = 0; i < 4; i++) {
+        int *value = (int *) malloc(sizeof(int));
+        *value = raw_values[i];
+        set_add(&ids, &raw_values[i]);
+        if (!hashset_add(&hashed_ids, value)) free(value);
+    }
+
+    ASSERT_TRUE(bitset_fromSet(&from_set, &ids));
+    ASSERT_TRUE(bitset_fromHashSet(&from_hashset, &hashed_ids));
+    ASSERT_EQ(bitset_count(&from_set), 3);
+    ASSERT_TRUE(bitset_test(&from_set, 300));
+    ASSERT_TRUE(bitset_equals(&from_set, &from_hashset));
+
+    bitset_destroy(&from_set);
+    bitset_destroy(&from_hashset);
+    hashset_destroy(&hashed_ids);
+    set_destroy(&ids);
+}
+
+TEST_F(BitSetTest, FrameTest) {
+    for (int i = 10; i < 20; i++) bitset_set(set, i);
+
+    ASSERT_EQ(frame_allocBitSet(set), 10);
+    ASSERT_EQ(frame_allocBitSet(set), 11);
+    ASSERT_TRUE(frame_destroyBitSet(set, 10));
+    ASSERT_EQ(frame_allocBitSet(set), 10);
+    for (int i = 12; i < 20; i++) ASSERT_EQ(frame_allocBitSet(set), i);
+    ASSERT_EQ(frame_allocBitSet(set), -1);
+}
+
+#endif //COLLECTIONS_COMMONS_BITSET_TEST_H
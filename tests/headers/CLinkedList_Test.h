@@ -20,6 +20,7 @@ protected:
 
     static void destroy(void *value);
     int replace_page(CLinkedElement **current);
+    static int compare_page(const void *key1, const void *key2);
 
     void SetUp() override {
 // Code exécuté avant chaque test
@@ -71,4 +72,27 @@ TEST_F(CLinkedList_Test, PerformanceTest) {
     EXPECT_EQ(clist_size(obj), 0);
 }
 
+TEST_F(CLinkedList_Test, SortTest) {
+    CLinkedElement *element = nullptr;
+    unsigned int seed = 5;
+
+    // Pages are numbered randomly, the reference keeps their insertion order
+    for (int i = 0; i < 50000; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        clist_add(obj, element, new Page{(int) ((seed >> 8) % 500), i});
+        element = element == nullptr ? clist_first(obj) : clist_next(element);
+    }
+
+    clist_sort(obj, compare_page);
+    ASSERT_EQ(clist_size(obj), 50000);
+    element = clist_first(obj);
+    for (int i = 1; i < 50000; ++i, element = clist_next(element)) {
+        Page *current = (Page *) clist_value(element);
+        Page *next = (Page *) clist_value(clist_next(element));
+        ASSERT_TRUE(current->numero < next->numero ||
+                    (current->numero == next->numero && current->reference < next->reference));
+    }
+    ASSERT_EQ(clist_next(element), clist_first(obj));
+}
+
 #endif //COLLECTIONS_COMMONS_CLINKEDLIST_TEST_H
@@ -19,6 +19,11 @@ protected:
     void TearDown() override {
         dlist_destroy(&list);
     }
+
+    // Values are pairs of a key and an insertion order, only the key is compared
+    static int compare_key(const void *key1, const void *key2) {
+        return *(const int *) key1 - *(const int *) key2;
+    }
 };
 
 TEST_F(DLinkedListTest, PerformanceTest) {
@@ -57,4 +62,36 @@ TEST_F(DLinkedListTest, PerformanceTest) {
 
     EXPECT_EQ(dlist_size(&list), 0);
 }
+
+TEST_F(DLinkedListTest, SortTest) {
+    DLinkedElement *element;
+    unsigned int seed = 11;
+    int count = 0;
+    int *value;
+
+    for (int i = 0; i < 100000; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        value = (int *) malloc(2 * sizeof(int));
+        value[0] = (int) ((seed >> 8) % 1000);
+        value[1] = i;
+        if (dlist_size(&list) == 0) dlist_add(&list, nullptr, value);
+        else dlist_add(&list, dlist_last(&list), value);
+    }
+
+    dlist_sort(&list, compare_key);
+    ASSERT_EQ(dlist_size(&list), 100000);
+    ASSERT_EQ(dlist_previous(dlist_first(&list)), nullptr);
+    for (element = dlist_first(&list); dlist_next(element) != nullptr; element = dlist_next(element)) {
+        int *current = (int *) dlist_value(element);
+        int *next = (int *) dlist_value(dlist_next(element));
+        ASSERT_TRUE(current[0] < next[0] || (current[0] == next[0] && current[1] < next[1]));
+        ASSERT_EQ(dlist_previous(dlist_next(element)), element);
+    }
+    ASSERT_EQ(dlist_last(&list), element);
+
+    // The backward walk sees every element
+    for (element = dlist_last(&list); element != nullptr; element = dlist_previous(element)) count++;
+    ASSERT_EQ(count, 100000);
+}
+
 #endif //COLLECTIONS_COMMONS_DLINKEDLIST_TEST_H
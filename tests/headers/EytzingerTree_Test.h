@@ -0,0 +1,94 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#ifndef COLLECTIONS_COMMONS_EYTZINGERTREE_TEST_H
+#define COLLECTIONS_COMMONS_EYTZINGERTREE_TEST_H
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "eytree.h"
+
+static int64_t eytree_keyOf(const void *value) {
+    return *(const int64_t *) value;
+}
+
+static int eytree_compareKey(const void *key1, const void *key2) {
+    int64_t value1 = *(const int64_t *) key1;
+    int64_t value2 = *(const int64_t *) key2;
+    return (value1 > value2) - (value1 < value2);
+}
+
+TEST(EytzingerTreeTest, LowerBoundTest) {
+    std::mt19937 random(42);
+
+    for (int size = 0; size < 130; size++) {
+        std::vector<int64_t> keys(size);
+        EytzingerTree tree;
+
+        for (int i = 0; i < size; i++) keys[i] = (int64_t) (random() % 64);
+        std::sort(keys.begin(), keys.end());
+        ASSERT_TRUE(eytree_create(&tree, keys.data(), nullptr, size, nullptr));
+        ASSERT_EQ(eytree_size(&tree), size);
+
+        for (int64_t key = -1; key <= 65; key++) {
+            auto expected = std::lower_bound(keys.begin(), keys.end(), key);
+            int index = eytree_lowerBound(&tree, key);
+
+            if (expected == keys.end()) {
+                ASSERT_EQ(index, 0);
+                ASSERT_FALSE(eytree_find(&tree, key, nullptr));
+            } else {
+                ASSERT_NE(index, 0);
+                ASSERT_EQ(eytree_key(&tree, index), *expected);
+                ASSERT_EQ(eytree_find(&tree, key, nullptr), *expected == key);
+            }
+        }
+        eytree_destroy(&tree);
+    }
+}
+
+TEST(EytzingerTreeTest, CreateFromArrayTest) {
+    EytzingerTree tree;
+    int64_t keys[5] = {1, 3, 5, 7, 9};
+    void *values[5] = {&keys[0], &keys[1], &keys[2], &keys[3], &keys[4]};
+    void *value = nullptr;
+
+    // Same layout as a *_toArray output
+    ASSERT_TRUE(eytree_createFromArray(&tree, values, 5, eytree_keyOf, nullptr));
+    ASSERT_TRUE(eytree_find(&tree, 7, &value));
+    ASSERT_EQ(value, &keys[3]);
+    ASSERT_FALSE(eytree_find(&tree, 4, &value));
+    ASSERT_EQ(eytree_key(&tree, 1), 7);
+    eytree_destroy(&tree);
+
+    std::swap(values[0], values[1]);
+    ASSERT_FALSE(eytree_createFromArray(&tree, values, 5, eytree_keyOf, nullptr));
+    ASSERT_FALSE(eytree_create(&tree, keys, nullptr, -1, nullptr));
+    std::swap(keys[0], keys[1]);
+    ASSERT_FALSE(eytree_create(&tree, keys, nullptr, 5, nullptr));
+}
+
+TEST(EytzingerTreeTest, BsearchTest) {
+    const int size = 1 << 14;
+    const int searches = 1 << 15;
+    std::vector<int64_t> keys(size);
+    std::mt19937 random(7);
+    EytzingerTree tree;
+    long found_tree = 0;
+    long found_bsearch = 0;
+
+    for (int i = 0; i < size; i++) keys[i] = 2 * (int64_t) i;
+    ASSERT_TRUE(eytree_create(&tree, keys.data(), nullptr, size, nullptr));
+    for (int i = 0; i < searches; i++) {
+        int64_t query = (int64_t) (random() % (2 * size));
+        found_tree += eytree_find(&tree, query, nullptr);
+        found_bsearch += bsearch(&query, keys.data(), size, sizeof(int64_t), eytree_compareKey) != nullptr;
+    }
+    ASSERT_EQ(found_tree, found_bsearch);
+    eytree_destroy(&tree);
+}
+
+#endif //COLLECTIONS_COMMONS_EYTZINGERTREE_TEST_H
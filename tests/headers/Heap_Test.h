@@ -0,0 +1,185 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#ifndef COLLECTIONS_COMMONS_HEAP_TEST_H
+#define COLLECTIONS_COMMONS_HEAP_TEST_H
+
+#include <algorithm>
+#include <vector>
+#include "gtest/gtest.h"
+#include "heap.h"
+
+class HeapTest : public testing::Test {
+protected:
+    static int compare_int(const void *key1, const void *key2) {
+        int a = *(const int *) key1;
+        int b = *(const int *) key2;
+        return (a > b) - (a < b);
+    }
+
+    static int *new_value(int value) {
+        int *result = (int *) malloc(sizeof(int));
+        *result = value;
+        return result;
+    }
+
+    static std::vector<int> random_values(int size, unsigned int seed) {
+        std::vector<int> values(size);
+        for (int &value: values) {
+            seed = seed * 1103515245u + 12345u;
+            value = (int) ((seed >> 8) % 100000);
+        }
+        return values;
+    }
+};
+
+TEST_F(HeapTest, PushPopTest) {
+    std::vector<int> values = random_values(10000, 3);
+    std::vector<int> sorted = values;
+    void *value;
+
+    std::sort(sorted.begin(), sorted.end());
+    for (int arity: {2, 4, 8}) {
+        Heap heap;
+        heap_create(&heap, arity, compare_int, free);
+        ASSERT_EQ(heap_peek(&heap), nullptr);
+        ASSERT_FALSE(heap_pop(&heap, &value));
+        for (int v: values) ASSERT_GE(heap_push(&heap, new_value(v)), 0);
+        ASSERT_EQ(heap_size(&heap), 10000);
+        ASSERT_EQ(*(int *) heap_peek(&heap), sorted[0]);
+
+        for (int i = 0; i < 5000; i++) {
+            ASSERT_TRUE(heap_pop(&heap, &value));
+            ASSERT_EQ(*(int *) value, sorted[i]);
+            free(value);
+        }
+        // Remaining values are destroyed with the heap
+        heap_destroy(&heap);
+    }
+}
+
+TEST_F(HeapTest, HandleTest) {
+    std::vector<int> values = random_values(2000, 11);
+    std::vector<int> handles;
+    std::vector<int> expected;
+    Heap heap;
+    void *value;
+    int previous;
+
+    heap_create(&heap, 0, compare_int, nullptr);
+    ASSERT_EQ(heap.arity, HEAP_DEFAULT_ARITY);
+    for (int &v: values) handles.push_back(heap_push(&heap, &v));
+
+    // Decrease every third key, increase every fifth one and remove every seventh value
+    for (int i = 0; i < 2000; i++) {
+        if (i % 3 == 0) values[i] -= 50000;
+        else if (i % 5 == 0) values[i] += 50000;
+        if (i % 3 == 0 || i % 5 == 0) ASSERT_TRUE(heap_update(&heap, handles[i], &values[i]));
+        if (i % 7 == 0) {
+            ASSERT_TRUE(heap_remove(&heap, handles[i], &value));
+            ASSERT_EQ(value, &values[i]);
+            ASSERT_FALSE(heap_remove(&heap, handles[i], &value));
+        } else {
+            expected.push_back(values[i]);
+        }
+    }
+    ASSERT_EQ(*(int *) heap_value(&heap, handles[1]), values[1]);
+    ASSERT_FALSE(heap_update(&heap, -1, nullptr));
+
+    // Freed handles are reused by the next pushes
+    int extra = -100000;
+    ASSERT_LT(heap_push(&heap, &extra), 2000);
+    expected.push_back(extra);
+
+    std::sort(expected.begin(), expected.end());
+    previous = INT32_MIN;
+    for (int v: expected) {
+        ASSERT_TRUE(heap_pop(&heap, &value));
+        ASSERT_EQ(*(int *) value, v);
+        ASSERT_GE(*(int *) value, previous);
+        previous = *(int *) value;
+    }
+    ASSERT_EQ(heap_size(&heap), 0);
+    heap_destroy(&heap);
+}
+
+TEST_F(HeapTest, HeapifyTest) {
+    std::vector<int> values = random_values(5000, 5);
+    std::vector<void *> pointers;
+    std::vector<int> sorted = values;
+    Heap heap;
+    void *value;
+    int previous;
+
+    for (int &v: values) pointers.push_back(&v);
+    std::sort(sorted.begin(), sorted.end());
+    heap_create(&heap, 3, compare_int, nullptr);
+    ASSERT_TRUE(heap_heapify(&heap, pointers.data(), (int) pointers.size()));
+    ASSERT_FALSE(heap_heapify(&heap, pointers.data(), (int) pointers.size()));
+    ASSERT_EQ(heap_value(&heap, 42), &values[42]);
+
+    values[42] = -1;
+    ASSERT_TRUE(heap_update(&heap, 42, &values[42]));
+    ASSERT_EQ(heap_peek(&heap), &values[42]);
+    ASSERT_TRUE(heap_pop(&heap, &value));
+    previous = -1;
+    for (int i = 1; i < 5000; i++) {
+        ASSERT_TRUE(heap_pop(&heap, &value));
+        ASSERT_GE(*(int *) value, previous);
+        previous = *(int *) value;
+    }
+    ASSERT_EQ(previous, sorted.back());
+    heap_destroy(&heap);
+}
+
+TEST_F(HeapTest, PairingHeapTest) {
+    std::vector<int> values = random_values(10000, 17);
+    std::vector<PairingHeapNode *> nodes;
+    std::vector<int> expected;
+    PairingHeap heap;
+    PairingHeap other;
+    int larger = 1000000;
+    void *value;
+
+    pheap_create(&heap, compare_int, free);
+    pheap_create(&other, compare_int, free);
+    ASSERT_EQ(pheap_peek(&heap), nullptr);
+    ASSERT_FALSE(pheap_pop(&heap, &value));
+    for (int i = 0; i < 10000; i++) {
+        nodes.push_back(pheap_push(i % 2 == 0 ? &heap : &other, new_value(values[i])));
+        ASSERT_NE(nodes.back(), nullptr);
+    }
+
+    // Handles stay valid after the merge
+    pheap_merge(&heap, &other);
+    ASSERT_EQ(pheap_size(&heap), 10000);
+    ASSERT_EQ(pheap_size(&other), 0);
+
+    for (int i = 0; i < 10000; i++) {
+        if (i % 4 == 0) {
+            ASSERT_FALSE(pheap_decreaseKey(&heap, nodes[i], &larger));
+            *(int *) nodes[i]->value -= 100000;
+            ASSERT_TRUE(pheap_decreaseKey(&heap, nodes[i], nodes[i]->value));
+        }
+        if (i % 9 == 0) {
+            pheap_remove(&heap, nodes[i], &value);
+            free(value);
+        } else {
+            expected.push_back(*(int *) nodes[i]->value);
+        }
+    }
+
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(pheap_size(&heap), (int) expected.size());
+    for (int i = 0; i < (int) expected.size() / 2; i++) {
+        ASSERT_TRUE(pheap_pop(&heap, &value));
+        ASSERT_EQ(*(int *) value, expected[i]);
+        free(value);
+    }
+    // Remaining values are destroyed with the heap
+    pheap_destroy(&heap);
+    pheap_destroy(&other);
+}
+
+#endif //COLLECTIONS_COMMONS_HEAP_TEST_H
@@ -0,0 +1,126 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#ifndef COLLECTIONS_COMMONS_INDEXEDBINARYTREE_TEST_H
+#define COLLECTIONS_COMMONS_INDEXEDBINARYTREE_TEST_H
+
+#include "gtest/gtest.h"
+#include "ibitree.h"
+
+class IndexedBinaryTreeTest : public testing::Test {
+protected:
+    IndexedBinaryTree tree{};
+
+    void SetUp() override {
+        ibitree_create(&tree, free);
+
+        //        1
+        //      2   3
+        //     4 5
+        ibitree_addLeft(&tree, IBITREE_NULL, new_value(1));
+        ibitree_addLeft(&tree, ibitree_root(&tree), new_value(2));
+        ibitree_addRight(&tree, ibitree_root(&tree), new_value(3));
+        ibitree_addLeft(&tree, ibitree_left(&tree, ibitree_root(&tree)), new_value(4));
+        ibitree_addRight(&tree, ibitree_left(&tree, ibitree_root(&tree)), new_value(5));
+    }
+
+    void TearDown() override {
+        ibitree_destroy(&tree);
+    }
+
+    static int *new_value(int value) {
+        int *result = (int *) malloc(sizeof(int));
+        *result = value;
+        return result;
+    }
+
+    static int value_of(IndexedBinaryTree *tree, uint32_t node) {
+        return *(int *) ibitree_value(tree, node);
+    }
+};
+
+TEST_F(IndexedBinaryTreeTest, AddRemoveTest) {
+    uint32_t left;
+
+    ASSERT_EQ(sizeof(IndexedBinaryTreeNode), 2 * sizeof(void *));
+    ASSERT_EQ(ibitree_size(&tree), 5);
+    left = ibitree_left(&tree, ibitree_root(&tree));
+    ASSERT_EQ(value_of(&tree, left), 2);
+    ASSERT_EQ(value_of(&tree, ibitree_right(&tree, left)), 5);
+    ASSERT_TRUE(ibitree_isNodeLeaf(&tree, ibitree_right(&tree, ibitree_root(&tree))));
+    ASSERT_FALSE(ibitree_addLeft(&tree, IBITREE_NULL, nullptr));
+    ASSERT_FALSE(ibitree_addLeft(&tree, left, nullptr));
+
+    // Removed slots are reused by the next insertions
+    ibitree_removeLeft(&tree, ibitree_root(&tree));
+    ASSERT_EQ(ibitree_size(&tree), 2);
+    ASSERT_EQ(ibitree_left(&tree, ibitree_root(&tree)), IBITREE_NULL);
+    ASSERT_TRUE(ibitree_addLeft(&tree, ibitree_root(&tree), new_value(6)));
+    ASSERT_LT(ibitree_left(&tree, ibitree_root(&tree)), tree.count);
+    ASSERT_EQ(tree.count, 6u);
+    ASSERT_EQ(value_of(&tree, ibitree_left(&tree, ibitree_root(&tree))), 6);
+
+    ibitree_removeRight(&tree, IBITREE_NULL);
+    ASSERT_EQ(ibitree_size(&tree), 0);
+    ASSERT_EQ(ibitree_root(&tree), IBITREE_NULL);
+}
+
+TEST_F(IndexedBinaryTreeTest, MergeTest) {
+    IndexedBinaryTree right;
+    IndexedBinaryTree merged;
+    uint32_t node;
+
+    ibitree_create(&right, free);
+    ibitree_addLeft(&right, IBITREE_NULL, new_value(7));
+    ibitree_addRight(&right, ibitree_root(&right), new_value(8));
+    ibitree_removeRight(&tree, ibitree_root(&tree));
+
+    ASSERT_TRUE(ibitree_merge(&merged, &tree, &right, new_value(0)));
+    ASSERT_EQ(ibitree_size(&merged), 7);
+    ASSERT_EQ(ibitree_size(&tree), 0);
+    ASSERT_EQ(ibitree_size(&right), 0);
+    ASSERT_EQ(value_of(&merged, ibitree_root(&merged)), 0);
+    node = ibitree_left(&merged, ibitree_root(&merged));
+    ASSERT_EQ(value_of(&merged, node), 1);
+    ASSERT_EQ(value_of(&merged, ibitree_right(&merged, ibitree_left(&merged, node))), 5);
+    node = ibitree_right(&merged, ibitree_root(&merged));
+    ASSERT_EQ(value_of(&merged, ibitree_right(&merged, node)), 8);
+
+    // The free slot of the left tree is reused
+    ASSERT_TRUE(ibitree_addRight(&merged, ibitree_left(&merged, ibitree_root(&merged)), new_value(9)));
+    ASSERT_EQ(merged.count, 9u);
+    ibitree_destroy(&merged);
+    ibitree_destroy(&right);
+}
+
+TEST(IndexedBinaryTreeConversionTest, FromBitreeTest) {
+    BinaryTree source;
+    IndexedBinaryTree tree;
+    int values[4] = {1, 2, 3, 4};
+    uint32_t node;
+
+    bitree_create(&source, nullptr);
+    bitree_addLeft(&source, nullptr, &values[0]);
+    bitree_addRight(&source, source.root, &values[1]);
+    bitree_addLeft(&source, source.root->right, &values[2]);
+    bitree_addRight(&source, source.root->right->left, &values[3]);
+
+    ibitree_create(&tree, nullptr);
+    ASSERT_TRUE(ibitree_fromBitree(&tree, &source));
+    ASSERT_EQ(ibitree_size(&tree), 4);
+    ASSERT_EQ(tree.count, 5u);
+
+    // Nodes are stored in level order
+    for (uint32_t i = 1; i <= 4; i++) ASSERT_EQ(*(int *) ibitree_value(&tree, i), (int) i);
+    node = ibitree_right(&tree, ibitree_root(&tree));
+    node = ibitree_right(&tree, ibitree_left(&tree, node));
+    ASSERT_EQ(*(int *) ibitree_value(&tree, node), 4);
+    ASSERT_EQ(ibitree_left(&tree, ibitree_root(&tree)), IBITREE_NULL);
+    ASSERT_FALSE(ibitree_fromBitree(&tree, &source));
+
+    ibitree_destroy(&tree);
+    bitree_destroy(&source);
+}
+
+#endif //COLLECTIONS_COMMONS_INDEXEDBINARYTREE_TEST_H
@@ -19,6 +19,11 @@ protected:
     void TearDown() override {
         list_destroy(&list);
     }
+
+    // Values are pairs of a key and an insertion order, only the key is compared
+    static int compare_key(const void *key1, const void *key2) {
+        return *(const int *) key1 - *(const int *) key2;
+    }
 };
 
 TEST_F(LinkedListTest, PerformanceTest) {
@@ -42,4 +47,34 @@ TEST_F(LinkedListTest, PerformanceTest) {
     EXPECT_EQ(list_size(&list), 0);
 }
 
+TEST_F(LinkedListTest, SortTest) {
+    LinkedElement *element;
+    LinkedElement *first;
+    unsigned int seed = 7;
+    int *value;
+
+    list_sort(&list, compare_key);
+    ASSERT_EQ(list_first(&list), nullptr);
+    for (int i = 0; i < 100000; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        value = (int *) malloc(2 * sizeof(int));
+        value[0] = (int) ((seed >> 8) % 1000);
+        value[1] = i;
+        list_add(&list, list_last(&list), value);
+    }
+    first = list_first(&list);
+
+    list_sort(&list, compare_key);
+    ASSERT_EQ(list_size(&list), 100000);
+    for (element = list_first(&list); list_next(element) != nullptr; element = list_next(element)) {
+        int *current = (int *) list_value(element);
+        int *next = (int *) list_value(list_next(element));
+        ASSERT_TRUE(current[0] < next[0] || (current[0] == next[0] && current[1] < next[1]));
+    }
+    ASSERT_EQ(list_last(&list), element);
+
+    // The elements are relinked, not reallocated
+    for (element = list_first(&list); element != first; element = list_next(element)) ASSERT_NE(element, nullptr);
+}
+
 #endif //COLLECTIONS_COMMONS_LINKEDLIST_TEST_H
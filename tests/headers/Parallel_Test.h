@@ -0,0 +1,146 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#ifndef COLLECTIONS_COMMONS_PARALLEL_TEST_H
+#define COLLECTIONS_COMMONS_PARALLEL_TEST_H
+
+#include "gtest/gtest.h"
+#include "parallel_utils.h"
+#include "bitree.h"
+
+class ParallelTest : public testing::Test {
+protected:
+    ParallelPool pool{};
+
+    void SetUp() override {
+        ASSERT_TRUE(parallel_create(&pool, 4));
+    }
+
+    void TearDown() override {
+        parallel_destroy(&pool);
+    }
+
+    static bool int_equals(const void *value1, const void *value2) {
+        return *(const int *) value1 == *(const int *) value2;
+    }
+
+    // Random descents driven by the seed, the mirrored tree takes the opposite turns
+    static void build_random(BinaryTree *tree, int size, unsigned int seed, bool mirrored) {
+        BinaryTreeNode *node;
+        bool left;
+        int i;
+
+        bitree_create(tree, free);
+        bitree_addLeft(tree, nullptr, new_value(0));
+        for (i = 1; i < size; i++) {
+            node = tree->root;
+            for (;;) {
+                seed = seed * 1103515245u + 12345u;
+                left = ((seed >> 16) & 1) != mirrored;
+                if ((left ? node->left : node->right) == nullptr) break;
+                node = left ? node->left : node->right;
+            }
+            if (left)
+                bitree_addLeft(tree, node, new_value(i));
+            else
+                bitree_addRight(tree, node, new_value(i));
+        }
+    }
+
+    static int *new_value(int value) {
+        int *result = (int *) malloc(sizeof(int));
+        *result = value;
+        return result;
+    }
+
+    struct Sum {
+        const int *values;
+        long long partials[64];
+    };
+
+    static void sum_range(int begin, int end, void *data) {
+        Sum *sum = (Sum *) data;
+        long long total = 0;
+
+        for (int i = begin; i < end; i++) total += sum->values[i];
+        // Chunks of 1024 indexes never share a partial
+        __atomic_fetch_add(&sum->partials[begin / 1024 % 64], total, __ATOMIC_RELAXED);
+    }
+
+    static void run_sum(ParallelWorker *worker, void *data) {
+        parallel_for(worker, 0, 1 << 20, 1024, sum_range, data);
+    }
+};
+
+TEST_F(ParallelTest, ForTest) {
+    static int values[1 << 20];
+    Sum sum{};
+    long long expected = 0;
+    long long total = 0;
+
+    ASSERT_EQ(parallel_threads(&pool), 4);
+    for (int i = 0; i < (1 << 20); i++) expected += values[i] = i % 1000;
+    sum.values = values;
+    parallel_run(&pool, run_sum, &sum);
+    for (long long partial: sum.partials) total += partial;
+    ASSERT_EQ(total, expected);
+}
+
+TEST_F(ParallelTest, TreeWalksTest) {
+    BinaryTree tree;
+    BinaryTree same;
+    BinaryTree mirror;
+    void **values;
+    int *offsets;
+    int levels;
+
+    build_random(&tree, 200000, 7, false);
+    build_random(&same, 200000, 7, false);
+    build_random(&mirror, 200000, 7, true);
+
+    ASSERT_EQ(bitree_parallelNodeCount(&pool, &tree), 200000);
+    ASSERT_EQ(bitree_parallelMaxDepth(&pool, &tree), bitree_maxDepth(&tree));
+    ASSERT_EQ(bitree_parallelDiameter(&pool, &tree), bitree_diameter(&tree));
+    ASSERT_TRUE(bitree_parallelIsSameTree(&pool, int_equals, tree.root, same.root));
+    ASSERT_FALSE(bitree_parallelIsSameTree(&pool, int_equals, tree.root, mirror.root));
+    ASSERT_TRUE(bitree_parallelIsMirror(&pool, int_equals, tree.root, mirror.root));
+    ASSERT_FALSE(bitree_parallelIsMirror(&pool, int_equals, tree.root, same.root));
+
+    // A difference in the last level is found below the forked levels
+    values = bitree_levelOrderFlat(&same, &levels, &offsets);
+    ASSERT_NE(values, nullptr);
+    *(int *) values[199999] = -1;
+    free(values);
+    ASSERT_FALSE(bitree_parallelIsSameTree(&pool, int_equals, tree.root, same.root));
+
+    bitree_destroy(&tree);
+    bitree_destroy(&same);
+    bitree_destroy(&mirror);
+}
+
+TEST_F(ParallelTest, DegenerateTreeTest) {
+    BinaryTree tree;
+    BinaryTreeNode *node = nullptr;
+    ParallelPool single{};
+
+    bitree_create(&tree, free);
+    ASSERT_EQ(bitree_parallelNodeCount(&pool, &tree), 0);
+    ASSERT_EQ(bitree_parallelDiameter(&pool, &tree), 0);
+    ASSERT_TRUE(bitree_parallelIsSameTree(&pool, int_equals, nullptr, nullptr));
+    for (int i = 0; i < 300000; i++) {
+        bitree_addLeft(&tree, node, new_value(i));
+        node = node == nullptr ? tree.root : node->left;
+    }
+    ASSERT_EQ(bitree_parallelNodeCount(&pool, &tree), 300000);
+    ASSERT_EQ(bitree_parallelMaxDepth(&pool, &tree), 300000);
+    ASSERT_EQ(bitree_parallelDiameter(&pool, &tree), 299999);
+
+    // A single thread pool walks the whole tree sequentially
+    ASSERT_TRUE(parallel_create(&single, 1));
+    ASSERT_EQ(bitree_parallelMaxDepth(&single, &tree), 300000);
+    parallel_destroy(&single);
+    bitree_destroy(&tree);
+}
+
+#endif //COLLECTIONS_COMMONS_PARALLEL_TEST_H
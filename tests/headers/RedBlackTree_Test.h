@@ -0,0 +1,153 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#ifndef COLLECTIONS_COMMONS_REDBLACKTREE_TEST_H
+#define COLLECTIONS_COMMONS_REDBLACKTREE_TEST_H
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "rbtree.h"
+
+static int rbtree_compareInt(const void *key1, const void *key2) {
+    int left = *(const int *) key1;
+    int right = *(const int *) key2;
+    return (left > right) - (left < right);
+}
+
+static bool rbtree_collect(const void *key, void *value, void *data) {
+    ((std::vector<int> *) data)->push_back(*(const int *) key);
+    return true;
+}
+
+/**
+ * @brief Check the Red-Black properties of a subtree and returns its black height, -1 if a property is broken
+ */
+static int rbtree_blackHeight(const RedBlackNode *node) {
+    int left, right;
+
+    if (node == nullptr) return 1;
+    if (node->left != nullptr && node->left->parent != node) return -1;
+    if (node->right != nullptr && node->right->parent != node) return -1;
+    if (node->color == RBTREE_RED &&
+        ((node->left != nullptr && node->left->color == RBTREE_RED) ||
+         (node->right != nullptr && node->right->color == RBTREE_RED)))
+        return -1;
+    left = rbtree_blackHeight(node->left);
+    right = rbtree_blackHeight(node->right);
+    if (left < 0 || left != right) return -1;
+    return left + (node->color == RBTREE_BLACK ? 1 : 0);
+}
+
+class RedBlackTreeTest : public testing::Test {
+protected:
+    RedBlackTree *tree;
+    std::vector<int> keys;
+
+    void SetUp() override {
+        tree = (RedBlackTree *) malloc(sizeof(RedBlackTree));
+        rbtree_create(tree, rbtree_compareInt, nullptr, nullptr);
+        keys.resize(10000);
+        for (int i = 0; i < 10000; i++) keys[i] = i * 2;
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+    }
+
+    void TearDown() override {
+        rbtree_destroy(tree);
+        free(tree);
+    }
+};
+
+TEST_F(RedBlackTreeTest, InsertTest) {
+    for (int &key: keys) ASSERT_TRUE(rbtree_insert(tree, &key, &key));
+    ASSERT_FALSE(rbtree_insert(tree, &keys[0], nullptr));
+    ASSERT_EQ(rbtree_size(tree), 10000);
+    ASSERT_EQ(tree->root->parent, nullptr);
+    ASSERT_EQ(tree->root->color, RBTREE_BLACK);
+    ASSERT_GT(rbtree_blackHeight(tree->root), 0);
+
+    int expected = 0;
+    for (RedBlackNode *node = rbtree_first(tree); node != nullptr; node = rbtree_next(node)) {
+        ASSERT_EQ(*(int *) rbtree_key(node), expected);
+        ASSERT_EQ(rbtree_value(node), rbtree_key(node));
+        expected += 2;
+    }
+    expected = 19998;
+    for (RedBlackNode *node = rbtree_last(tree); node != nullptr; node = rbtree_previous(node)) {
+        ASSERT_EQ(*(int *) rbtree_key(node), expected);
+        expected -= 2;
+    }
+}
+
+TEST_F(RedBlackTreeTest, BoundTest) {
+    std::vector<int> visited;
+    int key = 51, high = 61, missing = 20000;
+
+    for (int &value: keys) rbtree_insert(tree, &value, nullptr);
+    ASSERT_EQ(rbtree_find(tree, &key), nullptr);
+    key = 50;
+    ASSERT_EQ(*(int *) rbtree_key(rbtree_find(tree, &key)), 50);
+    ASSERT_EQ(*(int *) rbtree_key(rbtree_lowerBound(tree, &key)), 50);
+    ASSERT_EQ(*(int *) rbtree_key(rbtree_upperBound(tree, &key)), 52);
+    key = 51;
+    ASSERT_EQ(*(int *) rbtree_key(rbtree_lowerBound(tree, &key)), 52);
+    ASSERT_EQ(rbtree_lowerBound(tree, &missing), nullptr);
+
+    ASSERT_TRUE(rbtree_range(tree, &key, &high, rbtree_collect, &visited));
+    ASSERT_EQ(visited, std::vector<int>({52, 54, 56, 58, 60}));
+    visited.clear();
+    ASSERT_TRUE(rbtree_range(tree, nullptr, nullptr, rbtree_collect, &visited));
+    ASSERT_EQ(visited.size(), 10000);
+}
+
+TEST_F(RedBlackTreeTest, RemoveTest) {
+    void *stored_key, *value;
+    int missing = 1;
+
+    for (int &key: keys) rbtree_insert(tree, &key, &key);
+    ASSERT_FALSE(rbtree_remove(tree, &missing, &stored_key, &value));
+
+    // Remove half of the keys in random order, then the remaining ones through an iterator
+    for (int i = 0; i < 5000; i++) {
+        ASSERT_TRUE(rbtree_remove(tree, &keys[i], &stored_key, &value));
+        ASSERT_EQ(stored_key, &keys[i]);
+        ASSERT_EQ(value, &keys[i]);
+        if (i % 500 == 0) ASSERT_GT(rbtree_blackHeight(tree->root), 0);
+    }
+    ASSERT_EQ(rbtree_size(tree), 5000);
+    ASSERT_GT(rbtree_blackHeight(tree->root), 0);
+    for (int i = 0; i < 5000; i++) ASSERT_EQ(rbtree_find(tree, &keys[i]), nullptr);
+    for (int i = 5000; i < 10000; i++) ASSERT_NE(rbtree_find(tree, &keys[i]), nullptr);
+
+    // Removed nodes are recycled by the pool
+    for (int i = 0; i < 5000; i++) ASSERT_TRUE(rbtree_insert(tree, &keys[i], &keys[i]));
+    ASSERT_GT(rbtree_blackHeight(tree->root), 0);
+
+    RedBlackNode *node = rbtree_first(tree);
+    while (node != nullptr) {
+        RedBlackNode *next = rbtree_next(node);
+        rbtree_removeNode(tree, node, nullptr, nullptr);
+        node = next;
+    }
+    ASSERT_EQ(rbtree_size(tree), 0);
+    ASSERT_EQ(tree->root, nullptr);
+}
+
+TEST(RedBlackTreeDestroyTest, OwnedKeysTest) {
+    RedBlackTree tree;
+
+    rbtree_create(&tree, rbtree_compareInt, free, free);
+    for (int i = 0; i < 1000; i++) {
+        int *key = (int *) malloc(sizeof(int));
+        int *value = (int *) malloc(sizeof(int));
+        *key = (i * 7919) % 1000;
+        *value = i;
+        ASSERT_TRUE(rbtree_insert(&tree, key, value));
+    }
+    rbtree_destroy(&tree);
+    ASSERT_EQ(rbtree_size(&tree), 0);
+}
+
+#endif //COLLECTIONS_COMMONS_REDBLACKTREE_TEST_H
@@ -0,0 +1,133 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#ifndef COLLECTIONS_COMMONS_ROARING_TEST_H
+#define COLLECTIONS_COMMONS_ROARING_TEST_H
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "roaring.h"
+
+static bool roaring_collect(uint32_t value, void *data) {
+    ((std::vector<uint32_t> *) data)->push_back(value);
+    return true;
+}
+
+class RoaringTest : public testing::Test {
+protected:
+    RoaringBitmap *bitmap;
+
+    void SetUp() override {
+        bitmap = (RoaringBitmap *) malloc(sizeof(RoaringBitmap));
+        roaring_create(bitmap);
+    }
+
+    void TearDown() override {
+        roaring_destroy(bitmap);
+        free(bitmap);
+    }
+};
+
+TEST_F(RoaringTest, BasicTest) {
+    std::vector<uint32_t> values;
+
+    ASSERT_TRUE(roaring_isEmpty(bitmap));
+    ASSERT_TRUE(roaring_add(bitmap, 7));
+    ASSERT_FALSE(roaring_add(bitmap, 7));
+    ASSERT_TRUE(roaring_add(bitmap, 0xFFFFFFFFu));
+    ASSERT_TRUE(roaring_add(bitmap, 1u << 20));
+    ASSERT_EQ(roaring_cardinality(bitmap), 3);
+
+    ASSERT_TRUE(roaring_contains(bitmap, 1u << 20));
+    ASSERT_FALSE(roaring_contains(bitmap, 8));
+
+    ASSERT_TRUE(roaring_forEach(bitmap, roaring_collect, &values));
+    ASSERT_EQ(values, std::vector<uint32_t>({7, 1u << 20, 0xFFFFFFFFu}));
+
+    ASSERT_TRUE(roaring_remove(bitmap, 7));
+    ASSERT_FALSE(roaring_remove(bitmap, 7));
+    ASSERT_TRUE(roaring_remove(bitmap, 0xFFFFFFFFu));
+    ASSERT_TRUE(roaring_remove(bitmap, 1u << 20));
+    ASSERT_TRUE(roaring_isEmpty(bitmap));
+}
+
+TEST_F(RoaringTest, ContainerTest) {
+    // Crossing 4096 values turns the array container into a bitmap container and back
+    for (uint32_t i = 0; i < 10000; i += 2) ASSERT_TRUE(roaring_add(bitmap, i));
+    ASSERT_EQ(bitmap->containers[0].type, ROARING_BITMAP);
+    ASSERT_EQ(roaring_cardinality(bitmap), 5000);
+    for (uint32_t i = 0; i < 2000; i += 2) ASSERT_TRUE(roaring_remove(bitmap, i));
+    ASSERT_EQ(bitmap->containers[0].type, ROARING_ARRAY);
+    ASSERT_EQ(roaring_cardinality(bitmap), 4000);
+
+    // Runs of consecutive values are compressed, then expanded back when modified
+    for (uint32_t i = 100000; i < 150000; i++) roaring_add(bitmap, i);
+    ASSERT_TRUE(roaring_runOptimize(bitmap));
+    ASSERT_EQ(bitmap->containers[1].type, ROARING_RUN);
+    ASSERT_EQ(bitmap->containers[1].runs, 1);
+    ASSERT_TRUE(roaring_contains(bitmap, 149999));
+    ASSERT_FALSE(roaring_contains(bitmap, 150000));
+    ASSERT_FALSE(roaring_add(bitmap, 120000));
+    ASSERT_TRUE(roaring_remove(bitmap, 120000));
+    ASSERT_NE(bitmap->containers[1].type, ROARING_RUN);
+    ASSERT_FALSE(roaring_contains(bitmap, 120000));
+    ASSERT_EQ(roaring_cardinality(bitmap), 4000 + 50000 - 1);
+}
+
+TEST_F(RoaringTest, AlgebraTest) {
+    RoaringBitmap right, union_result, intersection_result;
+    std::vector<uint32_t> values;
+
+    // left = multiples of 3 plus a dense run, right = multiples of 5 plus a sparse tail
+    roaring_create(&right);
+    for (uint32_t i = 0; i < 300000; i += 3) roaring_add(bitmap, i);
+    for (uint32_t i = 1000000; i < 1100000; i++) roaring_add(bitmap, i);
+    for (uint32_t i = 0; i < 300000; i += 5) roaring_add(&right, i);
+    for (uint32_t i = 1050000; i < 5000000; i += 1000) roaring_add(&right, i);
+    roaring_runOptimize(bitmap);
+
+    ASSERT_TRUE(roaring_union(&union_result, bitmap, &right));
+    ASSERT_TRUE(roaring_intersection(&intersection_result, bitmap, &right));
+
+    for (uint32_t i = 0; i < 300000; i++) {
+        ASSERT_EQ(roaring_contains(&union_result, i), i % 3 == 0 || i % 5 == 0);
+        ASSERT_EQ(roaring_contains(&intersection_result, i), i % 15 == 0);
+    }
+    ASSERT_EQ(roaring_cardinality(&union_result), 100000 + 60000 - 20000 + 100000 + 3900);
+    ASSERT_EQ(roaring_cardinality(&intersection_result), 20000 + 50);
+
+    roaring_forEach(&intersection_result, roaring_collect, &values);
+    ASSERT_EQ(values.size(), 20050);
+    ASSERT_EQ(values.back(), 1099000);
+
+    roaring_destroy(&intersection_result);
+    roaring_destroy(&union_result);
+    roaring_destroy(&right);
+}
+
+TEST_F(RoaringTest, SerializeTest) {
+    RoaringBitmap copy;
+    std::vector<uint8_t> buffer;
+    std::vector<uint32_t> expected, values;
+
+    for (uint32_t i = 0; i < 70000; i += 7) roaring_add(bitmap, i);
+    for (uint32_t i = 200000; i < 210000; i++) roaring_add(bitmap, i);
+    for (uint32_t i = 300000; i < 400000; i += 2) roaring_add(bitmap, i);
+    roaring_runOptimize(bitmap);
+
+    buffer.resize(roaring_serializedSize(bitmap));
+    ASSERT_EQ(roaring_serialize(bitmap, buffer.data()), buffer.size());
+    ASSERT_TRUE(roaring_deserialize(&copy, buffer.data(), buffer.size()));
+
+    roaring_forEach(bitmap, roaring_collect, &expected);
+    roaring_forEach(&copy, roaring_collect, &values);
+    ASSERT_EQ(values, expected);
+    roaring_destroy(&copy);
+
+    ASSERT_FALSE(roaring_deserialize(&copy, buffer.data(), buffer.size() - 1));
+    buffer[0] ^= 1;
+    ASSERT_FALSE(roaring_deserialize(&copy, buffer.data(), buffer.size()));
+}
+
+#endif //COLLECTIONS_COMMONS_ROARING_TEST_H
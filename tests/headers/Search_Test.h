@@ -0,0 +1,100 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#ifndef COLLECTIONS_COMMONS_SEARCH_TEST_H
+#define COLLECTIONS_COMMONS_SEARCH_TEST_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "gtest/gtest.h"
+#include "search.h"
+
+class SearchTest : public testing::Test {
+protected:
+    static int compare_int(const void *key1, const void *key2) {
+        int a = *(const int *) key1;
+        int b = *(const int *) key2;
+        return (a > b) - (a < b);
+    }
+
+    // Sorted integers with duplicates, uniform or skewed by squaring
+    static std::vector<int64_t> sorted_values(int size, bool skewed, unsigned int seed) {
+        std::vector<int64_t> values(size);
+        for (int64_t &value: values) {
+            seed = seed * 1103515245u + 12345u;
+            value = (int64_t) ((seed >> 8) % (size * 2 + 1));
+            if (skewed) value *= value * value;
+        }
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+};
+
+TEST_F(SearchTest, GenericTest) {
+    for (int size: {0, 1, 2, 3, 100, 1001}) {
+        std::vector<int> values(size);
+        for (int i = 0; i < size; i++) values[i] = i / 3 * 2;
+        for (int key = -1; key <= size; key++) {
+            int lower = (int) (std::lower_bound(values.begin(), values.end(), key) - values.begin());
+            int upper = (int) (std::upper_bound(values.begin(), values.end(), key) - values.begin());
+            int first = -1;
+            ASSERT_EQ(array_lowerBound(values.data(), size, sizeof(int), &key, compare_int), lower);
+            ASSERT_EQ(array_upperBound(values.data(), size, sizeof(int), &key, compare_int), upper);
+            ASSERT_EQ(array_equalRange(values.data(), size, sizeof(int), &key, compare_int, &first), upper - lower);
+            ASSERT_EQ(first, lower);
+            ASSERT_EQ(array_search(values.data(), size, sizeof(int), &key, compare_int), lower == upper ? -1 : lower);
+        }
+    }
+}
+
+TEST_F(SearchTest, Int64Test) {
+    for (int size: {0, 1, 5, 15, 16, 17, 63, 200, 100000}) {
+        for (bool skewed: {false, true}) {
+            std::vector<int64_t> values = sorted_values(size, skewed, size + 1);
+            std::vector<int64_t> keys = {INT64_MIN, INT64_MAX, -1};
+            for (int i = 0; i < size; i += 1 + size / 500) {
+                keys.push_back(values[i]);
+                keys.push_back(values[i] + 1);
+            }
+            for (int64_t key: keys) {
+                int lower = (int) (std::lower_bound(values.begin(), values.end(), key) - values.begin());
+                int upper = (int) (std::upper_bound(values.begin(), values.end(), key) - values.begin());
+                ASSERT_EQ(array_lowerBoundInt64(values.data(), size, key), lower);
+                ASSERT_EQ(array_upperBoundInt64(values.data(), size, key), upper);
+                ASSERT_EQ(array_interpolationSearch(values.data(), size, key), lower);
+            }
+        }
+    }
+
+    // Extreme integers don't overflow the interpolation
+    std::vector<int64_t> extremes(1000);
+    for (int i = 0; i < 1000; i++) extremes[i] = i < 500 ? INT64_MIN + i : INT64_MAX - 999 + i;
+    ASSERT_EQ(array_interpolationSearch(extremes.data(), 1000, 0), 500);
+    ASSERT_EQ(array_interpolationSearch(extremes.data(), 1000, INT64_MIN + 3), 3);
+    ASSERT_EQ(array_interpolationSearch(extremes.data(), 1000, INT64_MAX), 999);
+}
+
+TEST_F(SearchTest, LowerBoundTest) {
+    std::vector<int64_t> values = sorted_values(100000, false, 9);
+    std::vector<int64_t> keys(100000);
+    unsigned int seed = 13;
+    long long expected = 0;
+    long long binary = 0;
+    long long interpolation = 0;
+
+    for (int64_t &key: keys) {
+        seed = seed * 1103515245u + 12345u;
+        key = (int64_t) ((seed >> 8) % 200001);
+    }
+    for (int64_t key: keys) {
+        expected += std::lower_bound(values.begin(), values.end(), key) - values.begin();
+        binary += array_lowerBoundInt64(values.data(), (int) values.size(), key);
+        interpolation += array_interpolationSearch(values.data(), (int) values.size(), key);
+    }
+    ASSERT_EQ(binary, expected);
+    ASSERT_EQ(interpolation, expected);
+}
+
+#endif //COLLECTIONS_COMMONS_SEARCH_TEST_H
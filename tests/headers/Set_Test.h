@@ -239,4 +239,270 @@ TEST_F(SetTest, IntersectionTest) {
 
 
 
+class HashedSetTest : public testing::Test {
+protected:
+    Set *set;
+
+    void SetUp() override {
+        set = (Set *) malloc(sizeof(Set));
+        set_createHashed(set, 16, hash_block, cmp_block, free);
+    }
+
+    void TearDown() override {
+        set_destroy(set);
+        free(set);
+    }
+};
+
+TEST_F(HashedSetTest, BasicTest) {
+    Chunk *chunk1, *chunk2;
+    Block *b1, *b2, *b3, *b4;
+    chunk1 = (Chunk *) malloc(sizeof(Chunk));
+    chunk2 = (Chunk *) malloc(sizeof(Chunk));
+    chunk1->data = 1;
+    chunk2->data = 2;
+    b1 = (Block *) malloc(sizeof(Block));
+    b2 = (Block *) malloc(sizeof(Block));
+    b3 = (Block *) malloc(sizeof(Block));
+    b4 = (Block *) malloc(sizeof(Block));
+    b1->type = 1;
+    b1->chunk = chunk1;
+    b2->type = 1;
+    b2->chunk = chunk2;
+    b3->type = 2;
+    b3->chunk = chunk1;
+    b4->type = 2;
+    b4->chunk = chunk1;
+    ASSERT_TRUE(set_add(set, b1));
+    ASSERT_TRUE(set_add(set, b2));
+    ASSERT_TRUE(set_add(set, b3));
+    ASSERT_FALSE(set_add(set, b4));
+
+    // True because b3 represent that literal value evaluate by cmp_block function
+    ASSERT_TRUE(set_isMember(set, b4));
+    ASSERT_TRUE(set_isMember(set, b1));
+    ASSERT_EQ(set_size(set), 3);
+
+    // Removing the tail, then the head, keeps the index consistent
+    void *delete_value = b4;
+    ASSERT_TRUE(set_remove(set, &delete_value));
+    ASSERT_EQ(delete_value, b3);
+    ASSERT_FALSE(set_isMember(set, b3));
+    delete_value = b1;
+    ASSERT_TRUE(set_remove(set, &delete_value));
+    ASSERT_EQ(delete_value, b1);
+    ASSERT_TRUE(set_isMember(set, b2));
+    ASSERT_EQ(set_size(set), 1);
+    free(b1);
+    free(b3);
+    free(b4);
+    free(chunk1);
+    free(chunk2);
+}
+
+TEST_F(HashedSetTest, AlgebraTest) {
+    const int count = 100000;
+    Set left, right, union_result, intersection_result, difference_result;
+    int *values = (int *) malloc(2 * count * sizeof(int));
+
+    ASSERT_TRUE(set_createHashed(&left, count, hashint, cmp_int, NULL));
+    ASSERT_TRUE(set_createHashed(&right, 16, hashint, cmp_int, NULL));
+    for (int i = 0; i < 2 * count; i++) values[i] = i;
+    // left = [0, count), right = [count / 2, count + count / 2)
+    for (int i = 0; i < count; i++) {
+        ASSERT_TRUE(set_add(&left, &values[i]));
+        ASSERT_TRUE(set_add(&right, &values[i + count / 2]));
+    }
+
+    ASSERT_TRUE(set_union(&union_result, &left, &right));
+    ASSERT_EQ(set_size(&union_result), count + count / 2);
+    ASSERT_TRUE(set_intersection(&intersection_result, &left, &right));
+    ASSERT_EQ(set_size(&intersection_result), count / 2);
+    ASSERT_TRUE(set_difference(&difference_result, &left, &right));
+    ASSERT_EQ(set_size(&difference_result), count / 2);
+
+    ASSERT_TRUE(set_isSubset(&intersection_result, &left));
+    ASSERT_TRUE(set_isSubset(&intersection_result, &right));
+    ASSERT_FALSE(set_isSubset(&difference_result, &right));
+    ASSERT_FALSE(set_equals(&left, &right));
+
+    // Emptying the difference from left leaves the intersection
+    for (int i = 0; i < count / 2; i++) {
+        void *value = &values[i];
+        ASSERT_TRUE(set_remove(&left, &value));
+    }
+    ASSERT_TRUE(set_equals(&left, &intersection_result));
+
+    set_destroy(&union_result);
+    set_destroy(&intersection_result);
+    set_destroy(&difference_result);
+    set_destroy(&left);
+    set_destroy(&right);
+    free(values);
+}
+
+
+static int compare_int_value(const void *key1, const void *key2) {
+    int left = *((int *) key1), right = *((int *) key2);
+    return (left > right) - (left < right);
+}
+
+TEST(SortedSetTest, BasicTest) {
+    int values[] = {5, 3, 9, 3, 1, 7, 5};
+    void *refs[7];
+    SortedSet set;
+    for (int i = 0; i < 7; i++) refs[i] = &values[i];
+
+    ASSERT_TRUE(sortedset_fromArray(&set, refs, 7, compare_int_value, nullptr));
+    ASSERT_EQ(sortedset_size(&set), 5);
+    for (int i = 1; i < sortedset_size(&set); i++)
+        ASSERT_LT(*(int *) sortedset_value(&set, i - 1), *(int *) sortedset_value(&set, i));
+
+    int four = 4, nine = 9;
+    ASSERT_TRUE(sortedset_add(&set, &four));
+    ASSERT_FALSE(sortedset_add(&set, &nine));
+    ASSERT_TRUE(sortedset_isMember(&set, &four));
+    void *removed = &nine;
+    ASSERT_TRUE(sortedset_remove(&set, &removed));
+    ASSERT_EQ(removed, &values[2]);
+    ASSERT_FALSE(sortedset_isMember(&set, &nine));
+    ASSERT_EQ(*(int *) sortedset_value(&set, 2), 4);
+    sortedset_destroy(&set);
+}
+
+TEST(SortedSetTest, AlgebraTest) {
+    const int count = 10000;
+    int *values = (int *) malloc(count * sizeof(int));
+    SortedSet even, small, thirds, result;
+    for (int i = 0; i < count; i++) values[i] = i;
+
+    // Balanced operands use merges, small operands are galloped
+    sortedset_create(&even, 0, compare_int_value, nullptr);
+    sortedset_create(&thirds, 0, compare_int_value, nullptr);
+    sortedset_create(&small, 0, compare_int_value, nullptr);
+    sortedset_create(&result, 0, compare_int_value, nullptr);
+    for (int i = 0; i < count; i++) {
+        if (i % 2 == 0) ASSERT_TRUE(sortedset_add(&even, &values[i]));
+        if (i % 3 == 0) ASSERT_TRUE(sortedset_add(&thirds, &values[i]));
+        if (i % 1000 == 0 || i == 1001) ASSERT_TRUE(sortedset_add(&small, &values[i]));
+    }
+
+    ASSERT_TRUE(sortedset_union(&result, &even, &thirds));
+    ASSERT_EQ(sortedset_size(&result), count / 2 + count / 3 + 1 - count / 6 - 1);
+    ASSERT_TRUE(sortedset_intersection(&result, &even, &thirds));
+    ASSERT_EQ(sortedset_size(&result), count / 6 + 1);
+    ASSERT_TRUE(sortedset_difference(&result, &even, &thirds));
+    ASSERT_EQ(sortedset_size(&result), count / 2 - count / 6 - 1);
+
+    ASSERT_TRUE(sortedset_intersection(&result, &small, &even));
+    ASSERT_EQ(sortedset_size(&result), 10);
+    ASSERT_TRUE(sortedset_intersection(&result, &even, &small));
+    ASSERT_EQ(sortedset_size(&result), 10);
+    ASSERT_TRUE(sortedset_isSubset(&result, &even));
+    ASSERT_FALSE(sortedset_isSubset(&small, &even));
+    ASSERT_TRUE(sortedset_union(&result, &even, &small));
+    ASSERT_EQ(sortedset_size(&result), count / 2 + 1);
+    ASSERT_TRUE(sortedset_difference(&result, &even, &small));
+    ASSERT_EQ(sortedset_size(&result), count / 2 - 10);
+    ASSERT_TRUE(sortedset_difference(&result, &small, &even));
+    ASSERT_EQ(sortedset_size(&result), 1);
+    ASSERT_EQ(*(int *) sortedset_value(&result, 0), 1001);
+    ASSERT_FALSE(sortedset_equals(&result, &small));
+
+    sortedset_destroy(&even);
+    sortedset_destroy(&thirds);
+    sortedset_destroy(&small);
+    sortedset_destroy(&result);
+    free(values);
+}
+
+TEST(SortedSetTest, IntersectIntTest) {
+    const int count = 4096;
+    int *large = (int *) malloc(count * sizeof(int));
+    int small[] = {-3, 0, 7, 8, 9, 4000, 8190, 9000};
+    int out[8];
+    for (int i = 0; i < count; i++) large[i] = 2 * i;
+
+    ASSERT_EQ(sortedset_intersectInt(small, 8, large, count, out), 4);
+    ASSERT_EQ(out[0], 0);
+    ASSERT_EQ(out[1], 8);
+    ASSERT_EQ(out[2], 4000);
+    ASSERT_EQ(out[3], 8190);
+    ASSERT_EQ(sortedset_intersectInt(large, count, small, 8, out), 4);
+    ASSERT_EQ(sortedset_intersectInt(large, 8, small, 8, out), 2);
+    free(large);
+}
+
+TEST(SetCoverTest, GreedyTest) {
+    int values[7] = {1, 2, 3, 4, 5, 6, 7};
+    int members[4][3] = {{0, 1, 2}, {1, 3, -1}, {2, 3, -1}, {3, 4, 5}};
+    KeySetEntry entries[4];
+    Set elements, candidates, cover;
+
+    set_create(&elements, cmp_int, nullptr);
+    set_create(&candidates, nullptr, nullptr);
+    for (int i = 0; i < 6; i++) set_add(&elements, &values[i]);
+    for (int i = 0; i < 4; i++) {
+        entries[i].key = &values[i];
+        set_create(&entries[i].set, cmp_int, nullptr);
+        for (int j = 0; j < 3 && members[i][j] >= 0; j++) set_add(&entries[i].set, &values[members[i][j]]);
+        list_add(&candidates, list_last(&candidates), &entries[i]);
+    }
+
+    // {1, 2, 3} and {4, 5, 6} are covering everything, ties are won by the first candidate
+    ASSERT_TRUE(set_match_entries(&elements, &candidates, &cover));
+    ASSERT_EQ(set_size(&cover), 2);
+    ASSERT_EQ(list_value(list_first(&cover)), &entries[0]);
+    ASSERT_EQ(list_value(list_last(&cover)), &entries[3]);
+    ASSERT_EQ(set_size(&elements), 0);
+    ASSERT_EQ(set_size(&candidates), 2);
+    set_destroy(&cover);
+
+    // 7 can't be covered
+    set_add(&elements, &values[6]);
+    set_add(&elements, &values[1]);
+    ASSERT_FALSE(set_match_entries(&elements, &candidates, &cover));
+    ASSERT_EQ(set_size(&cover), 1);
+    ASSERT_EQ(set_size(&elements), 1);
+    ASSERT_TRUE(set_isMember(&elements, &values[6]));
+
+    set_destroy(&cover);
+    set_destroy(&elements);
+    set_destroy(&candidates);
+    for (int i = 0; i < 4; i++) set_destroy(&entries[i].set);
+}
+
+TEST(SetCoverTest, HashedTest) {
+    const int count = 20000, candidate_count = 200;
+    int *values = (int *) malloc(count * sizeof(int));
+    KeySetEntry *entries = (KeySetEntry *) malloc(candidate_count * sizeof(KeySetEntry));
+    Set elements, candidates, cover;
+
+    set_createHashed(&elements, count, hashint, cmp_int, nullptr);
+    set_create(&candidates, nullptr, nullptr);
+    for (int i = 0; i < count; i++) {
+        values[i] = i;
+        set_add(&elements, &values[i]);
+    }
+    // Candidate c covers the values congruent to c modulo 100 plus a stride of consecutive values
+    for (int c = 0; c < candidate_count; c++) {
+        set_createHashed(&entries[c].set, 256, hashint, cmp_int, nullptr);
+        for (int i = c % 100; i < count; i += 100) set_add(&entries[c].set, &values[i]);
+        for (int i = c * 100; i < c * 100 + 100; i++) set_add(&entries[c].set, &values[i]);
+        list_add(&candidates, list_last(&candidates), &entries[c]);
+    }
+
+    ASSERT_TRUE(set_match_entries(&elements, &candidates, &cover));
+    ASSERT_EQ(set_size(&elements), 0);
+    ASSERT_EQ(set_size(&candidates) + set_size(&cover), candidate_count);
+    ASSERT_LE(set_size(&cover), 100);
+
+    set_destroy(&cover);
+    set_destroy(&elements);
+    set_destroy(&candidates);
+    for (int c = 0; c < candidate_count; c++) set_destroy(&entries[c].set);
+    free(entries);
+    free(values);
+}
+
 #endif //COLLECTIONS_COMMONS_SET_TEST_H
@@ -0,0 +1,519 @@
+//
+// Created by maxim on 18/10/2026.
+//
+
+#ifndef COLLECTIONS_COMMONS_SORT_TEST_H
+#define COLLECTIONS_COMMONS_SORT_TEST_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "sort.h"
+
+class SortTest : public testing::Test {
+protected:
+    struct Record {
+        int64_t key;
+        int64_t id;
+    };
+
+    struct Triple {
+        int key;
+        int id;
+        int padding;
+    };
+
+    static int compare_int(const void *key1, const void *key2) {
+        int a = *(const int *) key1;
+        int b = *(const int *) key2;
+        return (a > b) - (a < b);
+    }
+
+    static int compare_int64(const void *key1, const void *key2) {
+        int64_t a = *(const int64_t *) key1;
+        int64_t b = *(const int64_t *) key2;
+        return (a > b) - (a < b);
+    }
+
+    static int compare_record(const void *key1, const void *key2) {
+        return compare_int64(&((const Record *) key1)->key, &((const Record *) key2)->key);
+    }
+
+    static int compare_triple(const void *key1, const void *key2) {
+        return compare_int(&((const Triple *) key1)->key, &((const Triple *) key2)->key);
+    }
+
+    static uint64_t record_key(const void *element) {
+        return (uint64_t) ((const Record *) element)->key ^ ((uint64_t) 1 << 63);
+    }
+
+    // Arithmetic progression pulled one integer at a time, the element is overwritten by each pull
+    struct Progression {
+        int64_t current;
+        int64_t step;
+        int remaining;
+    };
+
+    static const void *next_progression(void *run) {
+        Progression *progression = (Progression *) run;
+        if (progression->remaining-- <= 0) return nullptr;
+        progression->current += progression->step;
+        return &progression->current;
+    }
+
+    static bool collect_record(const void *element, void *data) {
+        ((std::vector<Record> *) data)->push_back(*(const Record *) element);
+        return true;
+    }
+
+    static int compares;
+
+    static int count_int64(const void *key1, const void *key2) {
+        compares++;
+        return compare_int64(key1, key2);
+    }
+
+    // Random, sorted, reversed, equal, few distinct, organ pipe and sawtooth inputs
+    static std::vector<std::vector<int>> patterns(int size) {
+        std::vector<std::vector<int>> result(7, std::vector<int>(size));
+        unsigned int seed = 42;
+
+        for (int i = 0; i < size; i++) {
+            seed = seed * 1103515245u + 12345u;
+            result[0][i] = (int) (seed >> 1);
+            result[1][i] = i;
+            result[2][i] = size - i;
+            result[3][i] = 7;
+            result[4][i] = (int) ((seed >> 16) % 4);
+            result[5][i] = i < size / 2 ? i : size - i;
+            result[6][i] = i % 100;
+        }
+        return result;
+    }
+};
+
+TEST_F(SortTest, IntTest) {
+    for (int size: {0, 1, 2, 3, 23, 24, 25, 129, 1000, 100000}) {
+        for (std::vector<int> &values: patterns(size)) {
+            std::vector<int> expected = values;
+            std::sort(expected.begin(), expected.end());
+            array_sort(values.data(), size, sizeof(int), compare_int);
+            ASSERT_EQ(values, expected) << "size " << size;
+        }
+    }
+}
+
+TEST_F(SortTest, RecordTest) {
+    std::vector<int> keys = patterns(50000)[4];
+    std::vector<int64_t> wide(keys.begin(), keys.end());
+    std::vector<Record> records;
+    std::vector<Triple> triples;
+    std::vector<void *> pointers;
+
+    for (int i = 0; i < (int) keys.size(); i++) {
+        records.push_back({keys[i], i});
+        triples.push_back({keys[i], i, -i});
+    }
+    for (int64_t &key: wide) pointers.push_back(&key);
+
+    array_sort(wide.data(), (int) wide.size(), sizeof(int64_t), compare_int64);
+    ASSERT_TRUE(std::is_sorted(wide.begin(), wide.end()));
+    array_sort(records.data(), (int) records.size(), sizeof(Record), compare_record);
+    array_sort(triples.data(), (int) triples.size(), sizeof(Triple), compare_triple);
+
+    // Elements are moved whole, the other fields follow their key
+    std::vector<bool> seen(keys.size(), false);
+    for (int i = 0; i < (int) keys.size(); i++) {
+        if (i > 0) ASSERT_LE(records[i - 1].key, records[i].key);
+        if (i > 0) ASSERT_LE(triples[i - 1].key, triples[i].key);
+        ASSERT_EQ(records[i].key, keys[records[i].id]);
+        ASSERT_EQ(triples[i].padding, -triples[i].id);
+        ASSERT_FALSE(seen[records[i].id]);
+        seen[records[i].id] = true;
+    }
+}
+
+TEST_F(SortTest, StableTest) {
+    std::vector<Record> scratch(SORT_STABLE_SCRATCH(100000) + 1);
+
+    for (int size: {0, 1, 2, 63, 64, 65, 1000, 100000}) {
+        for (std::vector<int> &keys: patterns(size)) {
+            // Keys are narrowed so equal keys are frequent, blocks of ascending keys make the merges gallop
+            std::vector<Record> records;
+            for (int i = 0; i < size; i++) records.push_back({keys[i] % 1000 + (i / 5000) % 2 * 500, i});
+            std::vector<Record> expected = records;
+            std::stable_sort(expected.begin(), expected.end(),
+                             [](const Record &a, const Record &b) { return a.key < b.key; });
+
+            ASSERT_TRUE(array_stableSort(records.data(), size, sizeof(Record), compare_record, scratch.data()));
+            for (int i = 0; i < size; i++) {
+                ASSERT_EQ(records[i].key, expected[i].key) << "size " << size << " index " << i;
+                ASSERT_EQ(records[i].id, expected[i].id) << "size " << size << " index " << i;
+            }
+        }
+    }
+}
+
+TEST_F(SortTest, StableValuesTest) {
+    std::vector<int> keys = patterns(50000)[0];
+    std::vector<Triple> triples;
+    std::vector<void *> values;
+    void **sorted;
+
+    for (int i = 0; i < (int) keys.size(); i++) triples.push_back({keys[i] % 100, i, 0});
+    for (Triple &triple: triples) values.push_back(&triple);
+
+    // Without scratch buffer the sort allocates its own
+    ASSERT_TRUE(array_stableSortValues(values.data(), (int) values.size(), compare_triple, nullptr));
+    sorted = values.data();
+    for (int i = 1; i < (int) values.size(); i++) {
+        const Triple *previous = (const Triple *) sorted[i - 1];
+        const Triple *current = (const Triple *) sorted[i];
+        ASSERT_TRUE(previous->key < current->key || (previous->key == current->key && previous->id < current->id));
+    }
+}
+
+TEST_F(SortTest, ParallelTest) {
+    ParallelPool pool{};
+
+    ASSERT_TRUE(parallel_create(&pool, 4));
+    for (int size: {1000, 65536, 300001}) {
+        for (std::vector<int> &values: patterns(size)) {
+            std::vector<int> expected = values;
+            std::sort(expected.begin(), expected.end());
+            array_parallelSort(&pool, values.data(), size, sizeof(int), compare_int);
+            ASSERT_EQ(values, expected) << "size " << size;
+        }
+    }
+
+    // Generic elements are merged whole
+    std::vector<int> keys = patterns(200000)[0];
+    std::vector<Triple> triples;
+    for (int i = 0; i < (int) keys.size(); i++) triples.push_back({keys[i], i, -i});
+    array_parallelSort(&pool, triples.data(), (int) triples.size(), sizeof(Triple), compare_triple);
+    for (int i = 0; i < (int) triples.size(); i++) {
+        if (i > 0) ASSERT_LE(triples[i - 1].key, triples[i].key);
+        ASSERT_EQ(triples[i].key, keys[triples[i].id]);
+        ASSERT_EQ(triples[i].padding, -triples[i].id);
+    }
+
+    keys = patterns(100000)[0];
+    array_parallelSort(nullptr, keys.data(), (int) keys.size(), sizeof(int), compare_int);
+    ASSERT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+    parallel_destroy(&pool);
+}
+
+TEST_F(SortTest, RadixTest) {
+    std::vector<int> keys = patterns(200000)[0];
+    std::vector<uint32_t> narrow(keys.begin(), keys.end());
+    std::vector<uint64_t> wide;
+    std::vector<Record> records;
+    ParallelPool pool{};
+
+    for (int i = 0; i < (int) keys.size(); i++) {
+        wide.push_back((uint64_t) keys[i] << 31 | (uint64_t) (i % 7));
+        records.push_back({keys[i] % 1000 - 500, i});
+    }
+    std::vector<uint32_t> expected_narrow = narrow;
+    std::vector<uint64_t> expected_wide = wide;
+    std::sort(expected_narrow.begin(), expected_narrow.end());
+    std::sort(expected_wide.begin(), expected_wide.end());
+
+    ASSERT_TRUE(array_radixSort(narrow.data(), (int) narrow.size(), sizeof(uint32_t), nullptr, 32, nullptr, nullptr));
+    ASSERT_EQ(narrow, expected_narrow);
+    ASSERT_TRUE(parallel_create(&pool, 4));
+    ASSERT_TRUE(array_radixSort(wide.data(), (int) wide.size(), sizeof(uint64_t), nullptr, 64, nullptr, &pool));
+    ASSERT_EQ(wide, expected_wide);
+    ASSERT_FALSE(array_radixSort(records.data(), (int) records.size(), sizeof(Record), nullptr, 64, nullptr, nullptr));
+
+    // Signed keys are mapped to unsigned ones, equal keys keep their order
+    std::vector<Record> scratch(records.size());
+    ASSERT_TRUE(array_radixSort(records.data(), (int) records.size(), sizeof(Record), record_key, 64, scratch.data(),
+                                &pool));
+    for (int i = 1; i < (int) records.size(); i++) {
+        ASSERT_TRUE(records[i - 1].key < records[i].key ||
+                    (records[i - 1].key == records[i].key && records[i - 1].id < records[i].id));
+    }
+    parallel_destroy(&pool);
+}
+
+TEST_F(SortTest, StringTest) {
+    std::vector<int> keys = patterns(100000)[0];
+    std::vector<std::string> texts;
+    std::vector<char *> strings;
+    ParallelPool pool{};
+
+    // Shared prefixes, empty strings and bytes above 127
+    for (int i = 0; i < (int) keys.size(); i++) {
+        std::string text = i % 3 == 0 ? "prefix/" : "";
+        for (int value = keys[i] % (i % 11 == 0 ? 1 : 100000); value > 0; value /= 37)
+            text += (char) (value % 37 == 36 ? 0xE9 : 'a' + value % 37);
+        texts.push_back(text);
+    }
+    for (std::string &text: texts) strings.push_back(&text[0]);
+    std::vector<std::string> expected = texts;
+    std::sort(expected.begin(), expected.end(), [](const std::string &a, const std::string &b) {
+        return strcmp(a.c_str(), b.c_str()) < 0;
+    });
+
+    ASSERT_TRUE(parallel_create(&pool, 4));
+    ASSERT_TRUE(array_stringSort(strings.data(), (int) strings.size(), &pool));
+    for (int i = 0; i < (int) strings.size(); i++) ASSERT_STREQ(strings[i], expected[i].c_str());
+    ASSERT_TRUE(array_stringSort(strings.data(), 0, nullptr));
+    parallel_destroy(&pool);
+}
+
+TEST_F(SortTest, NthElementTest) {
+    for (int size: {1, 2, 23, 24, 25, 129, 1000, 100000}) {
+        for (std::vector<int> &values: patterns(size)) {
+            std::vector<int> sorted = values;
+            std::sort(sorted.begin(), sorted.end());
+            for (int nth: {0, size / 3, size / 2, size - 1}) {
+                std::vector<int> copy = values;
+                array_nthElement(copy.data(), size, sizeof(int), nth, compare_int);
+                ASSERT_EQ(copy[nth], sorted[nth]);
+                for (int i = 0; i < nth; i++) ASSERT_LE(copy[i], copy[nth]);
+                for (int i = nth + 1; i < size; i++) ASSERT_GE(copy[i], copy[nth]);
+            }
+        }
+    }
+
+    // Out of range positions leave the array unchanged
+    std::vector<int> values = patterns(100)[0];
+    std::vector<int> copy = values;
+    array_nthElement(copy.data(), 100, sizeof(int), 100, compare_int);
+    ASSERT_EQ(values, copy);
+}
+
+TEST_F(SortTest, PartialSortTest) {
+    for (int size: {0, 1, 2, 25, 1000, 100000}) {
+        for (std::vector<int> &values: patterns(size)) {
+            std::vector<int> sorted = values;
+            std::sort(sorted.begin(), sorted.end());
+            for (int k: {1, 10, 100, size + 1}) {
+                std::vector<int> copy = values;
+                int kept = std::min(k, size);
+                array_partialSort(copy.data(), size, sizeof(int), k, compare_int);
+                ASSERT_TRUE(std::equal(copy.begin(), copy.begin() + kept, sorted.begin()));
+                std::sort(copy.begin() + kept, copy.end());
+                ASSERT_EQ(copy, sorted);
+            }
+        }
+    }
+
+    // A top-k accumulator over the same stream keeps the same prefix
+    std::vector<int> values = patterns(10000)[0];
+    std::vector<int> sorted = values;
+    std::vector<int> top(100);
+    TopK topk;
+    std::sort(sorted.begin(), sorted.end());
+    ASSERT_TRUE(topk_create(&topk, 100, sizeof(int), compare_int));
+    topk_pushArray(&topk, values.data(), (int) values.size());
+    ASSERT_EQ(topk_result(&topk, top.data()), 100);
+    array_partialSort(values.data(), (int) values.size(), sizeof(int), 100, compare_int);
+    ASSERT_TRUE(std::equal(top.begin(), top.end(), sorted.begin()));
+    ASSERT_TRUE(std::equal(top.begin(), top.end(), values.begin()));
+    topk_destroy(&topk);
+}
+
+TEST_F(SortTest, TopKTest) {
+    std::vector<Record> records(100000);
+    std::vector<Record> sorted;
+    std::vector<Record> result(100);
+    TopK topk;
+    int pushed = 0;
+
+    for (size_t i = 0; i < records.size(); i++) records[i] = {(int64_t) ((i * 7919) % 10007), (int64_t) i};
+    sorted = records;
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Record &a, const Record &b) { return a.key < b.key; });
+
+    ASSERT_FALSE(topk_create(&topk, 0, sizeof(Record), compare_record));
+    ASSERT_TRUE(topk_create(&topk, 100, sizeof(Record), compare_record));
+    ASSERT_EQ(topk_bound(&topk), nullptr);
+    ASSERT_EQ(topk_result(&topk, result.data()), 0);
+
+    // The stream is pushed in two steps, the result can be read in between
+    for (int i = 0; i < 50; i++) pushed += topk_push(&topk, &records[i]);
+    ASSERT_EQ(pushed, 50);
+    ASSERT_EQ(topk_result(&topk, result.data()), 50);
+    ASSERT_TRUE(std::is_sorted(result.begin(), result.begin() + 50,
+                               [](const Record &a, const Record &b) { return a.key < b.key; }));
+    topk_pushArray(&topk, records.data() + 50, (int) records.size() - 50);
+
+    ASSERT_EQ(topk_size(&topk), 100);
+    ASSERT_EQ(((Record *) topk_bound(&topk))->key, sorted[99].key);
+    ASSERT_EQ(topk_result(&topk, result.data()), 100);
+    for (int i = 0; i < 100; i++) ASSERT_EQ(result[i].key, sorted[i].key);
+    ASSERT_FALSE(topk_push(&topk, &sorted[99]));
+    topk_destroy(&topk);
+}
+
+TEST_F(SortTest, NetworkTest) {
+    std::vector<int> sizes;
+    unsigned int seed = 3;
+
+    for (int size = 0; size <= SORT_NETWORK_MAX + 1; size++) sizes.push_back(size);
+    for (int size: {100, 1000, 100000}) sizes.push_back(size);
+    for (int size: sizes) {
+        for (std::vector<int> &pattern: patterns(size)) {
+            std::vector<int32_t> values32(pattern.begin(), pattern.end());
+            std::vector<int64_t> values64(size);
+            std::vector<float> floats(size);
+            for (int i = 0; i < size; i++) {
+                seed = seed * 1103515245u + 12345u;
+                values64[i] = ((int64_t) pattern[i] << 31) - (int64_t) (seed >> 4);
+                floats[i] = (float) pattern[i] / 7.0f - (float) (seed % 1000);
+            }
+            std::vector<int32_t> sorted32 = values32;
+            std::vector<int64_t> sorted64 = values64;
+            std::vector<float> sortedFloats = floats;
+            std::sort(sorted32.begin(), sorted32.end());
+            std::sort(sorted64.begin(), sorted64.end());
+            std::sort(sortedFloats.begin(), sortedFloats.end());
+
+            array_sortInt32(values32.data(), size);
+            array_sortInt64(values64.data(), size);
+            array_sortFloat(floats.data(), size);
+            ASSERT_EQ(values32, sorted32);
+            ASSERT_EQ(values64, sorted64);
+            ASSERT_EQ(floats, sortedFloats);
+        }
+    }
+
+    // Extreme integers and special floats
+    std::vector<int64_t> extremes = {INT64_MAX, 0, INT64_MIN, -1, INT64_MAX, 1};
+    array_sortInt64(extremes.data(), (int) extremes.size());
+    ASSERT_EQ(extremes, std::vector<int64_t>({INT64_MIN, -1, 0, 1, INT64_MAX, INT64_MAX}));
+    std::vector<float> specials = {INFINITY, 0.0f, -INFINITY, -0.0f, NAN, -1.5f, 1.5f};
+    array_sortFloat(specials.data(), (int) specials.size());
+    ASSERT_EQ(specials[0], -INFINITY);
+    ASSERT_EQ(specials[1], -1.5f);
+    ASSERT_TRUE(std::signbit(specials[2]) && specials[2] == 0.0f);
+    ASSERT_TRUE(!std::signbit(specials[3]) && specials[3] == 0.0f);
+    ASSERT_EQ(specials[4], 1.5f);
+    ASSERT_EQ(specials[5], INFINITY);
+    ASSERT_TRUE(std::isnan(specials[6]));
+
+    // Consecutive batches of 32 are sorted in place without touching their neighbours
+    std::vector<int> random = patterns(32 * 1000)[0];
+    std::vector<int32_t> batches(random.begin(), random.end());
+    std::vector<int32_t> expected = batches;
+    for (size_t i = 0; i < expected.size(); i += 32) std::sort(expected.begin() + i, expected.begin() + i + 32);
+    for (size_t i = 0; i < batches.size(); i += 32) array_sortInt32(batches.data() + i, 32);
+    ASSERT_EQ(batches, expected);
+}
+
+int SortTest::compares = 0;
+
+TEST_F(SortTest, MergeRunsTest) {
+    unsigned int seed = 23;
+
+    for (int k: {1, 2, 3, 7, 64, 1000}) {
+        std::vector<std::vector<Record>> runs(k);
+        std::vector<ArrayView> views(k);
+        std::vector<Record> expected;
+        std::vector<Record> merged;
+
+        // Run i has records with ids i * 100000 + j, some runs are empty and keys repeat across runs
+        for (int i = 0; i < k; i++) {
+            seed = seed * 1103515245u + 12345u;
+            runs[i].resize(i % 5 == 4 ? 0 : (seed >> 8) % 300);
+            for (size_t j = 0; j < runs[i].size(); j++) {
+                seed = seed * 1103515245u + 12345u;
+                runs[i][j] = {(int64_t) ((seed >> 8) % 500), (int64_t) i * 100000 + (int64_t) j};
+            }
+            std::stable_sort(runs[i].begin(), runs[i].end(),
+                             [](const Record &a, const Record &b) { return a.key < b.key; });
+            for (size_t j = 0; j < runs[i].size(); j++) runs[i][j].id = (int64_t) i * 100000 + (int64_t) j;
+            expected.insert(expected.end(), runs[i].begin(), runs[i].end());
+            arrayview_create(&views[i], runs[i].data(), (int) runs[i].size(), sizeof(Record));
+        }
+
+        // Equal keys come out in the run order, then in the order inside their run
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](const Record &a, const Record &b) { return a.key < b.key; });
+        ASSERT_TRUE(array_mergeRuns(views.data(), k, compare_record, collect_record, &merged));
+        ASSERT_EQ(merged.size(), expected.size());
+        for (size_t i = 0; i < merged.size(); i++) {
+            ASSERT_EQ(merged[i].key, expected[i].key);
+            ASSERT_EQ(merged[i].id, expected[i].id);
+        }
+    }
+
+    // The output handle stops the merge
+    std::vector<int> first = {1, 4, 7};
+    std::vector<int> second = {2, 3, 9};
+    ArrayView views[2];
+    std::vector<int> merged;
+    arrayview_create(&views[0], first.data(), 3, sizeof(int));
+    arrayview_create(&views[1], second.data(), 3, sizeof(int));
+    ASSERT_FALSE(array_mergeRuns(views, 2, compare_int, [](const void *element, void *data) {
+        ((std::vector<int> *) data)->push_back(*(const int *) element);
+        return ((std::vector<int> *) data)->size() < 4;
+    }, &merged));
+    ASSERT_EQ(merged, std::vector<int>({1, 2, 3, 4}));
+    ASSERT_TRUE(array_mergeRuns(views, 0, compare_int, nullptr, nullptr));
+}
+
+TEST_F(SortTest, LoserTreeTest) {
+    const int k = 100;
+    std::vector<Progression> progressions(k);
+    std::vector<void *> runs(k);
+    LoserTree tree;
+    int64_t previous = INT64_MIN;
+    int64_t total = 0;
+    int count = 0;
+
+    // Runs are streamed without being materialized, each one has its own step
+    for (int i = 0; i < k; i++) {
+        progressions[i] = {(int64_t) i - 1000, (int64_t) i % 13 + 1, 1000 + i};
+        runs[i] = &progressions[i];
+        total += 1000 + i;
+    }
+    ASSERT_FALSE(losertree_create(&tree, runs.data(), 0, next_progression, count_int64));
+    ASSERT_TRUE(losertree_create(&tree, runs.data(), k, next_progression, count_int64));
+    compares = 0;
+    while (losertree_peek(&tree) != nullptr) {
+        int64_t value = *(const int64_t *) losertree_peek(&tree);
+        int run = losertree_run(&tree);
+        ASSERT_GE(value, previous);
+        ASSERT_EQ(value, progressions[run].current);
+        previous = value;
+        count++;
+        losertree_advance(&tree);
+    }
+    ASSERT_EQ(count, total);
+
+    // A single path of ceil(log2(k)) matches is replayed per element
+    ASSERT_LE(compares, count * 7);
+    losertree_advance(&tree);
+    ASSERT_EQ(losertree_peek(&tree), nullptr);
+    losertree_destroy(&tree);
+
+    // A single run is streamed as is
+    Progression single = {0, 2, 5};
+    void *handle = &single;
+    std::vector<int64_t> values;
+    ASSERT_TRUE(losertree_create(&tree, &handle, 1, next_progression, compare_int64));
+    ASSERT_TRUE(losertree_merge(&tree, [](const void *element, void *data) {
+        ((std::vector<int64_t> *) data)->push_back(*(const int64_t *) element);
+        return true;
+    }, &values));
+    ASSERT_EQ(values, std::vector<int64_t>({2, 4, 6, 8, 10}));
+    losertree_destroy(&tree);
+}
+
+TEST_F(SortTest, QsortTest) {
+    std::vector<int> values = patterns(100000)[0];
+    std::vector<int> copy = values;
+
+    array_sort(values.data(), (int) values.size(), sizeof(int), compare_int);
+    qsort(copy.data(), copy.size(), sizeof(int), compare_int);
+    ASSERT_EQ(values, copy);
+}
+
+#endif //COLLECTIONS_COMMONS_SORT_TEST_H
@@ -15,6 +15,19 @@
 #include "HashSet_Test.h"
 #include "OAHashTable_Test.h"
 #include "Deque_Test.h"
+#include "BitSet_Test.h"
+#include "Roaring_Test.h"
+#include "RedBlackTree_Test.h"
+#include "BTree_Test.h"
+#include "BinaryTree_Test.h"
+#include "BinarySearchTree_Test.h"
+#include "EytzingerTree_Test.h"
+#include "IndexedBinaryTree_Test.h"
+#include "Parallel_Test.h"
+#include "Heap_Test.h"
+#include "Sort_Test.h"
+#include "Search_Test.h"
+#include "Array_Test.h"
 
 
 int main(int argc, char **argv) {
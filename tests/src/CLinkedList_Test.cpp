@@ -18,3 +18,7 @@ void CLinkedList_Test::destroy(void *value) {
         delete page;
     }
 }
+
+int CLinkedList_Test::compare_page(const void *key1, const void *key2) {
+    return ((const Page *) key1)->numero - ((const Page *) key2)->numero;
+}